@@ -0,0 +1,256 @@
+//================================================================================================
+//
+//   bench_harness.c - Microbenchmark timing harness implementation
+//
+//   See bench_harness.h for module interface documentation.
+//
+//   Implementation notes:
+//   - Times use CLOCK_MONOTONIC; one repetition is long enough (BENCH_REP_SECONDS) that
+//     clock resolution and call overhead do not matter
+//   - Median and MAD instead of mean and standard deviation, so an interrupt or page fault
+//     in one repetition does not move the result
+//   - Pinning uses sched_setaffinity (Linux); elsewhere the run is unpinned
+//
+//================================================================================================
+
+#define _GNU_SOURCE // sched_setaffinity, sched_getcpu
+#include "bench_harness.h"
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_NAME_LENGTH 48
+#define BENCH_CPU_CURRENT -2 // BenchOptions.cpu default: pin to the CPU the process starts on
+
+// Timing of one benchmark
+typedef struct BenchResult {
+    char name[BENCH_NAME_LENGTH];
+    const char *itemUnit;
+    long itemsPerOp;
+    long iterations;   // Operations per repetition
+    int reps;
+    double *samplesNs; // Per-operation time of each repetition
+    double medianNs;
+    double madNs;
+} BenchResult;
+
+//----------------------------------------------------------------------------------
+// Module Variables
+//----------------------------------------------------------------------------------
+static BenchResult results[BENCH_MAX_RESULTS];
+static int resultCount = 0;
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+static double NowSeconds(void);
+
+// qsort comparison for ascending doubles
+static int CompareDoubles(const void *a, const void *b);
+
+// Median of count values (sorts a copy)
+static double Median(const double *values, int count);
+
+// Pin the process to cpu (or BENCH_CPU_CURRENT); returns the CPU, or -1 if not pinned
+static int PinToCpu(int cpu);
+
+// Write the CPU model (from /proc/cpuinfo) into buffer, or "unknown"
+static void GetCpuModel(char *buffer, size_t size);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see bench_harness.h for documentation)
+//----------------------------------------------------------------------------------
+
+void InitBench(BenchOptions *options, const char *suite, int argc, char **argv)
+{
+    *options = (BenchOptions){suite, NULL, NULL, BENCH_DEFAULT_REPS, BENCH_CPU_CURRENT};
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--json=", 7) == 0)
+            options->jsonPath = argv[i] + 7;
+        else if (strncmp(argv[i], "--filter=", 9) == 0)
+            options->filter = argv[i] + 9;
+        else if (strncmp(argv[i], "--reps=", 7) == 0)
+            options->reps = atoi(argv[i] + 7);
+        else if (strncmp(argv[i], "--cpu=", 6) == 0)
+            options->cpu = atoi(argv[i] + 6);
+        else {
+            fprintf(stderr, "Usage: %s [--json=path] [--filter=text] [--reps=N] [--cpu=N|-1]\n", argv[0]);
+            exit(2);
+        }
+    }
+    if (options->reps < 3) options->reps = 3;
+    if (options->reps > BENCH_MAX_REPS) options->reps = BENCH_MAX_REPS;
+
+    if (options->cpu != -1) options->cpu = PinToCpu(options->cpu);
+    if (options->cpu >= 0)
+        printf("%s: pinned to CPU %d, %d repetitions\n", suite, options->cpu, options->reps);
+    else
+        printf("%s: not pinned, %d repetitions\n", suite, options->reps);
+    printf("%-34s %12s %8s %14s\n", "benchmark", "ns/op", "MAD", "ns/item");
+}
+
+//----------------------------------------------------------------------------------
+// RunBench - Implementation Notes:
+// - Calibrates by doubling the operation count until one run reaches BENCH_REP_SECONDS
+// - The warm-up runs at the calibrated count, so caches and branch predictors have seen
+//   the same work that is then timed
+//----------------------------------------------------------------------------------
+bool RunBench(const BenchOptions *options, const char *name, BenchFunc func, void *context, long itemsPerOp,
+              const char *itemUnit)
+{
+    if (options->filter != NULL && strstr(name, options->filter) == NULL) return false;
+    if (resultCount == BENCH_MAX_RESULTS) {
+        fprintf(stderr, "Too many benchmarks, %s skipped\n", name);
+        return false;
+    }
+
+    long iterations = 1;
+    for (;;) {
+        double start = NowSeconds();
+        func(context, iterations);
+        if (NowSeconds() - start >= BENCH_REP_SECONDS || iterations >= (1L << 30)) break;
+        iterations *= 2;
+    }
+
+    double warmupEnd = NowSeconds() + BENCH_WARMUP_SECONDS;
+    while (NowSeconds() < warmupEnd) {
+        func(context, iterations);
+    }
+
+    BenchResult *r = &results[resultCount++];
+    *r = (BenchResult){"", itemUnit, itemsPerOp, iterations, options->reps, NULL, 0.0, 0.0};
+    snprintf(r->name, sizeof(r->name), "%s", name);
+    r->samplesNs = malloc(sizeof(double) * options->reps);
+    for (int rep = 0; rep < options->reps; rep++) {
+        double start = NowSeconds();
+        func(context, iterations);
+        r->samplesNs[rep] = (NowSeconds() - start) * 1e9 / iterations;
+    }
+
+    r->medianNs = Median(r->samplesNs, r->reps);
+    double *deviations = malloc(sizeof(double) * r->reps);
+    for (int rep = 0; rep < r->reps; rep++) {
+        double d = r->samplesNs[rep] - r->medianNs;
+        deviations[rep] = d < 0 ? -d : d;
+    }
+    r->madNs = Median(deviations, r->reps);
+    free(deviations);
+
+    printf("%-34s %12.2f %7.2f%% %14.3f\n", name, r->medianNs, 100.0 * r->madNs / r->medianNs,
+           r->medianNs / itemsPerOp);
+    fflush(stdout);
+    return true;
+}
+
+int FinishBench(const BenchOptions *options)
+{
+    int status = 0;
+    if (options->jsonPath != NULL) {
+        FILE *f = fopen(options->jsonPath, "w");
+        if (f == NULL) {
+            fprintf(stderr, "Cannot write %s\n", options->jsonPath);
+            status = 1;
+        }
+        else {
+            fprintf(f, "{\n  \"suite\": \"%s\",\n  \"cpu\": %d,\n  \"reps\": %d,\n", options->suite, options->cpu,
+                    options->reps);
+#if defined(__VERSION__)
+            fprintf(f, "  \"compiler\": \"%s\",\n", __VERSION__);
+#endif
+            char cpuModel[128];
+            GetCpuModel(cpuModel, sizeof(cpuModel));
+            fprintf(f, "  \"cpu_model\": \"%s\",\n", cpuModel);
+            fprintf(f, "  \"results\": [\n");
+            for (int i = 0; i < resultCount; i++) {
+                const BenchResult *r = &results[i];
+                fprintf(f,
+                        "    {\"name\": \"%s\", \"unit\": \"%s\", \"items_per_op\": %ld, \"iterations\": %ld, "
+                        "\"median_ns\": %.4f, \"mad_ns\": %.4f, \"median_ns_per_item\": %.4f, \"samples_ns\": [",
+                        r->name, r->itemUnit, r->itemsPerOp, r->iterations, r->medianNs, r->madNs,
+                        r->medianNs / r->itemsPerOp);
+                for (int rep = 0; rep < r->reps; rep++) {
+                    fprintf(f, "%s%.4f", rep > 0 ? ", " : "", r->samplesNs[rep]);
+                }
+                fprintf(f, "]}%s\n", i + 1 < resultCount ? "," : "");
+            }
+            fprintf(f, "  ]\n}\n");
+            fclose(f);
+            printf("Results written to %s\n", options->jsonPath);
+        }
+    }
+
+    for (int i = 0; i < resultCount; i++) {
+        free(results[i].samplesNs);
+    }
+    resultCount = 0;
+    return status;
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static double NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static int CompareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double Median(const double *values, int count)
+{
+    double *sorted = malloc(sizeof(double) * count);
+    memcpy(sorted, values, sizeof(double) * count);
+    qsort(sorted, count, sizeof(double), CompareDoubles);
+    double median = (count % 2) ? sorted[count / 2] : 0.5 * (sorted[count / 2 - 1] + sorted[count / 2]);
+    free(sorted);
+    return median;
+}
+
+static int PinToCpu(int cpu)
+{
+#if defined(__linux__)
+    if (cpu == BENCH_CPU_CURRENT) cpu = sched_getcpu();
+    if (cpu < 0) return -1;
+    cpu_set_t set;
+    CPU_ZERO(&set);
+    CPU_SET(cpu, &set);
+    if (sched_setaffinity(0, sizeof(set), &set) != 0) {
+        perror("sched_setaffinity");
+        return -1;
+    }
+    return cpu;
+#else
+    (void)cpu;
+    return -1;
+#endif
+}
+
+static void GetCpuModel(char *buffer, size_t size)
+{
+    snprintf(buffer, size, "unknown");
+    FILE *f = fopen("/proc/cpuinfo", "r");
+    if (f == NULL) return;
+    char line[256];
+    while (fgets(line, sizeof(line), f) != NULL) {
+        const char *colon = strchr(line, ':');
+        if (strncmp(line, "model name", 10) == 0 && colon != NULL) {
+            const char *value = colon + 1;
+            while (*value == ' ' || *value == '\t') value++;
+            snprintf(buffer, size, "%s", value);
+            buffer[strcspn(buffer, "\n\"\\")] = '\0'; // Keep the JSON string valid
+            break;
+        }
+    }
+    fclose(f);
+}
@@ -0,0 +1,64 @@
+//================================================================================================
+//
+//   bench_harness.h - Small timing harness for the Tailgunner microbenchmarks
+//
+//   Each benchmark is a function that runs an operation a given number of times. The
+//   harness calibrates the count so one repetition takes about BENCH_REP_SECONDS, warms
+//   up, times BENCH_DEFAULT_REPS repetitions, and reports the median and the median
+//   absolute deviation (MAD) per operation. The process is pinned to one CPU so the
+//   scheduler does not migrate it mid-run.
+//
+//   Results print as a table and, with --json=path, are written as JSON including every
+//   repetition's time, so runs can be compared statistically (tools/benchcmp.py).
+//
+//================================================================================================
+
+#ifndef BENCH_HARNESS_H
+#define BENCH_HARNESS_H
+
+#include <stdbool.h>
+
+#define BENCH_DEFAULT_REPS 21     // Timed repetitions per benchmark (odd, so the median is a sample)
+#define BENCH_MAX_REPS 1001
+#define BENCH_REP_SECONDS 0.01    // Target length of one repetition
+#define BENCH_WARMUP_SECONDS 0.05 // Untimed running before the first repetition
+#define BENCH_MAX_RESULTS 64
+
+// Runs the measured operation `iterations` times
+typedef void (*BenchFunc)(void *context, long iterations);
+
+// Harness options, from the command line
+typedef struct BenchOptions {
+    const char *suite;    // Name written to the JSON output
+    const char *jsonPath; // --json=path; NULL for no JSON
+    const char *filter;   // --filter=text: only benchmarks whose name contains text
+    int reps;             // --reps=N
+    int cpu;              // --cpu=N; -1 for no pinning
+} BenchOptions;
+
+//----------------------------------------------------------------------------------
+// Bench Harness Functions
+//----------------------------------------------------------------------------------
+
+// Parse harness options and pin the process
+//
+// Accepts --json=path, --filter=text, --reps=N and --cpu=N (default: the CPU the process
+// starts on; -1 disables pinning). Exits with usage on an unknown option.
+void InitBench(BenchOptions *options, const char *suite, int argc, char **argv);
+
+// Time one benchmark and record its result
+//
+// @param name Unique name, e.g. "update_enemies/500" (copied)
+// @param itemsPerOp Work items one operation handles (enemies, stars, bytes...); results
+//                   are also reported per item
+// @param itemUnit Name of the item ("enemy", "byte"...), for the table and JSON
+// @return false if the benchmark was skipped by --filter
+bool RunBench(const BenchOptions *options, const char *name, BenchFunc func, void *context, long itemsPerOp,
+              const char *itemUnit);
+
+// Write the JSON file (if requested)
+//
+// @return 0 on success, 1 if the file could not be written
+int FinishBench(const BenchOptions *options);
+
+#endif // BENCH_HARNESS_H
@@ -0,0 +1,392 @@
+//================================================================================================
+//
+//   sim_bench.c - Microbenchmarks for the simulation and leaderboard parsing hot paths
+//
+//   Covers the Bezier path helpers, UpdateEnemies at several enemy counts, FireLasers hit
+//   tests, UpdateForceField, UpdateStarfield, the leaderboard response parsers on
+//   synthetic payloads, and paging a large board into a ScoreBoard. Build and run with
+//   `make bench`; see bench_harness.h for options.
+//
+//================================================================================================
+
+#include "bench_harness.h"
+#include "config.h"
+#include "enemy.h"
+#include "forcefield.h"
+#include "laser.h"
+#include "leaderboard_parse.h"
+#include "raymath.h"
+#include "scoreboard.h"
+#include "starfield.h"
+#include "starfield_kernel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define BENCH_TICK (1.0f / 60.0f)
+#define BENCH_WAVE 10        // Past the nerfed waves, so every enemy slot is in use
+#define BENCH_SAMPLES 1024   // Precomputed inputs cycled through by a benchmark (power of two)
+#define BENCH_HISTORY_TICKS 8 // Ticks of enemy history recorded before hit tests
+#define BENCH_PARSE_CHUNK 1460 // Streaming parser input piece: one TCP segment of payload
+#define BENCH_PAGE_OVERLAP 5   // Rows each board page repeats from the previous one
+
+// Bezier helpers: one evaluation per operation
+typedef struct BezierBench {
+    Vector3 p0, p1, p2, p3;
+    float t[BENCH_SAMPLES];
+    Vector3 sink;
+} BezierBench;
+
+// UpdateEnemies over enough managers to hold count enemies
+typedef struct EnemiesBench {
+    EnemyManager *managers;
+    int managerCount;
+} EnemiesBench;
+
+// FireLasers against one full wave with lag-compensated history
+typedef struct FireBench {
+    EnemyManager enemies;
+    LaserManager lasers;
+    Camera camera;
+    Ray rays[BENCH_SAMPLES]; // Half aimed at enemies, half random
+    double clickTime;
+    int hits;
+} FireBench;
+
+// UpdateForceField in one state against a full wave inside the field
+typedef struct ForceFieldBench {
+    ForceFieldManager forceField;
+    ForceFieldState state;
+    EnemyManager enemies;
+    int repelled;
+} ForceFieldBench;
+
+// One parser on one payload
+typedef struct ParseBench {
+    int (*parse)(const char *data, size_t size, LeaderboardEntry *entries);
+    char *payload;
+    size_t size;
+    LeaderboardEntry entries[LEADERBOARD_MAX_SCORES];
+    int parsed;
+} ParseBench;
+
+// Pages of a large board parsed into a ScoreBoard
+typedef struct BoardBench {
+    char *pages[LEADERBOARD_BOARD_MAX_ROWS / LEADERBOARD_PAGE_SIZE];
+    size_t sizes[LEADERBOARD_BOARD_MAX_ROWS / LEADERBOARD_PAGE_SIZE];
+    int pageCount;
+    ScoreBoard board;
+    int rows;
+} BoardBench;
+
+//----------------------------------------------------------------------------------
+// Benchmark Bodies
+//----------------------------------------------------------------------------------
+
+static void BenchBezierPoint(void *context, long iterations)
+{
+    BezierBench *b = (BezierBench *)context;
+    for (long i = 0; i < iterations; i++) {
+        Vector3 p = GetCubicBezierPoint(b->p0, b->p1, b->p2, b->p3, b->t[i & (BENCH_SAMPLES - 1)]);
+        b->sink = Vector3Add(b->sink, p);
+    }
+}
+
+static void BenchBezierTangent(void *context, long iterations)
+{
+    BezierBench *b = (BezierBench *)context;
+    for (long i = 0; i < iterations; i++) {
+        Vector3 d = GetCubicBezierTangent(b->p0, b->p1, b->p2, b->p3, b->t[i & (BENCH_SAMPLES - 1)]);
+        b->sink = Vector3Add(b->sink, d);
+    }
+}
+
+// Wave and lives restart every call so enemy speed does not creep up over the run
+static void BenchUpdateEnemies(void *context, long iterations)
+{
+    EnemiesBench *b = (EnemiesBench *)context;
+    int lives = 0;
+    int wave = BENCH_WAVE;
+    for (long i = 0; i < iterations; i++) {
+        for (int m = 0; m < b->managerCount; m++) {
+            UpdateEnemies(&b->managers[m], &lives, &wave, BENCH_TICK);
+        }
+        wave = BENCH_WAVE;
+    }
+}
+
+// The hit enemy and the laser slots are restored after each shot so every shot sees a full wave
+static void BenchFireLasers(void *context, long iterations)
+{
+    FireBench *b = (FireBench *)context;
+    for (long i = 0; i < iterations; i++) {
+        b->hits += FireLasers(&b->lasers, &b->enemies, b->rays[i & (BENCH_SAMPLES - 1)], b->camera, b->clickTime);
+        for (int e = 0; e < WAVE_SIZE; e++) {
+            b->enemies.enemies[e].active = true;
+        }
+        for (int l = 0; l < MAX_LASERS; l++) {
+            b->lasers.lasers[l].active = false;
+        }
+    }
+}
+
+static void BenchForceField(void *context, long iterations)
+{
+    ForceFieldBench *b = (ForceFieldBench *)context;
+    for (long i = 0; i < iterations; i++) {
+        b->forceField.state = b->state;
+        b->forceField.timer = FORCE_FIELD_ACTIVE_TIME;
+        b->repelled += UpdateForceField(&b->forceField, &b->enemies, BENCH_TICK);
+    }
+}
+
+static void BenchUpdateStarfield(void *context, long iterations)
+{
+    (void)context;
+    for (long i = 0; i < iterations; i++) {
+        UpdateStarfield(BENCH_TICK);
+    }
+}
+
+static void BenchParse(void *context, long iterations)
+{
+    ParseBench *b = (ParseBench *)context;
+    for (long i = 0; i < iterations; i++) {
+        b->parsed += b->parse(b->payload, b->size, b->entries);
+    }
+}
+
+// Streaming topScores parse fed BENCH_PARSE_CHUNK bytes at a time, as a transfer delivers them
+static void BenchParseChunked(void *context, long iterations)
+{
+    ParseBench *b = (ParseBench *)context;
+    ScoresParser parser;
+    for (long i = 0; i < iterations; i++) {
+        InitScoresParser(&parser, false, b->entries);
+        for (size_t offset = 0; offset < b->size; offset += BENCH_PARSE_CHUNK) {
+            size_t remaining = b->size - offset;
+            size_t chunk = remaining < BENCH_PARSE_CHUNK ? remaining : BENCH_PARSE_CHUNK;
+            FeedScoresParser(&parser, b->payload + offset, chunk);
+        }
+        b->parsed += FinishScoresParser(&parser);
+    }
+}
+
+static void AddBenchEntry(void *context, const char *name, int score)
+{
+    AddBoardScore((ScoreBoard *)context, name, score);
+}
+
+// A whole board paged in from empty; each page overlaps the last one's final rows
+static void BenchBoardPages(void *context, long iterations)
+{
+    BoardBench *b = (BoardBench *)context;
+    for (long i = 0; i < iterations; i++) {
+        ClearScoreBoard(&b->board);
+        for (int p = 0; p < b->pageCount; p++) {
+            ParseScoresPage(b->pages[p], b->sizes[p], AddBenchEntry, &b->board);
+        }
+        b->rows += b->board.count;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// Setup
+//----------------------------------------------------------------------------------
+
+static float RandomUnit(void)
+{
+    return (float)rand() / (float)RAND_MAX;
+}
+
+// Spawn a full wave in every manager and move each a different distance along its paths
+static void SpawnBenchWaves(EnemyManager *managers, int count)
+{
+    int lives = 0;
+    for (int m = 0; m < count; m++) {
+        int wave = BENCH_WAVE;
+        InitEnemies(&managers[m], (uint64_t)m + 1);
+        SpawnWave(&managers[m], wave);
+        for (int t = 0; t <= m % 200; t++) {
+            UpdateEnemies(&managers[m], &lives, &wave, BENCH_TICK);
+        }
+    }
+}
+
+// Synthetic topScores response: the documented fields plus extras a real server adds
+static char *MakeGlobalPayload(int entries, size_t *size)
+{
+    size_t capacity = (size_t)entries * 96 + 16;
+    char *json = malloc(capacity);
+    size_t n = (size_t)snprintf(json, capacity, "[");
+    for (int i = 0; i < entries; i++) {
+        n += (size_t)snprintf(json + n, capacity - n,
+                              "%s{\"userName\":\"%c%c%c\",\"score\":%d,\"gameID\":19,\"date\":\"2025-01-%02d\"}",
+                              i ? "," : "", 'A' + i % 26, 'A' + (i / 26) % 26, 'A' + (i / 676) % 26, 1000 - i % 1000,
+                              1 + i % 28);
+    }
+    n += (size_t)snprintf(json + n, capacity - n, "]");
+    *size = n;
+    return json;
+}
+
+// Synthetic topScores page: board rows firstRow onwards, best score first, all distinct
+static char *MakeBoardPage(int firstRow, int entries, size_t *size)
+{
+    size_t capacity = (size_t)entries * 96 + 16;
+    char *json = malloc(capacity);
+    size_t n = (size_t)snprintf(json, capacity, "[");
+    for (int i = 0; i < entries; i++) {
+        int row = firstRow + i;
+        n += (size_t)snprintf(json + n, capacity - n,
+                              "%s{\"userName\":\"%c%c%c\",\"score\":%d,\"gameID\":19,\"date\":\"2025-01-%02d\"}",
+                              i ? "," : "", 'A' + row % 26, 'A' + (row / 26) % 26, 'A' + (row / 676) % 26,
+                              1000000 - row, 1 + row % 28);
+    }
+    n += (size_t)snprintf(json + n, capacity - n, "]");
+    *size = n;
+    return json;
+}
+
+// Synthetic userScores response
+static char *MakeUserPayload(int entries, size_t *size)
+{
+    size_t capacity = (size_t)entries * 24 + 16;
+    char *json = malloc(capacity);
+    size_t n = (size_t)snprintf(json, capacity, "[");
+    for (int i = 0; i < entries; i++) {
+        n += (size_t)snprintf(json + n, capacity - n, "%s{\"ABC\":%d}", i ? "," : "", 1000 - i % 1000);
+    }
+    n += (size_t)snprintf(json + n, capacity - n, "]");
+    *size = n;
+    return json;
+}
+
+int main(int argc, char **argv)
+{
+    BenchOptions options;
+    InitBench(&options, "sim", argc, argv);
+    srand(1234);
+    char name[64];
+
+    // Bezier helpers on a typical enemy path
+    static BezierBench bezier;
+    bezier.p0 = (Vector3){12.0f, -8.0f, -140.0f};
+    bezier.p1 = (Vector3){3.0f, 2.0f, -70.0f};
+    bezier.p2 = (Vector3){-30.0f, 15.0f, -25.0f};
+    bezier.p3 = (Vector3){30.0f, -15.0f, 1.0f};
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        bezier.t[i] = RandomUnit();
+    }
+    RunBench(&options, "bezier_point", BenchBezierPoint, &bezier, 1, "eval");
+    RunBench(&options, "bezier_tangent", BenchBezierTangent, &bezier, 1, "eval");
+
+    // UpdateEnemies: one wave, then enough waves to spill out of L1 and L2
+    static const int enemyCounts[] = {WAVE_SIZE, 50 * WAVE_SIZE, 1000 * WAVE_SIZE, 20000 * WAVE_SIZE};
+    for (size_t c = 0; c < sizeof(enemyCounts) / sizeof(enemyCounts[0]); c++) {
+        EnemiesBench enemies = {NULL, enemyCounts[c] / WAVE_SIZE};
+        enemies.managers = malloc(sizeof(EnemyManager) * enemies.managerCount);
+        SpawnBenchWaves(enemies.managers, enemies.managerCount);
+        snprintf(name, sizeof(name), "update_enemies/%d", enemyCounts[c]);
+        RunBench(&options, name, BenchUpdateEnemies, &enemies, enemyCounts[c], "enemy");
+        free(enemies.managers);
+    }
+
+    // FireLasers: one shot per operation, with lag-compensated positions between history entries
+    static FireBench fire;
+    fire.camera = (Camera){{0.0f, 0.0f, 0.0f}, {0.0f, 0.0f, -1.0f}, {0.0f, 1.0f, 0.0f}, 45.0f, CAMERA_PERSPECTIVE};
+    SpawnBenchWaves(&fire.enemies, 1);
+    InitLasers(&fire.lasers);
+    for (int t = 0; t < BENCH_HISTORY_TICKS; t++) {
+        RecordEnemyHistory(&fire.enemies, t * BENCH_TICK);
+    }
+    fire.clickTime = (BENCH_HISTORY_TICKS - 2.5) * BENCH_TICK;
+    for (int i = 0; i < BENCH_SAMPLES; i++) {
+        Vector3 direction = {RandomUnit() - 0.5f, RandomUnit() - 0.5f, -1.0f};
+        if (i % 2 == 0) direction = fire.enemies.enemies[(i / 2) % WAVE_SIZE].position;
+        fire.rays[i] = (Ray){fire.camera.position, Vector3Normalize(direction)};
+    }
+    RunBench(&options, "fire_lasers", BenchFireLasers, &fire, 1, "shot");
+
+    // UpdateForceField: active with every enemy inside the field, and recharging
+    static ForceFieldBench field;
+    SpawnBenchWaves(&field.enemies, 1);
+    for (int e = 0; e < WAVE_SIZE; e++) {
+        field.enemies.enemies[e].position = (Vector3){(float)e, 0.0f, -FORCE_FIELD_RADIUS / 2};
+    }
+    InitForceField(&field.forceField);
+    field.state = FF_STATE_ACTIVE;
+    RunBench(&options, "force_field/active", BenchForceField, &field, 1, "update");
+    field.state = FF_STATE_COOLDOWN;
+    RunBench(&options, "force_field/cooldown", BenchForceField, &field, 1, "update");
+
+    // UpdateStarfield: the CPU part only; InitStarfield needs a GL context, so fill the arrays here
+    starfield.transforms = malloc(MAX_STARS * sizeof(Matrix));
+    starfield.x = malloc(MAX_STARS * sizeof(float));
+    starfield.y = malloc(MAX_STARS * sizeof(float));
+    starfield.z = malloc(MAX_STARS * sizeof(float));
+    starfield.poolX = malloc((STAR_POOL_SIZE + STAR_POOL_PAD) * sizeof(float));
+    starfield.poolY = malloc((STAR_POOL_SIZE + STAR_POOL_PAD) * sizeof(float));
+    for (int i = 0; i < STAR_POOL_SIZE; i++) {
+        starfield.poolX[i] = (RandomUnit() - 0.5f) * 2 * STAR_XY_RANGE;
+        starfield.poolY[i] = (RandomUnit() - 0.5f) * 2 * STAR_XY_RANGE;
+    }
+    FillStarPool(starfield.poolX);
+    FillStarPool(starfield.poolY);
+    for (int i = 0; i < MAX_STARS; i++) {
+        starfield.x[i] = starfield.poolX[i];
+        starfield.y[i] = starfield.poolY[i];
+        starfield.z[i] = STAR_Z_FAR + RandomUnit() * (STAR_Z_NEAR - STAR_Z_FAR);
+        starfield.transforms[i] = MatrixTranslate(starfield.x[i], starfield.y[i], starfield.z[i]);
+    }
+    RunBench(&options, "update_starfield", BenchUpdateStarfield, NULL, MAX_STARS, "star");
+
+    // Leaderboard parsers: a normal response, and oversized ones (all of it is parsed),
+    // with the configured parser and with the cJSON one on its arena and on malloc
+    static const int payloadEntries[] = {LEADERBOARD_MAX_SCORES, 100, 1000, 100000};
+    for (size_t p = 0; p < sizeof(payloadEntries) / sizeof(payloadEntries[0]); p++) {
+        static ParseBench parse;
+        parse.payload = MakeGlobalPayload(payloadEntries[p], &parse.size);
+        parse.parse = ParseGlobalScores;
+        snprintf(name, sizeof(name), "parse_global/%d", payloadEntries[p]);
+        RunBench(&options, name, BenchParse, &parse, (long)parse.size, "byte");
+        parse.parse = ParseGlobalScoresTree;
+        snprintf(name, sizeof(name), "parse_global_cjson/%d", payloadEntries[p]);
+        SetParseArenaEnabled(true);
+        RunBench(&options, name, BenchParse, &parse, (long)parse.size, "byte");
+        snprintf(name, sizeof(name), "parse_global_cjson_malloc/%d", payloadEntries[p]);
+        SetParseArenaEnabled(false);
+        RunBench(&options, name, BenchParse, &parse, (long)parse.size, "byte");
+        snprintf(name, sizeof(name), "parse_global_chunked/%d", payloadEntries[p]);
+        RunBench(&options, name, BenchParseChunked, &parse, (long)parse.size, "byte");
+        free(parse.payload);
+
+        parse.payload = MakeUserPayload(payloadEntries[p], &parse.size);
+        parse.parse = ParseUserScores;
+        snprintf(name, sizeof(name), "parse_user/%d", payloadEntries[p]);
+        RunBench(&options, name, BenchParse, &parse, (long)parse.size, "byte");
+        parse.parse = ParseUserScoresTree;
+        snprintf(name, sizeof(name), "parse_user_cjson/%d", payloadEntries[p]);
+        SetParseArenaEnabled(true);
+        RunBench(&options, name, BenchParse, &parse, (long)parse.size, "byte");
+        snprintf(name, sizeof(name), "parse_user_cjson_malloc/%d", payloadEntries[p]);
+        SetParseArenaEnabled(false);
+        RunBench(&options, name, BenchParse, &parse, (long)parse.size, "byte");
+        free(parse.payload);
+    }
+
+    // Large board paging: pages of LEADERBOARD_PAGE_SIZE rows, each repeating the previous
+    // page's last BENCH_PAGE_OVERLAP rows (as when scores are added between fetches)
+    static BoardBench board;
+    board.pageCount = LEADERBOARD_BOARD_MAX_ROWS / LEADERBOARD_PAGE_SIZE;
+    for (int p = 0; p < board.pageCount; p++) {
+        int firstRow = p * LEADERBOARD_PAGE_SIZE - (p > 0 ? BENCH_PAGE_OVERLAP : 0);
+        board.pages[p] = MakeBoardPage(firstRow, LEADERBOARD_PAGE_SIZE, &board.sizes[p]);
+    }
+    snprintf(name, sizeof(name), "board_pages/%d", LEADERBOARD_BOARD_MAX_ROWS);
+    RunBench(&options, name, BenchBoardPages, &board, LEADERBOARD_BOARD_MAX_ROWS, "row");
+    for (int p = 0; p < board.pageCount; p++) free(board.pages[p]);
+    FreeScoreBoard(&board.board);
+
+    return FinishBench(&options);
+}
@@ -0,0 +1,98 @@
+//================================================================================================
+//
+//   starfield_bench.c - Microbenchmark for the starfield update kernel
+//
+//   Times UpdateStarPositions against the scalar reference at large star counts and
+//   checks both produce identical positions. Build and run with `make bench`.
+//
+//================================================================================================
+
+#include "config.h"
+#include "starfield_kernel.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#define BENCH_FRAMES 200
+
+typedef void (*StarKernel)(float *, float *, float *, int, float, float, float, const float *, const float *, int);
+
+static double NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static float RandomRange(int min, int max)
+{
+    return (float)(min + rand() % (max - min + 1));
+}
+
+// Run BENCH_FRAMES frames at 60 FPS speed and return nanoseconds per star per frame
+static double RunKernel(StarKernel kernel, float *x, float *y, float *z, int count, const float *poolX,
+                        const float *poolY)
+{
+    const float dz = STAR_SPEED / 60.0f;
+    double start = NowSeconds();
+    for (int f = 0; f < BENCH_FRAMES; f++) {
+        kernel(x, y, z, count, dz, STAR_Z_FAR, STAR_Z_NEAR, poolX, poolY, (f * 977) & (STAR_POOL_SIZE - 1));
+    }
+    double elapsed = NowSeconds() - start;
+    return elapsed * 1e9 / ((double)BENCH_FRAMES * count);
+}
+
+int main(void)
+{
+    static const int counts[] = {MAX_STARS, 100000, 1000000};
+    float *poolX = malloc((STAR_POOL_SIZE + STAR_POOL_PAD) * sizeof(float));
+    float *poolY = malloc((STAR_POOL_SIZE + STAR_POOL_PAD) * sizeof(float));
+
+    srand(1234);
+    for (int i = 0; i < STAR_POOL_SIZE; i++) {
+        poolX[i] = RandomRange(-STAR_XY_RANGE, STAR_XY_RANGE);
+        poolY[i] = RandomRange(-STAR_XY_RANGE, STAR_XY_RANGE);
+    }
+    FillStarPool(poolX);
+    FillStarPool(poolY);
+
+    printf("starfield kernel: %s\n", GetStarKernelName());
+    printf("%10s %14s %14s %8s\n", "stars", "scalar ns/star", "simd ns/star", "speedup");
+
+    int failed = 0;
+    for (size_t c = 0; c < sizeof(counts) / sizeof(counts[0]); c++) {
+        int n = counts[c];
+        size_t bytes = (size_t)n * sizeof(float);
+        float *sx = malloc(bytes), *sy = malloc(bytes), *sz = malloc(bytes);
+        float *vx = malloc(bytes), *vy = malloc(bytes), *vz = malloc(bytes);
+        for (int i = 0; i < n; i++) {
+            sx[i] = RandomRange(-STAR_XY_RANGE, STAR_XY_RANGE);
+            sy[i] = RandomRange(-STAR_XY_RANGE, STAR_XY_RANGE);
+            sz[i] = RandomRange((int)STAR_Z_FAR, (int)STAR_Z_NEAR);
+        }
+        memcpy(vx, sx, bytes);
+        memcpy(vy, sy, bytes);
+        memcpy(vz, sz, bytes);
+
+        double scalarNs = RunKernel(UpdateStarPositionsScalar, sx, sy, sz, n, poolX, poolY);
+        double simdNs = RunKernel(UpdateStarPositions, vx, vy, vz, n, poolX, poolY);
+
+        if (memcmp(sx, vx, bytes) != 0 || memcmp(sy, vy, bytes) != 0 || memcmp(sz, vz, bytes) != 0) {
+            fprintf(stderr, "ERROR: SIMD and scalar results differ at %d stars\n", n);
+            failed = 1;
+        }
+        printf("%10d %14.3f %14.3f %7.2fx\n", n, scalarNs, simdNs, scalarNs / simdNs);
+
+        free(sx);
+        free(sy);
+        free(sz);
+        free(vx);
+        free(vy);
+        free(vz);
+    }
+
+    free(poolX);
+    free(poolY);
+    return failed;
+}
@@ -0,0 +1,214 @@
+//================================================================================================
+//
+//   autopilot.c - Bot player implementation
+//
+//   See autopilot.h for module interface documentation.
+//
+//   Implementation notes:
+//   - The most urgent enemy is the one that leaves the screen (or gets past) soonest; the
+//     rest of its Bezier path is sampled to find out when. Repelled enemies are left alone
+//   - Enemy screen positions come from GetWorldToScreenEx, the inverse of GetScreenRay, so
+//     the crosshair lands where StepGame's ray goes through the enemy
+//   - Reaction time is modelled as a pause after each shot or lost target during which the
+//     bot neither moves nor fires; the next target is chosen when the pause ends
+//   - Shots are taken with no click age, so lag compensation tests the positions the bot saw
+//
+//================================================================================================
+
+#include "autopilot.h"
+#include "config.h"
+#include "raymath.h"
+#include <math.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define AUTOPILOT_SALT 0x6a09e667f3bcc909ull // Keeps the bot's seed apart from game seeds
+#define AUTOPILOT_PATH_STEP 0.01f            // Path parameter step when looking ahead along a path
+#define AUTOPILOT_PATH_MARGIN 0.1f           // Seconds of slack required to go after a target
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// Screen position of an enemy the bot may aim at; false if it is repelled, behind the
+// camera or off screen
+static bool GetTargetScreenPosition(const Enemy *enemy, Camera camera, int width, int height, Vector2 *screen);
+
+// Pick a new aim error within skill.aimError pixels (uniform over the disc)
+static Vector2 RollAimOffset(Autopilot *bot);
+
+// Seconds until the enemy in slot, following its path, can no longer be aimed at (0 if already)
+static float GetShotWindow(Autopilot *bot, int slot, const Enemy *enemy, Camera camera, int width, int height,
+                           float pathPerSecond);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see autopilot.h for documentation)
+//----------------------------------------------------------------------------------
+
+AutopilotSkill GetDefaultAutopilotSkill(void)
+{
+    return (AutopilotSkill){AUTOPILOT_REACTION_TIME, AUTOPILOT_AIM_ERROR, AUTOPILOT_AIM_SPEED};
+}
+
+bool ParseAutopilotSkill(const char *text, AutopilotSkill *skill)
+{
+    char *end;
+    double reactionMs = strtod(text, &end);
+    if (end == text || reactionMs < 0.0) return false;
+    skill->reactionTime = (float)(reactionMs / 1000.0);
+    if (*end == ',') {
+        const char *error = end + 1;
+        double aimError = strtod(error, &end);
+        if (end == error || aimError < 0.0) return false;
+        skill->aimError = (float)aimError;
+    }
+    return *end == '\0';
+}
+
+void InitAutopilot(Autopilot *bot, AutopilotSkill skill, uint64_t seed)
+{
+    bot->skill = skill;
+    SeedRng(&bot->rng, seed ^ AUTOPILOT_SALT);
+    bot->target = -1;
+    bot->waitTime = skill.reactionTime;
+    bot->aimOffset = (Vector2){0.0f, 0.0f};
+    memset(bot->exitPath, 0, sizeof(bot->exitPath));
+    bot->exitWidth = 0; // Nothing cached yet
+    bot->exitHeight = 0;
+}
+
+//----------------------------------------------------------------------------------
+// UpdateAutopilot - Implementation Notes:
+// - Mirrors StepGame's order: the crosshair moves first, then the shot is tested from
+//   the moved (and clamped) position
+// - Fires on the tick the crosshair reaches the aim point; with aim error the game's own
+//   hit test decides whether that is a hit, and a miss re-rolls the error
+//----------------------------------------------------------------------------------
+void UpdateAutopilot(Autopilot *bot, const GameSession *session, float frameTime, int screenWidth, int screenHeight,
+                     GameInput *input)
+{
+    const EnemyManager *enemies = &session->enemies;
+    Vector2 delta = {0.0f, 0.0f};
+    bool fire = false;
+    Vector2 screen;
+
+    // Seconds each enemy stays shootable, and the order the bot deals with them in
+    float pathPerSecond = GetEnemyPathSpeed(enemies, session->wave) / fmaxf(frameTime, 1e-3f);
+    float window[WAVE_SIZE];
+    int order[WAVE_SIZE];
+    int count = 0;
+    for (int i = 0; i < WAVE_SIZE; i++) {
+        const Enemy *e = &enemies->enemies[i];
+        if (!e->active || e->state != ENEMY_STATE_NORMAL) continue;
+        window[i] = GetShotWindow(bot, i, e, session->camera, screenWidth, screenHeight, pathPerSecond);
+        int j = count++;
+        for (; j > 0 && window[order[j - 1]] > window[i]; j--) {
+            order[j] = order[j - 1];
+        }
+        order[j] = i;
+    }
+
+    bot->waitTime -= frameTime;
+    if (bot->target >= 0 &&
+        !GetTargetScreenPosition(&enemies->enemies[bot->target], session->camera, screenWidth, screenHeight, &screen)) {
+        // Destroyed, repelled or out of sight: takes a moment to notice
+        bot->target = -1;
+        bot->waitTime = bot->skill.reactionTime;
+    }
+
+    if (bot->target < 0 && bot->waitTime <= 0.0f) {
+        // The most urgent enemy the crosshair can still get to before it leaves
+        for (int k = 0; k < count && bot->target < 0; k++) {
+            const Enemy *e = &enemies->enemies[order[k]];
+            if (!GetTargetScreenPosition(e, session->camera, screenWidth, screenHeight, &screen)) continue;
+            float travel = Vector2Distance(screen, session->virtualMouse) / bot->skill.aimSpeed;
+            if (window[order[k]] > travel + AUTOPILOT_PATH_MARGIN) bot->target = order[k];
+        }
+        if (bot->target >= 0) bot->aimOffset = RollAimOffset(bot);
+    }
+
+    if (bot->target >= 0 && bot->waitTime <= 0.0f) {
+        GetTargetScreenPosition(&enemies->enemies[bot->target], session->camera, screenWidth, screenHeight, &screen);
+        Vector2 aim = Vector2Add(screen, bot->aimOffset);
+        aim.x = Clamp(aim.x, 0.0f, (float)screenWidth);
+        aim.y = Clamp(aim.y, 0.0f, (float)screenHeight);
+
+        Vector2 offset = Vector2Subtract(aim, session->virtualMouse);
+        float distance = Vector2Length(offset);
+        float step = bot->skill.aimSpeed * frameTime;
+        delta = (distance > step) ? Vector2Scale(offset, step / distance) : offset;
+
+        if (distance <= step) {
+            fire = true;
+            bot->waitTime = bot->skill.reactionTime;
+            bot->aimOffset = RollAimOffset(bot);
+        }
+    }
+
+    // The force field goes up when an enemy it would repel can't be shot in time: each
+    // enemy ahead of it in the order costs one reaction time
+    bool forceField = false;
+    if (session->forceField.state == FF_STATE_READY) {
+        for (int k = 0; k < count; k++) {
+            const Enemy *e = &enemies->enemies[order[k]];
+            bool repellable = e->position.z < 0.0f && -e->position.z < FORCE_FIELD_RADIUS;
+            if (repellable && window[order[k]] < (k + 1) * bot->skill.reactionTime * AUTOPILOT_SHIELD_MARGIN)
+                forceField = true;
+        }
+    }
+
+    BuildGameInput(input, frameTime, delta, fire, 0.0, forceField, screenWidth, screenHeight);
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static bool GetTargetScreenPosition(const Enemy *enemy, Camera camera, int width, int height, Vector2 *screen)
+{
+    if (!enemy->active || enemy->state != ENEMY_STATE_NORMAL || enemy->position.z > -1.0f) return false;
+    *screen = GetWorldToScreenEx(enemy->position, camera, width, height);
+    return screen->x >= 0.0f && screen->x <= (float)width && screen->y >= 0.0f && screen->y <= (float)height;
+}
+
+//----------------------------------------------------------------------------------
+// GetShotWindow - Implementation Notes:
+// - Steps along the rest of the Bezier path until the enemy would leave the screen or
+//   get too close to aim at; the end of the path counts as leaving
+// - The result only depends on the path and screen size, so it is cached per slot and
+//   searched again for a new path, a resized screen, or an enemy that came back on
+//   screen past the cached exit
+//----------------------------------------------------------------------------------
+static float GetShotWindow(Autopilot *bot, int slot, const Enemy *enemy, Camera camera, int width, int height,
+                           float pathPerSecond)
+{
+    if (width != bot->exitWidth || height != bot->exitHeight) {
+        memset(bot->exitPath, 0, sizeof(bot->exitPath));
+        bot->exitWidth = width;
+        bot->exitHeight = height;
+    }
+
+    // p0..p3 are consecutive Vector3 fields of Enemy
+    bool cached = memcmp(bot->exitPath[slot], &enemy->p0, sizeof(bot->exitPath[slot])) == 0;
+    if (!cached || enemy->t > bot->exitT[slot]) {
+        Enemy ahead = *enemy;
+        Vector2 screen;
+        float t = enemy->t;
+        while (t < 1.0f) {
+            ahead.position = GetCubicBezierPoint(enemy->p0, enemy->p1, enemy->p2, enemy->p3, t);
+            if (!GetTargetScreenPosition(&ahead, camera, width, height, &screen)) break;
+            t += AUTOPILOT_PATH_STEP;
+        }
+        bot->exitT[slot] = t;
+        memcpy(bot->exitPath[slot], &enemy->p0, sizeof(bot->exitPath[slot]));
+    }
+    return fmaxf(bot->exitT[slot] - enemy->t, 0.0f) / pathPerSecond;
+}
+
+static Vector2 RollAimOffset(Autopilot *bot)
+{
+    if (bot->skill.aimError <= 0.0f) return (Vector2){0.0f, 0.0f};
+    float angle = (float)GetRngValue(&bot->rng, 0, 3599) * 0.1f * DEG2RAD;
+    float radius = bot->skill.aimError * sqrtf((float)GetRngValue(&bot->rng, 0, 10000) / 10000.0f);
+    return (Vector2){radius * cosf(angle), radius * sinf(angle)};
+}
@@ -0,0 +1,69 @@
+//================================================================================================
+//
+//   autopilot.h - Bot player for unattended Tailgunner sessions
+//
+//   The autopilot reads a GameSession and produces the GameInput a player would: it picks
+//   the enemy closest to getting past, steers the virtual mouse toward where that enemy
+//   is on screen, fires when the crosshair ray would hit it, and raises the force field
+//   when enemies get too close. Its output goes through GameInput like real input, so
+//   bot games record and replay exactly. Used for profiling and long late-wave runs.
+//
+//================================================================================================
+
+#ifndef AUTOPILOT_H
+#define AUTOPILOT_H
+
+#include "game.h"
+#include "rng.h"
+
+// How human the bot plays
+typedef struct AutopilotSkill {
+    float reactionTime; // Seconds before acting on a new target, and between shots
+    float aimError;     // Pixels; each aim point is chosen up to this far from the enemy's center
+    float aimSpeed;     // Fastest crosshair movement in pixels per second
+} AutopilotSkill;
+
+typedef struct Autopilot {
+    AutopilotSkill skill;
+    Rng rng;            // Aim error; separate from the game's RNG so the bot never changes the game
+    int target;         // Enemy index being aimed at, or -1
+    float waitTime;     // Seconds left before the bot may move to a new target or fire again
+    Vector2 aimOffset;  // Current aim error, re-rolled for each target and each shot
+
+    // Per enemy slot: path parameter where the enemy leaves the screen, and the path and
+    // screen size it was found for (paths are fixed, so it is only searched once per path)
+    float exitT[WAVE_SIZE];
+    Vector3 exitPath[WAVE_SIZE][4];
+    int exitWidth, exitHeight;
+} Autopilot;
+
+//----------------------------------------------------------------------------------
+// Autopilot Functions
+//----------------------------------------------------------------------------------
+
+// Default skill: the AUTOPILOT_* values in config.h
+AutopilotSkill GetDefaultAutopilotSkill(void);
+
+// Parse a "reaction_ms[,aim_error_px]" command-line value into skill
+//
+// Fields that are left out keep their value in skill.
+//
+// @return false if text is not in that form or a value is negative
+bool ParseAutopilotSkill(const char *text, AutopilotSkill *skill);
+
+// Start the bot with no target
+//
+// @param seed Seed for the aim error
+void InitAutopilot(Autopilot *bot, AutopilotSkill skill, uint64_t seed);
+
+// Decide this tick's input
+//
+// Targets and aim are computed with the same geometry StepGame uses (GetScreenRay and the
+// enemy hit spheres), so a shot the bot takes on an exact aim point hits.
+//
+// @param frameTime Length of the tick the input is for, in seconds
+// @param screenWidth,screenHeight Screen size the input is evaluated against
+void UpdateAutopilot(Autopilot *bot, const GameSession *session, float frameTime, int screenWidth, int screenHeight,
+                     GameInput *input);
+
+#endif // AUTOPILOT_H
@@ -10,8 +10,44 @@
 // !!! Set to 21 for production releases !!!
 #define LEADERBOARD_GAME_ID 19
 #define LEADERBOARD_BASE_URL "https://geraldburke.com/apis/simple-leaderboard-api/"
+// Desktop: environment variable naming another leaderboard service to use instead, e.g. the
+// local stand-in tools/lbserver.py; its scores and lists are stored apart from the real ones
+#define LEADERBOARD_URL_ENV "TAILGUNNER_LEADERBOARD_URL"
 #define LEADERBOARD_MAX_SCORES 10
 #define LEADERBOARD_NAME_LENGTH 3
+// 1: parse leaderboard responses with the allocation-free streaming parser, 0: with cJSON
+#define LEADERBOARD_STREAM_PARSER 1
+// Largest HTTP response body accepted (bytes); a bigger transfer is abandoned as a failure
+#define HTTP_MAX_RESPONSE_SIZE (1024 * 1024)
+// HTTP request deadlines (ms): to connect (desktop only), and for the whole request
+// clang-format off
+#define HTTP_CONNECT_TIMEOUT_MS  5000
+#define HTTP_REQUEST_TIMEOUT_MS 15000
+// clang-format on
+// Score submission retry backoff: first wait after a failure, doubled per failure up to the max
+// (seconds); each wait is jittered by +/- 50% so clients that failed together don't retry together
+// clang-format off
+#define SCORE_RETRY_MIN_DELAY   2.0
+#define SCORE_RETRY_MAX_DELAY 300.0
+// clang-format on
+// Leaderboard prefetch: seconds on the title screen before prefetching, and how long a
+// revalidated list counts as current (opening the leaderboard then shows it without a refetch)
+// clang-format off
+#define LEADERBOARD_PREFETCH_IDLE_DELAY  2.0
+#define LEADERBOARD_FRESH_TIME          30.0
+// clang-format on
+// Leaderboard list fetches that fail with nothing to show: retries before giving up until the
+// leaderboard is next opened, and the first wait (seconds; doubled per retry, +/- 50% jitter)
+// clang-format off
+#define LEADERBOARD_FETCH_MAX_RETRIES 3
+#define LEADERBOARD_FETCH_RETRY_DELAY 1.0
+// clang-format on
+// Global board beyond the top 10: rows requested per page as the list is scrolled, and the
+// most rows kept
+// clang-format off
+#define LEADERBOARD_PAGE_SIZE        100
+#define LEADERBOARD_BOARD_MAX_ROWS 10000
+// clang-format on
 
 // Gameplay tuning constants
 #define POINTS_FOR_EXTRA_LIFE 50
@@ -42,6 +78,78 @@
 #define ENEMY_REPEL_DT_DFRAME 0.01f    // Speed when repelled
 // clang-format on
 
+// Frame rate and idle presentation on static screens (title, help, game over, leaderboard)
+// clang-format off
+#define TARGET_FPS          60
+#define IDLE_SETTLE_FRAMES   2   // Frames drawn after the last change before drawing stops
+#define IDLE_WAIT_TIMEOUT    0.5 // Desktop: longest time (s) to block waiting for input while idle
+#define IDLE_WEB_FPS        15   // Web: loop rate while idle
+// clang-format on
+
+// Desktop frame pacing (see pacing.h for the modes)
+// clang-format off
+#define PACING_SPIN_TAIL      0.002 // Seconds of each sleep spent spinning for precision
+#define PACING_PRESENT_MARGIN 0.002 // Low latency: seconds reserved for GPU flush and swap
+#define PACING_WORK_SMOOTHING 0.1   // EMA weight of the newest CPU work time
+// clang-format on
+
+// Lag-compensated laser hit tests
+// clang-format off
+#define LAG_COMPENSATION    1   // Hit-test enemies where they were shown when the click happened
+#define ENEMY_HISTORY_SIZE  8   // Presented positions remembered per enemy
+#define LAG_COMP_MAX_AGE    0.1 // Seconds; clicks older than this are treated as this old
+// clang-format on
+
+// Simulation input quantisation (see game.h)
+// clang-format off
+#define GAME_MAX_DT          0.1f // Longest tick the simulation takes; longer frames run in slow motion
+#define GAME_MOUSE_SUBPIXELS 16   // Mouse movement is stored in 1/16 pixel steps
+// clang-format on
+
+// Replay viewer (see replay.h)
+// clang-format off
+#define REPLAY_SNAPSHOT_INTERVAL  300 // Ticks between session snapshots (5 s at 60 FPS)
+#define REPLAY_SEEK_STEP          300 // Ticks moved by LEFT/RIGHT
+#define REPLAY_FAST_FORWARD_TICKS  20 // Ticks simulated per frame while F is held
+// clang-format on
+
+// Autopilot bot player (--autopilot, see autopilot.h)
+// clang-format off
+#define AUTOPILOT_REACTION_TIME     0.25f // Seconds before acting on a new target or after a shot
+#define AUTOPILOT_AIM_ERROR         6.0f  // Pixels; each aim point is off by up to this much
+#define AUTOPILOT_AIM_SPEED      4000.0f  // Fastest crosshair movement, pixels per second
+#define AUTOPILOT_SHIELD_MARGIN     1.5f  // Force field goes up if an enemy can't be shot within this many turns
+#define AUTOPILOT_HEADLESS_DT       (1.0f / 60.0f) // Tick length of --autopilot --headless games
+// clang-format on
+
+// Latency test harness (--latency-test, see latency.h)
+// clang-format off
+#define LATENCY_DEFAULT_SHOTS  300  // Shots measured when no count is given
+#define LATENCY_MAX_SHOTS      5000
+#define LATENCY_WARMUP_SHOTS   10   // Initial shots discarded while caches and drivers settle
+#define LATENCY_SHOT_GAP       0.1  // Seconds between a laser being presented and the next click
+#define LATENCY_BIN_MS         2.0  // Histogram bin width
+#define LATENCY_HISTOGRAM_BINS 40   // Last bin collects everything slower
+// clang-format on
+
+// Dynamic resolution for the 3D scene (see resolution.c for the controller)
+// clang-format off
+#define DYNRES_ENABLED            1
+#define DYNRES_MIN_SCALE          0.5f  // Lowest render scale of the 3D pass
+#define DYNRES_SMOOTHING          0.1f  // EMA weight of the newest frame time
+#define DYNRES_HIGH_WATER         1.10f // Scale down when smoothed frame time exceeds budget by this factor
+#define DYNRES_STEP_DOWN_GAIN     0.5f  // Scale reduction per unit of relative overrun
+#define DYNRES_STEP_UP            0.05f // Scale increase per probe
+#define DYNRES_PROBE_DELAY        2.0f  // Seconds within budget before probing a higher scale
+#define DYNRES_PROBE_DELAY_MAX   30.0f  // Longest probe delay after repeated failed probes
+#define DYNRES_PROBE_FAIL_TIME    1.0f  // A drop this soon after a raise counts as a failed probe
+#define DYNRES_MAX_SAMPLE         0.25f // Frame times above this are stalls and are ignored
+// clang-format on
+
+// Render the gameplay HUD into a texture that is only redrawn when its values change.
+// Set to 0 to draw it immediately every frame (for comparing the HUD cost in the FPS log).
+#define HUD_RETAINED 1
+
 // Maximum counts
 
 #define MAX_LASERS 2
@@ -54,6 +162,14 @@
 #define FORCE_FIELD_RADIUS      10.0f
 // clang-format on
 
+// Starfield tuning
+// clang-format off
+#define STAR_SPEED     60.0f  // Units per second along -z
+#define STAR_XY_RANGE  100    // Stars spawn in [-range, range] on x and y
+#define STAR_Z_FAR    -200.0f // Stars past this depth wrap...
+#define STAR_Z_NEAR      0.0f // ...back to this depth
+// clang-format on
+
 // Color definitions
 // clang-format off
 #if 0
@@ -23,20 +23,6 @@
 // @param enemy The enemy to render, must be active
 static void DrawEnemyShip(const Enemy *enemy);
 
-// Calculate a point on a cubic Bezier curve using the standard cubic Bezier formula
-//
-// @param p0,p1,p2,p3 Control points defining the curve
-// @param t Parameter value along curve [0,1]
-// @return Position vector of point on curve
-static Vector3 GetCubicBezierPoint(Vector3 p0, Vector3 p1, Vector3 p2, Vector3 p3, float t);
-
-// Calculate the normalized tangent (derivative) vector at point t along a cubic Bezier curve
-//
-// @param p0,p1,p2,p3 Control points defining the curve
-// @param t Parameter value along curve [0,1]
-// @return Normalized tangent vector (or zero vector if tangent magnitude is negligible)
-static Vector3 GetCubicBezierTangent(Vector3 p0, Vector3 p1, Vector3 p2, Vector3 p3, float t);
-
 //----------------------------------------------------------------------------------
 // Public Function Implementations
 //----------------------------------------------------------------------------------
@@ -46,9 +32,15 @@ static Vector3 GetCubicBezierTangent(Vector3 p0, Vector3 p1, Vector3 p2, Vector3
 // - Sets all enemies to inactive
 // - Initializes default properties (radius, color)
 // - Sets up transform (axis, angle) for rotation effects
+// - Seeds the enemy RNG and sets the default difficulty
 //----------------------------------------------------------------------------------
-void InitEnemies(EnemyManager *mgr)
+void InitEnemies(EnemyManager *mgr, uint64_t seed)
 {
+    SeedRng(&mgr->rng, seed);
+    mgr->pathSpeed = ENEMY_DT_DFRAME;
+    mgr->waveSpeedup = ENEMY_WAVE_DT_DFRAME;
+    mgr->nerf2Levels = WAVE_NERF2_LEVELS;
+    mgr->nerf1Levels = WAVE_NERF1_LEVELS;
     for (int i = 0; i < WAVE_SIZE; i++) {
         mgr->enemies[i].active = false;
         mgr->enemies[i].radius = ENEMY_DEFAULT_RADIUS;
@@ -56,9 +48,15 @@ void InitEnemies(EnemyManager *mgr)
         mgr->enemies[i].state = ENEMY_STATE_NORMAL;
         mgr->enemies[i].rotationAxis = (Vector3){0.0f, 1.0f, 0.0f};
         mgr->enemies[i].rotationAngle = 0.0f;
+        mgr->enemies[i].history.count = 0;
     }
 }
 
+float GetEnemyPathSpeed(const EnemyManager *mgr, int wave)
+{
+    return mgr->pathSpeed + wave * mgr->waveSpeedup;
+}
+
 //----------------------------------------------------------------------------------
 // SpawnWave - Implementation Notes:
 // - Enemies are all inactive before calling
@@ -75,25 +73,35 @@ void SpawnWave(EnemyManager *mgr, int wave)
         e->t = 0.0f;
         e->rotationAngle = 0.0f;
         e->rotationAxis = (Vector3){0.0f, 1.0f, 0.0f};
+        e->history.count = 0;
 
         float zOffset = i * ENEMY_Z_OFFSET;
         int side = (i % 2 == 0) ? 1 : -1;
-        int r0x = GetRandomValue(-ENEMY_XY_START_RANGE, ENEMY_XY_START_RANGE);
-        int r0y = GetRandomValue(-ENEMY_XY_START_RANGE, ENEMY_XY_START_RANGE);
+        Rng *rng = &mgr->rng;
+        int r0x = GetRngValue(rng, -ENEMY_XY_START_RANGE, ENEMY_XY_START_RANGE);
+        int r0y = GetRngValue(rng, -ENEMY_XY_START_RANGE, ENEMY_XY_START_RANGE);
+
+        // Separate statements: argument evaluation order is unspecified, and replays need a fixed order
+        float p1x = (float)GetRngValue(rng, -5, 5);
+        float p1y = (float)GetRngValue(rng, -5, 5);
+        float p2x = (float)GetRngValue(rng, -40, -20) * side;
+        float p2y = (float)GetRngValue(rng, 10, 20);
+        float p3x = (float)GetRngValue(rng, 20, 40) * side;
+        float p3y = (float)GetRngValue(rng, -20, -10);
 
         e->p0 = (Vector3){(float)r0x, (float)r0y, -100.0f - zOffset};
-        e->p1 = (Vector3){(float)GetRandomValue(-5, 5), (float)GetRandomValue(-5, 5), -50.0f - zOffset / 2.0f};
-        e->p2 = (Vector3){(float)GetRandomValue(-40, -20) * side, (float)GetRandomValue(10, 20), -25.0f};
-        e->p3 = (Vector3){(float)GetRandomValue(20, 40) * side, (float)GetRandomValue(-20, -10), 1.0f};
+        e->p1 = (Vector3){p1x, p1y, -50.0f - zOffset / 2.0f};
+        e->p2 = (Vector3){p2x, p2y, -25.0f};
+        e->p3 = (Vector3){p3x, p3y, 1.0f};
 
         // Apply wave-based nerfing of enemies
         // waves count from 1,2,3,...
-        if (wave <= WAVE_NERF2_LEVELS) {
+        if (wave <= mgr->nerf2Levels) {
             if (i >= WAVE_SIZE - 2) {
                 e->active = false;
             }
         }
-        else if (wave <= WAVE_NERF1_LEVELS) {
+        else if (wave <= mgr->nerf1Levels) {
             if (i >= WAVE_SIZE - 1) {
                 e->active = false;
             }
@@ -109,7 +117,7 @@ void SpawnWave(EnemyManager *mgr, int wave)
 // - Spawns new wave when all enemies inactive
 // - Updates lives when enemies pass player
 //----------------------------------------------------------------------------------
-void UpdateEnemies(EnemyManager *mgr, int *lives, int *wave)
+void UpdateEnemies(EnemyManager *mgr, int *lives, int *wave, float dt)
 {
     int activeEnemies = 0;
 
@@ -120,7 +128,7 @@ void UpdateEnemies(EnemyManager *mgr, int *lives, int *wave)
 
             switch (e->state) {
             case ENEMY_STATE_NORMAL: {
-                e->t += ENEMY_DT_DFRAME + (*wave * ENEMY_WAVE_DT_DFRAME);
+                e->t += GetEnemyPathSpeed(mgr, *wave);
                 e->position = GetCubicBezierPoint(e->p0, e->p1, e->p2, e->p3, e->t);
 
                 if (e->t >= 1.0f) {
@@ -131,7 +139,7 @@ void UpdateEnemies(EnemyManager *mgr, int *lives, int *wave)
             case ENEMY_STATE_REPELLED: {
                 e->repel_t += ENEMY_REPEL_DT_DFRAME;
                 e->position = Vector3Lerp(e->repel_start_pos, e->p0, e->repel_t);
-                e->rotationAngle += 360.0f * GetFrameTime();
+                e->rotationAngle += 360.0f * dt;
 
                 if (e->repel_t >= 1.0f) {
                     e->state = ENEMY_STATE_NORMAL;
@@ -150,29 +158,56 @@ void UpdateEnemies(EnemyManager *mgr, int *lives, int *wave)
 }
 
 //----------------------------------------------------------------------------------
-// DrawEnemies - Implementation Notes:
-// - Renders only active enemies
-// - Uses line-based 3D geometry for wireframe look
-// - Handles orientation based on movement direction
-// - Adds rotation effect during repel state
+// RecordEnemyHistory - Implementation Notes:
+// - Positions are stored against the simulation time of the tick that produced them
+// - Clearing inactive enemies keeps a respawn from interpolating across the jump
 //----------------------------------------------------------------------------------
-void DrawEnemies(EnemyManager *mgr)
+void RecordEnemyHistory(EnemyManager *mgr, double time)
 {
     for (int i = 0; i < WAVE_SIZE; i++) {
-        if (mgr->enemies[i].active) {
-            DrawEnemyShip(&mgr->enemies[i]);
+        Enemy *e = &mgr->enemies[i];
+        EnemyHistory *h = &e->history;
+        if (!e->active) {
+            h->count = 0;
+            continue;
         }
+        h->head = (h->count == 0) ? 0 : (h->head + 1) % ENEMY_HISTORY_SIZE;
+        h->position[h->head] = e->position;
+        h->time[h->head] = time;
+        if (h->count < ENEMY_HISTORY_SIZE) h->count++;
     }
 }
 
 //----------------------------------------------------------------------------------
-// Internal Function Implementations
+// GetEnemyPositionAt - Implementation Notes:
+// - Walks back from the newest record to the pair that brackets time
+// - Linear interpolation is fine at frame spacing; the curves are smooth
 //----------------------------------------------------------------------------------
+Vector3 GetEnemyPositionAt(const Enemy *enemy, double time)
+{
+    const EnemyHistory *h = &enemy->history;
+    if (h->count == 0 || time >= h->time[h->head]) return enemy->position;
+
+    int newer = h->head;
+    for (int n = 1; n < h->count; n++) {
+        int older = (newer + ENEMY_HISTORY_SIZE - 1) % ENEMY_HISTORY_SIZE;
+        if (time >= h->time[older]) {
+            double span = h->time[newer] - h->time[older];
+            float amount = (span > 0.0) ? (float)((time - h->time[older]) / span) : 1.0f;
+            return Vector3Lerp(h->position[older], h->position[newer], amount);
+        }
+        newer = older;
+    }
+    return h->position[newer];
+}
 
-static void DrawEnemyShip(const Enemy *enemy)
+//----------------------------------------------------------------------------------
+// GetEnemyForward - Implementation Notes:
+// - Repelled enemies face the point they are pushed back to; once there, the path start
+// - On the path they face along the tangent, or the origin where the tangent vanishes
+//----------------------------------------------------------------------------------
+Vector3 GetEnemyForward(const Enemy *enemy)
 {
-    float r = enemy->radius;
-    float fin_r = 1.0f; // Fin size relative to body radius
     Vector3 forward;
     if (enemy->state == ENEMY_STATE_REPELLED) {
         Vector3 to_p0 = Vector3Subtract(enemy->p0, enemy->position);
@@ -189,6 +224,66 @@ static void DrawEnemyShip(const Enemy *enemy)
             forward = Vector3Normalize(Vector3Negate(enemy->position));
         }
     }
+    return forward;
+}
+
+//----------------------------------------------------------------------------------
+// DrawEnemies - Implementation Notes:
+// - Renders only active enemies
+// - Uses line-based 3D geometry for wireframe look
+// - Handles orientation based on movement direction
+// - Adds rotation effect during repel state
+//----------------------------------------------------------------------------------
+void DrawEnemies(EnemyManager *mgr)
+{
+    for (int i = 0; i < WAVE_SIZE; i++) {
+        if (mgr->enemies[i].active) {
+            DrawEnemyShip(&mgr->enemies[i]);
+        }
+    }
+}
+
+Vector3 GetCubicBezierPoint(Vector3 p0, Vector3 p1, Vector3 p2, Vector3 p3, float t)
+{
+    Vector3 result;
+    float u = 1.0f - t;
+    float tt = t * t;
+    float uu = u * u;
+    float uuu = uu * u;
+    float ttt = tt * t;
+
+    result.x = uuu * p0.x + 3 * uu * t * p1.x + 3 * u * tt * p2.x + ttt * p3.x;
+    result.y = uuu * p0.y + 3 * uu * t * p1.y + 3 * u * tt * p2.y + ttt * p3.y;
+    result.z = uuu * p0.z + 3 * uu * t * p1.z + 3 * u * tt * p2.z + ttt * p3.z;
+
+    return result;
+}
+
+Vector3 GetCubicBezierTangent(Vector3 p0, Vector3 p1, Vector3 p2, Vector3 p3, float t)
+{
+    Vector3 result;
+    float u = 1.0f - t;
+    float tt = t * t;
+    float uu = u * u;
+
+    result.x = 3 * uu * (p1.x - p0.x) + 6 * u * t * (p2.x - p1.x) + 3 * tt * (p3.x - p2.x);
+    result.y = 3 * uu * (p1.y - p0.y) + 6 * u * t * (p2.y - p1.y) + 3 * tt * (p3.y - p2.y);
+    result.z = 3 * uu * (p1.z - p0.z) + 6 * u * t * (p2.z - p1.z) + 3 * tt * (p3.z - p2.z);
+
+    float len = Vector3Length(result);
+    if (len < 1e-6f) return (Vector3){0.0f, 0.0f, 0.0f};
+    return Vector3Scale(result, 1.0f / len);
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static void DrawEnemyShip(const Enemy *enemy)
+{
+    float r = enemy->radius;
+    float fin_r = 1.0f; // Fin size relative to body radius
+    Vector3 forward = GetEnemyForward(enemy);
 
     Vector3 up = {0.0f, 1.0f, 0.0f};
     Vector3 right = Vector3CrossProduct(forward, up);
@@ -244,35 +339,3 @@ static void DrawEnemyShip(const Enemy *enemy)
 
     rlPopMatrix();
 }
-
-static Vector3 GetCubicBezierPoint(Vector3 p0, Vector3 p1, Vector3 p2, Vector3 p3, float t)
-{
-    Vector3 result;
-    float u = 1.0f - t;
-    float tt = t * t;
-    float uu = u * u;
-    float uuu = uu * u;
-    float ttt = tt * t;
-
-    result.x = uuu * p0.x + 3 * uu * t * p1.x + 3 * u * tt * p2.x + ttt * p3.x;
-    result.y = uuu * p0.y + 3 * uu * t * p1.y + 3 * u * tt * p2.y + ttt * p3.y;
-    result.z = uuu * p0.z + 3 * uu * t * p1.z + 3 * u * tt * p2.z + ttt * p3.z;
-
-    return result;
-}
-
-static Vector3 GetCubicBezierTangent(Vector3 p0, Vector3 p1, Vector3 p2, Vector3 p3, float t)
-{
-    Vector3 result;
-    float u = 1.0f - t;
-    float tt = t * t;
-    float uu = u * u;
-
-    result.x = 3 * uu * (p1.x - p0.x) + 6 * u * t * (p2.x - p1.x) + 3 * tt * (p3.x - p2.x);
-    result.y = 3 * uu * (p1.y - p0.y) + 6 * u * t * (p2.y - p1.y) + 3 * tt * (p3.y - p2.y);
-    result.z = 3 * uu * (p1.z - p0.z) + 6 * u * t * (p2.z - p1.z) + 3 * tt * (p3.z - p2.z);
-
-    float len = Vector3Length(result);
-    if (len < 1e-6f) return (Vector3){0.0f, 0.0f, 0.0f};
-    return Vector3Scale(result, 1.0f / len);
-}
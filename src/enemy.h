@@ -12,6 +12,7 @@
 
 #include "config.h"
 #include "raylib.h"
+#include "rng.h"
 
 // Enemy state machine states
 typedef enum {
@@ -19,6 +20,14 @@ typedef enum {
     ENEMY_STATE_REPELLED // Being pushed back by force field
 } EnemyState;
 
+// Recent presented positions of an enemy, oldest overwritten first
+typedef struct EnemyHistory {
+    Vector3 position[ENEMY_HISTORY_SIZE];
+    double time[ENEMY_HISTORY_SIZE]; // Simulation time of each position
+    int head;                        // Index of the newest entry
+    int count;                       // Valid entries (0 after spawning)
+} EnemyHistory;
+
 // Enemy entity definition
 typedef struct Enemy {
     Vector3 position; // Current world position
@@ -34,30 +43,76 @@ typedef struct Enemy {
     float repel_t;           // Progress (0-1) of repel motion
     Vector3 rotationAxis;    // Axis for spin animation
     float rotationAngle;     // Current spin angle (degrees)
+
+    EnemyHistory history; // Where the enemy was shown on recent frames, for lag compensation
 } Enemy;
 
 // Opaque manager to avoid globals. Keep the array inside this struct so callers
 // can allocate or pass around manager instances instead of using a global.
 typedef struct EnemyManager {
     Enemy enemies[WAVE_SIZE];
+    Rng rng; // Source of all enemy path randomness; seeded by InitEnemies
+
+    // Difficulty: the config.h values unless changed after InitEnemies (see GameTuning)
+    float pathSpeed;   // Path progress per tick before wave scaling (ENEMY_DT_DFRAME)
+    float waveSpeedup; // Path progress per tick added per wave (ENEMY_WAVE_DT_DFRAME)
+    int nerf2Levels;   // Waves up to this one have two fewer enemies (WAVE_NERF2_LEVELS)
+    int nerf1Levels;   // Waves up to this one have one fewer enemy (WAVE_NERF1_LEVELS)
 } EnemyManager;
 
 //----------------------------------------------------------------------------------
 // Enemy Module Functions
 //----------------------------------------------------------------------------------
 
-// Initialize the enemy system, resetting all enemies to inactive state
-void InitEnemies(EnemyManager *mgr);
+// Initialize the enemy system, resetting all enemies to inactive state and the
+// difficulty to the config.h values
+//
+// @param seed Seed for enemy paths; the same seed and inputs give the same game
+void InitEnemies(EnemyManager *mgr, uint64_t seed);
+
+// Path progress an enemy in normal state makes per tick on a wave
+float GetEnemyPathSpeed(const EnemyManager *mgr, int wave);
 
 // Update all active enemies, handling movement and state changes
 //
 // @param lives Pointer to player's life count, decremented when enemies escape
 // @param wave Pointer to current wave number, incremented when wave is cleared
-void UpdateEnemies(EnemyManager *mgr, int *lives, int *wave);
+// @param dt Tick length in seconds (path speed is per tick; dt only drives the repel spin)
+void UpdateEnemies(EnemyManager *mgr, int *lives, int *wave, float dt);
 
 // Render all active enemies in 3D space
 void DrawEnemies(EnemyManager *mgr);
 
+// Record the current position of every active enemy at simulation time
+//
+// Call after each simulation tick with the time at the end of the tick (the sum of tick
+// lengths). Inactive enemies lose their history.
+void RecordEnemyHistory(EnemyManager *mgr, double time);
+
+// Estimate where an enemy was on screen at a past time
+//
+// Interpolates between the recorded positions around time. Times after the newest
+// record give the current position; times before the oldest give the oldest record.
+Vector3 GetEnemyPositionAt(const Enemy *enemy, double time);
+
+// Unit direction an active enemy faces when drawn (along its path, or back toward its
+// start while repelled)
+Vector3 GetEnemyForward(const Enemy *enemy);
+
+// Calculate a point on a cubic Bezier curve using the standard cubic Bezier formula
+//
+// @param p0,p1,p2,p3 Control points defining the curve
+// @param t Parameter value along curve [0,1]
+// @return Position vector of point on curve
+Vector3 GetCubicBezierPoint(Vector3 p0, Vector3 p1, Vector3 p2, Vector3 p3, float t);
+
+// Calculate the normalized tangent (derivative) vector at point t along a cubic Bezier curve
+//
+// @param p0,p1,p2,p3 Control points defining the curve
+// @param t Parameter value along curve [0,1]
+// @return Normalized tangent vector (or zero vector if tangent magnitude is negligible)
+Vector3 GetCubicBezierTangent(Vector3 p0, Vector3 p1, Vector3 p2, Vector3 p3, float t);
+
 // Spawn a new wave of enemies with curved attack paths
 //
 // @param wave Current wave number (affects enemy movement speed)
@@ -25,6 +25,7 @@ void InitForceField(ForceFieldManager *mgr)
     mgr->state = FF_STATE_READY;
     mgr->charge = 1.0f;
     mgr->timer = 0.0f;
+    mgr->timeout = FORCE_FIELD_TIMEOUT;
 }
 
 bool ActivateForceField(ForceFieldManager *mgr)
@@ -37,15 +38,15 @@ bool ActivateForceField(ForceFieldManager *mgr)
     return false; // activation failed (cooldown)
 }
 
-bool UpdateForceField(ForceFieldManager *mgr, struct EnemyManager *emgr)
+bool UpdateForceField(ForceFieldManager *mgr, struct EnemyManager *emgr, float dt)
 {
     bool anyHit = false;
 
     if (mgr->state == FF_STATE_ACTIVE) {
-        mgr->timer -= GetFrameTime();
+        mgr->timer -= dt;
         if (mgr->timer <= 0.0f) {
             mgr->state = FF_STATE_COOLDOWN;
-            mgr->timer = FORCE_FIELD_TIMEOUT;
+            mgr->timer = mgr->timeout;
             mgr->charge = 0.0f;
         }
 
@@ -61,8 +62,8 @@ bool UpdateForceField(ForceFieldManager *mgr, struct EnemyManager *emgr)
         }
     }
     else if (mgr->state == FF_STATE_COOLDOWN) {
-        mgr->timer -= GetFrameTime();
-        mgr->charge = 1.0f - (mgr->timer / FORCE_FIELD_TIMEOUT);
+        mgr->timer -= dt;
+        mgr->charge = 1.0f - (mgr->timer / mgr->timeout);
         if (mgr->timer <= 0.0f) {
             mgr->state = FF_STATE_READY;
             mgr->charge = 1.0f;
@@ -115,7 +116,7 @@ void DrawForceField2D(const ForceFieldManager *mgr)
 // - Shows "Charge: FULL" when ready
 // - Displays percentage (0-100%) when in cooldown state
 //----------------------------------------------------------------------------------
-void DrawForceFieldUI(ForceFieldManager *mgr)
+void DrawForceFieldUI(const ForceFieldManager *mgr)
 {
     if (mgr->state == FF_STATE_READY) {
         DrawText("Charge: FULL", 10, 40, 20, COLOR_FORCEFIELD_UI_READY);
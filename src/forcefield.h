@@ -25,8 +25,9 @@ typedef enum {
 // Encapsulated manager to avoid globals
 typedef struct ForceFieldManager {
     ForceFieldState state;
-    float charge; // Current charge level (0.0f to 1.0f)
-    float timer;  // Active or cooldown timer
+    float charge;  // Current charge level (0.0f to 1.0f)
+    float timer;   // Active or cooldown timer
+    float timeout; // Recharge time in seconds (FORCE_FIELD_TIMEOUT unless tuned, see GameTuning)
 } ForceFieldManager;
 
 //----------------------------------------------------------------------------------
@@ -45,12 +46,14 @@ bool ActivateForceField(ForceFieldManager *mgr);
 // Update force field state and handle enemy repulsion
 //
 // Returns true if any enemies were repelled this frame (caller may play hit sound).
-bool UpdateForceField(ForceFieldManager *mgr, struct EnemyManager *emgr);
+//
+// @param dt Tick length in seconds
+bool UpdateForceField(ForceFieldManager *mgr, struct EnemyManager *emgr, float dt);
 
 // Draw the 2D force field grid effect when active
 void DrawForceField2D(const ForceFieldManager *mgr);
 
 // Draw the force field UI showing charge status
-void DrawForceFieldUI(ForceFieldManager *mgr);
+void DrawForceFieldUI(const ForceFieldManager *mgr);
 
 #endif // FORCEFIELD_H
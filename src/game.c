@@ -0,0 +1,153 @@
+//================================================================================================
+//
+//   game.c - Gameplay simulation and per-tick input implementation
+//
+//   See game.h for module interface documentation.
+//
+//   Implementation notes:
+//   - StepGame is the gameplay part of the main loop; main plays sounds from its events
+//   - Quantising live input to the replay units before the simulation sees it is what
+//     makes replays exact: the live run and the replay compute from the same integers
+//   - GetScreenRay follows raylib's screen-to-world ray (unproject the near and far
+//     planes) with the screen size passed in
+//
+//================================================================================================
+
+#include "game.h"
+#include "config.h"
+#include "raymath.h"
+#include "rlgl.h"
+#include <math.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see game.h for documentation)
+//----------------------------------------------------------------------------------
+
+void InitGameSession(GameSession *session, Camera camera, uint64_t seed, int screenWidth, int screenHeight)
+{
+    GameTuning tuning = GetDefaultGameTuning();
+    InitTunedGameSession(session, camera, seed, screenWidth, screenHeight, &tuning);
+}
+
+//----------------------------------------------------------------------------------
+// InitTunedGameSession - Implementation Notes:
+// - The tuning is copied into the managers that use it before the first wave spawns,
+//   so a session stays pointer-free and its snapshots carry their own difficulty
+//----------------------------------------------------------------------------------
+void InitTunedGameSession(GameSession *session, Camera camera, uint64_t seed, int screenWidth, int screenHeight,
+                          const GameTuning *tuning)
+{
+    // memset rather than = {0} so padding is zero too and equal sessions hash equally (savestate.h)
+    memset(session, 0, sizeof(*session));
+    session->lives = 3;
+    session->wave = 1;
+    session->pointsForExtraLife = tuning->pointsForExtraLife;
+    session->virtualMouse = (Vector2){(float)screenWidth / 2, (float)screenHeight / 2};
+    session->camera = camera;
+    InitLasers(&session->lasers);
+    InitEnemies(&session->enemies, seed);
+    session->enemies.pathSpeed = tuning->enemyPathSpeed;
+    session->enemies.waveSpeedup = tuning->enemyWaveSpeedup;
+    session->enemies.nerf2Levels = tuning->waveNerf2Levels;
+    session->enemies.nerf1Levels = tuning->waveNerf1Levels;
+    // Spawn the initial set of enemies for the first wave
+    SpawnWave(&session->enemies, session->wave);
+    InitForceField(&session->forceField);
+    session->forceField.timeout = tuning->forceFieldTimeout;
+}
+
+GameTuning GetDefaultGameTuning(void)
+{
+    return (GameTuning){ENEMY_DT_DFRAME,   ENEMY_WAVE_DT_DFRAME,  WAVE_NERF2_LEVELS,
+                        WAVE_NERF1_LEVELS, POINTS_FOR_EXTRA_LIFE, FORCE_FIELD_TIMEOUT};
+}
+
+//----------------------------------------------------------------------------------
+// StepGame - Implementation Notes:
+// - Order matches the original main loop: aim, fire, force field, update, lives
+// - Game over is decided before the extra-life check, as it always was
+//----------------------------------------------------------------------------------
+int StepGame(GameSession *session, const GameInput *input)
+{
+    int events = 0;
+    float dt = GetGameInputDt(input);
+
+    session->virtualMouse = Vector2Add(session->virtualMouse, GetGameInputMouseDelta(input));
+    session->virtualMouse.x = Clamp(session->virtualMouse.x, 0, (float)input->screenWidth);
+    session->virtualMouse.y = Clamp(session->virtualMouse.y, 0, (float)input->screenHeight);
+
+    if (input->fire) {
+        Ray ray = GetScreenRay(session->virtualMouse, session->camera, input->screenWidth, input->screenHeight);
+        // Enemy history is on the simulation clock; the newest entry is the frame last presented
+        double clickTime = session->simTime - input->fireAgeMicros / 1e6;
+        int hits = FireLasers(&session->lasers, &session->enemies, ray, session->camera, clickTime);
+        session->score += hits;
+        events |= GAME_EVENT_SHOT;
+        if (hits > 0) events |= GAME_EVENT_HIT;
+    }
+
+    if (input->forceField) {
+        events |= ActivateForceField(&session->forceField) ? GAME_EVENT_FORCE_FIELD : GAME_EVENT_FORCE_FAIL;
+    }
+
+    UpdateLasers(&session->lasers, dt);
+    int curLives = session->lives;
+    UpdateEnemies(&session->enemies, &session->lives, &session->wave, dt);
+    if (UpdateForceField(&session->forceField, &session->enemies, dt)) events |= GAME_EVENT_FORCE_FIELD_HIT;
+    session->simTime += dt;
+    RecordEnemyHistory(&session->enemies, session->simTime);
+
+    if (curLives > session->lives) events |= GAME_EVENT_LOST_LIFE;
+    if (session->lives <= 0) events |= GAME_EVENT_GAME_OVER;
+
+    if (session->score - session->scoreAtLastLife >= session->pointsForExtraLife) {
+        session->lives++;
+        session->scoreAtLastLife += session->pointsForExtraLife;
+        events |= GAME_EVENT_EXTRA_LIFE;
+    }
+
+    session->tick++;
+    return events;
+}
+
+void BuildGameInput(GameInput *input, float frameTime, Vector2 mouseDelta, bool fire, double fireAge,
+                    bool forceField, int screenWidth, int screenHeight)
+{
+    float dt = Clamp(frameTime, 0.0f, GAME_MAX_DT);
+    fireAge = (fireAge < 0.0) ? 0.0 : (fireAge > LAG_COMP_MAX_AGE) ? LAG_COMP_MAX_AGE : fireAge;
+
+    input->dtMicros = (int)lroundf(dt * 1e6f);
+    input->mouseDx = (int)lroundf(mouseDelta.x * GAME_MOUSE_SUBPIXELS);
+    input->mouseDy = (int)lroundf(mouseDelta.y * GAME_MOUSE_SUBPIXELS);
+    input->fire = fire;
+    input->fireAgeMicros = fire ? (int)lround(fireAge * 1e6) : 0;
+    input->forceField = forceField;
+    input->screenWidth = screenWidth;
+    input->screenHeight = screenHeight;
+}
+
+float GetGameInputDt(const GameInput *input)
+{
+    return (float)input->dtMicros / 1e6f;
+}
+
+Vector2 GetGameInputMouseDelta(const GameInput *input)
+{
+    return (Vector2){(float)input->mouseDx / GAME_MOUSE_SUBPIXELS, (float)input->mouseDy / GAME_MOUSE_SUBPIXELS};
+}
+
+Ray GetScreenRay(Vector2 position, Camera camera, int width, int height)
+{
+    float x = (2.0f * position.x) / (float)width - 1.0f;
+    float y = 1.0f - (2.0f * position.y) / (float)height;
+
+    Matrix matView = MatrixLookAt(camera.position, camera.target, camera.up);
+    Matrix matProj = MatrixPerspective(camera.fovy * DEG2RAD, (double)width / (double)height, RL_CULL_DISTANCE_NEAR,
+                                       RL_CULL_DISTANCE_FAR);
+
+    Vector3 nearPoint = Vector3Unproject((Vector3){x, y, 0.0f}, matProj, matView);
+    Vector3 farPoint = Vector3Unproject((Vector3){x, y, 1.0f}, matProj, matView);
+
+    return (Ray){camera.position, Vector3Normalize(Vector3Subtract(farPoint, nearPoint))};
+}
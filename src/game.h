@@ -2,13 +2,23 @@
 //
 //   game.h - Game state management for Tailgunner
 //
-//   Defines the main game states and transitions between them.
+//   Defines the main game states and transitions between them, and the gameplay
+//   simulation: GameSession holds all gameplay state and StepGame advances it by one tick
+//   of GameInput. Everything the simulation reads from the player goes through GameInput,
+//   in quantised form, so a recorded session replays exactly. GameSession has no pointers,
+//   so a copy of it is a complete snapshot.
 //
 //================================================================================================
 
 #ifndef GAME_H
 #define GAME_H
 
+#include "config.h"
+#include "enemy.h"
+#include "forcefield.h"
+#include "laser.h"
+#include "raylib.h"
+
 // Game state machine states
 typedef enum GameState {
     STATE_START,        // Title screen, waiting for player to start
@@ -20,4 +30,105 @@ typedef enum GameState {
     STATE_HELP          // Help/instructions screen
 } GameState;
 
+// Player input and timing for one simulation tick, in the units stored in replays
+typedef struct GameInput {
+    int dtMicros;      // Tick length in microseconds (clamped to GAME_MAX_DT)
+    int mouseDx;       // Virtual mouse movement in 1/GAME_MOUSE_SUBPIXELS pixels
+    int mouseDy;
+    bool fire;         // Left click this tick
+    int fireAgeMicros; // How long before the last presented frame the click happened (lag compensation)
+    bool forceField;   // Space pressed or two-finger touch began this tick
+    int screenWidth;   // Screen size the mouse position and ray are evaluated against
+    int screenHeight;
+} GameInput;
+
+// Balancing parameters of a game; GetDefaultGameTuning gives the config.h values.
+// Live games and replays always use the defaults; other values are for offline tuning.
+typedef struct GameTuning {
+    float enemyPathSpeed;   // ENEMY_DT_DFRAME
+    float enemyWaveSpeedup; // ENEMY_WAVE_DT_DFRAME
+    int waveNerf2Levels;    // WAVE_NERF2_LEVELS
+    int waveNerf1Levels;    // WAVE_NERF1_LEVELS
+    int pointsForExtraLife; // POINTS_FOR_EXTRA_LIFE
+    float forceFieldTimeout; // FORCE_FIELD_TIMEOUT
+} GameTuning;
+
+// Complete gameplay state of one game
+typedef struct GameSession {
+    int tick;       // Ticks simulated since the game started
+    double simTime; // Sum of tick lengths (clock of the enemy position history)
+    int score;
+    int scoreAtLastLife;    // Score when the last extra life was awarded
+    int pointsForExtraLife; // Tuned POINTS_FOR_EXTRA_LIFE (the other tuning lives in the managers)
+    int lives;
+    int wave;
+    Vector2 virtualMouse; // Crosshair position in screen pixels
+    Camera camera;
+    LaserManager lasers;
+    EnemyManager enemies; // Includes the simulation RNG
+    ForceFieldManager forceField;
+} GameSession;
+
+// Things that happened during a StepGame call, for sounds and callers' bookkeeping
+typedef enum GameEvent {
+    GAME_EVENT_SHOT = 1 << 0,            // Lasers fired
+    GAME_EVENT_HIT = 1 << 1,             // A shot destroyed an enemy
+    GAME_EVENT_FORCE_FIELD = 1 << 2,     // Force field activated
+    GAME_EVENT_FORCE_FAIL = 1 << 3,      // Force field requested while charging
+    GAME_EVENT_FORCE_FIELD_HIT = 1 << 4, // Force field repelled enemies
+    GAME_EVENT_LOST_LIFE = 1 << 5,       // An enemy got past
+    GAME_EVENT_EXTRA_LIFE = 1 << 6,      // Extra life awarded
+    GAME_EVENT_GAME_OVER = 1 << 7        // No lives left
+} GameEvent;
+
+// Events below this bit each have a sound
+#define GAME_EVENT_SOUND_COUNT 7
+
+//----------------------------------------------------------------------------------
+// Game Simulation Functions
+//----------------------------------------------------------------------------------
+
+// Start a new game: reset score and lives, seed the RNG and spawn the first wave
+//
+// @param camera Fixed camera shots are fired from
+// @param screenWidth,screenHeight Screen size, used to center the crosshair
+void InitGameSession(GameSession *session, Camera camera, uint64_t seed, int screenWidth, int screenHeight);
+
+// Start a new game with other balancing parameters (see GameTuning)
+void InitTunedGameSession(GameSession *session, Camera camera, uint64_t seed, int screenWidth, int screenHeight,
+                          const GameTuning *tuning);
+
+// The config.h balancing parameters
+GameTuning GetDefaultGameTuning(void);
+
+// Advance the game by one tick of input
+//
+// Pure simulation: no sound, rendering or raylib state. The same session and input always
+// produce the same result.
+//
+// @return GameEvent flags for what happened this tick
+int StepGame(GameSession *session, const GameInput *input);
+
+//----------------------------------------------------------------------------------
+// Game Input Functions
+//----------------------------------------------------------------------------------
+
+// Fill input from live values, quantising them to replay precision
+//
+// @param fireAge Seconds between the click and the last present (clamped to 0..LAG_COMP_MAX_AGE)
+void BuildGameInput(GameInput *input, float frameTime, Vector2 mouseDelta, bool fire, double fireAge,
+                    bool forceField, int screenWidth, int screenHeight);
+
+// Tick length in seconds
+float GetGameInputDt(const GameInput *input);
+
+// Virtual mouse movement in pixels
+Vector2 GetGameInputMouseDelta(const GameInput *input);
+
+// Ray from the camera through a screen position, for a screen of the given size
+//
+// Same result as raylib's GetMouseRay when width/height match the window, but independent of
+// the window, so replays hit-test identically in any window size. Perspective cameras only.
+Ray GetScreenRay(Vector2 position, Camera camera, int width, int height);
+
 #endif // GAME_H
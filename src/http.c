@@ -0,0 +1,488 @@
+//================================================================================================
+//
+//   http.c - Asynchronous HTTP request implementation
+//
+//   See http.h for module interface documentation.
+//
+//   Implementation notes:
+//   - Desktop: a thread per request runs a blocking libcurl transfer. The worker only
+//     touches its own HttpRequest and hands it back by setting done under the request's
+//     lock, so the game thread sees the finished fields once it sees done
+//   - Web: emscripten_fetch callbacks run on the game thread between frames; the fetch
+//     is kept open until ReleaseHttpRequest so its data is the body without a copy
+//   - Response headers are scanned for ETag, Last-Modified and Retry-After only; they are
+//     reset at each status line so those of a redirect or interim response are not kept
+//   - Desktop receive buffers come from a small pool that only the game thread touches
+//     (start and release); the worker may grow the request's buffer, doubling it, and it
+//     goes back to the pool at its grown size. A Content-Length header sizes the buffer
+//     up front, or aborts the transfer if it is over the limit
+//   - Deadlines are libcurl's connect and total timeouts on desktop and the XHR timeout on
+//     the web. Cancelling sets a flag the libcurl progress callback checks (a blocked
+//     worker can't be interrupted any other way), while a fetch is closed at once
+//   - Request IDs come from one counter bumped on the game thread when a request starts
+//   - Closing a request joins its worker rather than polling, so shutdown never leaves a
+//     thread writing to a request whose memory is gone
+//
+//================================================================================================
+
+#include "http.h"
+#include "config.h"
+#include <limits.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h> // For strncasecmp
+
+#if defined(PLATFORM_WEB)
+#include <emscripten/emscripten.h> // For emscripten_get_now
+#include <emscripten/fetch.h>
+#else
+#include <curl/curl.h>
+
+// Finished receive buffers kept for reuse (game thread only)
+typedef struct HttpBufferPool {
+    char *buffers[HTTP_BUFFER_POOL_SIZE];
+    size_t capacities[HTTP_BUFFER_POOL_SIZE];
+    int count;
+} HttpBufferPool;
+
+static HttpBufferPool s_bufferPool = {0};
+#endif
+
+static unsigned int s_lastRequestId = 0; // ID of the last request started (game thread only)
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// Prepare req for a new request to url
+static void ResetHttpRequest(HttpRequest *req, bool post, const char *url, const HttpValidators *conditions);
+
+// Start the request prepared by ResetHttpRequest
+static bool StartHttpRequest(HttpRequest *req);
+
+#if defined(PLATFORM_WEB)
+// OnFetchDone - emscripten_fetch success and error callback; marks the request complete
+static void OnFetchDone(emscripten_fetch_t *fetch);
+#else
+// HttpWorker - Thread body: performs the transfer, then sets done
+static void *HttpWorker(void *arg);
+
+// Join req's finished (or finishing) worker and hand its buffer over as the body
+static void CollectHttpWorker(HttpRequest *req);
+
+// Give req a receive buffer from the pool, or a new one
+static void AcquireHttpBuffer(HttpRequest *req);
+
+// Put req's receive buffer back in the pool (or free it if the pool is full)
+static void ReturnHttpBuffer(HttpRequest *req);
+
+// Grow req's buffer to hold at least needed bytes (doubling, at most one past the limit)
+//
+// @return false if out of memory (the buffer is unchanged)
+static bool GrowHttpBuffer(HttpRequest *req, size_t needed);
+
+// WriteMemoryCallback - libcurl write callback that appends incoming data to the request's buffer
+// @return number of bytes handled (size * nmemb) on success, 0 on failure
+static size_t WriteMemoryCallback(const void *contents, size_t size, size_t nmemb, void *userp);
+
+// ProgressCallback - libcurl transfer progress callback; aborts the transfer once cancelled
+// @return nonzero to abort
+static int ProgressCallback(void *userp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow);
+
+// HeaderCallback - libcurl header callback that collects the response validators and Retry-After
+static size_t HeaderCallback(const char *line, size_t size, size_t nmemb, void *userp);
+
+// Copy a header's value into out if line is that header ("Name: value\r\n")
+//
+// @return true if line is the named header
+static bool ReadHeaderValue(const char *line, size_t length, const char *name, char *out, size_t outSize);
+#endif
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see http.h for documentation)
+//----------------------------------------------------------------------------------
+
+void InitHttp(void)
+{
+#if !defined(PLATFORM_WEB)
+    // Not thread-safe, so done once up front rather than per request; kept for the process lifetime
+    curl_global_init(CURL_GLOBAL_DEFAULT);
+#endif
+}
+
+void CloseHttp(void)
+{
+#if !defined(PLATFORM_WEB)
+    for (int i = 0; i < s_bufferPool.count; i++) free(s_bufferPool.buffers[i]);
+    s_bufferPool.count = 0;
+    curl_global_cleanup();
+#endif
+}
+
+bool StartHttpGet(HttpRequest *req, const char *url, const HttpValidators *conditions)
+{
+    if (req->inFlight || req->body != NULL) return false;
+    ResetHttpRequest(req, false, url, conditions);
+    return StartHttpRequest(req);
+}
+
+bool StartHttpPost(HttpRequest *req, const char *url)
+{
+    if (req->inFlight || req->body != NULL) return false;
+    ResetHttpRequest(req, true, url, NULL);
+    return StartHttpRequest(req);
+}
+
+bool PollHttpRequest(HttpRequest *req)
+{
+    if (!req->inFlight) return false;
+
+#if defined(PLATFORM_WEB)
+    if (!req->done) return false;
+#else
+    pthread_mutex_lock(&req->lock);
+    bool done = req->done;
+    pthread_mutex_unlock(&req->lock);
+    if (!done) return false;
+    CollectHttpWorker(req);
+#endif
+    req->inFlight = false;
+    if (req->cancelled) req->ok = false; // Also if the response won the race with the cancel
+    if (req->body == NULL) req->body = ""; // Keep body usable for empty and failed responses
+    return true;
+}
+
+void CancelHttpRequest(HttpRequest *req)
+{
+    if (!req->inFlight) return;
+#if defined(PLATFORM_WEB)
+    req->cancelled = true;
+    if (!req->done) {
+        // Closing an unfinished fetch aborts it and calls OnFetchDone, which then ignores it
+        emscripten_fetch_t *fetch = req->fetch;
+        req->fetch = NULL;
+        req->done = true;
+        if (fetch != NULL) emscripten_fetch_close(fetch);
+    }
+#else
+    pthread_mutex_lock(&req->lock);
+    req->cancelled = true;
+    pthread_mutex_unlock(&req->lock);
+#endif
+    printf("Request %u cancelled\n", req->id);
+}
+
+void ReleaseHttpRequest(HttpRequest *req)
+{
+    if (req->inFlight) return;
+#if defined(PLATFORM_WEB)
+    if (req->fetch != NULL) emscripten_fetch_close(req->fetch);
+    req->fetch = NULL;
+#else
+    ReturnHttpBuffer(req);
+#endif
+    req->body = NULL;
+    req->size = 0;
+}
+
+bool IsHttpStatusTransient(long status)
+{
+    return status == 408 || status == 429 || (status >= 500 && status <= 599);
+}
+
+void CloseHttpRequest(HttpRequest *req)
+{
+    CancelHttpRequest(req);
+    if (req->inFlight) {
+#if defined(PLATFORM_WEB)
+        PollHttpRequest(req); // A cancelled fetch is done at once
+#else
+        CollectHttpWorker(req); // The worker stops at its next progress check
+        req->inFlight = false;
+        req->ok = false;
+#endif
+    }
+    ReleaseHttpRequest(req);
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static void ResetHttpRequest(HttpRequest *req, bool post, const char *url, const HttpValidators *conditions)
+{
+    if (++s_lastRequestId == 0) s_lastRequestId = 1; // 0 never names a request
+    req->id = s_lastRequestId;
+    req->ok = false;
+    req->tooLarge = false;
+    req->timedOut = false;
+    req->cancelled = false;
+    req->status = 0;
+    req->retryAfter = -1;
+    req->post = post;
+    snprintf(req->url, sizeof(req->url), "%s", url);
+    if (conditions != NULL)
+        req->conditions = *conditions;
+    else
+        memset(&req->conditions, 0, sizeof(req->conditions));
+    memset(&req->validators, 0, sizeof(req->validators));
+    req->body = NULL;
+    req->size = 0;
+    req->done = false;
+#if defined(PLATFORM_WEB)
+    req->fetch = NULL;
+#else
+    req->buffer = NULL;
+    req->capacity = 0;
+#endif
+}
+
+static bool StartHttpRequest(HttpRequest *req)
+{
+#if defined(PLATFORM_WEB)
+    // Conditions are not sent: the browser's HTTP cache revalidates (see http.h)
+    emscripten_fetch_attr_t attr;
+    emscripten_fetch_attr_init(&attr);
+    strcpy(attr.requestMethod, req->post ? "POST" : "GET");
+    attr.attributes = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY;
+    attr.userData = req;
+    attr.onsuccess = OnFetchDone;
+    attr.onerror = OnFetchDone;
+    attr.timeoutMSecs = HTTP_REQUEST_TIMEOUT_MS;
+    req->startTime = emscripten_get_now();
+    req->inFlight = true;
+    req->fetch = emscripten_fetch(&attr, req->url);
+    if (req->fetch == NULL) {
+        req->inFlight = false;
+        return false;
+    }
+#else
+    AcquireHttpBuffer(req);
+    pthread_mutex_init(&req->lock, NULL);
+    req->inFlight = true;
+    if (pthread_create(&req->thread, NULL, HttpWorker, req) != 0) {
+        pthread_mutex_destroy(&req->lock);
+        ReturnHttpBuffer(req);
+        req->inFlight = false;
+        return false;
+    }
+#endif
+    return true;
+}
+
+#if defined(PLATFORM_WEB)
+static void OnFetchDone(emscripten_fetch_t *fetch)
+{
+    HttpRequest *req = (HttpRequest *)fetch->userData;
+    if (req->cancelled) return; // From emscripten_fetch_close in CancelHttpRequest; fetch is being freed
+    req->fetch = fetch;
+    req->status = fetch->status;
+    req->ok = fetch->status != 0; // 0: network error, CORS rejection or timeout
+    if (!req->ok && emscripten_get_now() - req->startTime >= HTTP_REQUEST_TIMEOUT_MS) {
+        fprintf(stderr, "Request %u to %s timed out\n", req->id, req->url);
+        req->timedOut = true;
+    }
+    req->body = fetch->data;
+    req->size = (size_t)fetch->numBytes;
+    if (req->size > HTTP_MAX_RESPONSE_SIZE) {
+        // The fetch API has no way to stop earlier; at least don't hand the body on
+        fprintf(stderr, "Response from %s exceeds %d bytes, ignoring it\n", req->url, HTTP_MAX_RESPONSE_SIZE);
+        req->ok = false;
+        req->tooLarge = true;
+        req->body = NULL;
+        req->size = 0;
+    }
+    req->done = true;
+}
+#else
+static void *HttpWorker(void *arg)
+{
+    HttpRequest *req = (HttpRequest *)arg;
+    size_t size = 0;
+    bool ok = false;
+    bool timedOut = false;
+    long status = 0;
+
+    CURL *curl = curl_easy_init();
+    if (curl != NULL) {
+        struct curl_slist *headers = NULL;
+        char line[32 + HTTP_VALIDATOR_LENGTH];
+        if (req->conditions.etag[0] != '\0') {
+            snprintf(line, sizeof(line), "If-None-Match: %s", req->conditions.etag);
+            headers = curl_slist_append(headers, line);
+        }
+        if (req->conditions.lastModified[0] != '\0') {
+            snprintf(line, sizeof(line), "If-Modified-Since: %s", req->conditions.lastModified);
+            headers = curl_slist_append(headers, line);
+        }
+
+        // The callbacks fill req->buffer/capacity/size; they are only published with done below
+        curl_easy_setopt(curl, CURLOPT_URL, req->url);
+        if (req->post) curl_easy_setopt(curl, CURLOPT_POSTFIELDS, "");
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)req);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, (void *)req);
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L); // No SIGALRM-based DNS timeouts off the main thread
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, (long)HTTP_CONNECT_TIMEOUT_MS);
+        curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, (long)HTTP_REQUEST_TIMEOUT_MS);
+        curl_easy_setopt(curl, CURLOPT_XFERINFOFUNCTION, ProgressCallback);
+        curl_easy_setopt(curl, CURLOPT_XFERINFODATA, (void *)req);
+        curl_easy_setopt(curl, CURLOPT_NOPROGRESS, 0L);
+
+        CURLcode result = curl_easy_perform(curl);
+        ok = (result == CURLE_OK);
+        timedOut = (result == CURLE_OPERATION_TIMEDOUT);
+        if (ok) curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &status);
+        curl_slist_free_all(headers);
+        curl_easy_cleanup(curl);
+        if (ok) size = req->size;
+    }
+    if (req->tooLarge) {
+        fprintf(stderr, "Response from %s exceeds %d bytes, abandoned\n", req->url, HTTP_MAX_RESPONSE_SIZE);
+    }
+    if (timedOut) fprintf(stderr, "Request %u to %s timed out\n", req->id, req->url);
+
+    pthread_mutex_lock(&req->lock);
+    req->size = size; // The buffer itself stays with the request for the pool
+    req->ok = ok;
+    req->timedOut = timedOut;
+    req->status = status;
+    req->done = true;
+    pthread_mutex_unlock(&req->lock);
+    return NULL;
+}
+
+static void CollectHttpWorker(HttpRequest *req)
+{
+    pthread_join(req->thread, NULL);
+    pthread_mutex_destroy(&req->lock);
+    req->body = req->buffer;
+}
+
+static void AcquireHttpBuffer(HttpRequest *req)
+{
+    if (s_bufferPool.count > 0) {
+        s_bufferPool.count--;
+        req->buffer = s_bufferPool.buffers[s_bufferPool.count];
+        req->capacity = s_bufferPool.capacities[s_bufferPool.count];
+    }
+    else {
+        req->buffer = malloc(HTTP_BUFFER_INITIAL_SIZE);
+        req->capacity = (req->buffer != NULL) ? HTTP_BUFFER_INITIAL_SIZE : 0;
+    }
+}
+
+static void ReturnHttpBuffer(HttpRequest *req)
+{
+    if (req->buffer != NULL && s_bufferPool.count < HTTP_BUFFER_POOL_SIZE) {
+        s_bufferPool.buffers[s_bufferPool.count] = req->buffer;
+        s_bufferPool.capacities[s_bufferPool.count] = req->capacity;
+        s_bufferPool.count++;
+    }
+    else {
+        free(req->buffer);
+    }
+    req->buffer = NULL;
+    req->capacity = 0;
+}
+
+static bool GrowHttpBuffer(HttpRequest *req, size_t needed)
+{
+    size_t capacity = (req->capacity > 0) ? req->capacity : HTTP_BUFFER_INITIAL_SIZE;
+    while (capacity < needed) capacity *= 2;
+    if (capacity > (size_t)HTTP_MAX_RESPONSE_SIZE + 1) capacity = (size_t)HTTP_MAX_RESPONSE_SIZE + 1;
+
+    char *grown = realloc(req->buffer, capacity);
+    if (grown == NULL) {
+        fprintf(stderr, "Out of memory receiving %s\n", req->url);
+        return false;
+    }
+    req->buffer = grown;
+    req->capacity = capacity;
+    return true;
+}
+
+static size_t WriteMemoryCallback(const void *contents, size_t size, size_t nmemb, void *userp)
+{
+    size_t realsize = size * nmemb;
+    HttpRequest *req = (HttpRequest *)userp;
+
+    // One byte more than the body keeps it NUL-terminated
+    size_t needed = req->size + realsize + 1;
+    if (needed > (size_t)HTTP_MAX_RESPONSE_SIZE + 1) {
+        req->tooLarge = true;
+        return 0; // Aborts the transfer
+    }
+    if (needed > req->capacity && !GrowHttpBuffer(req, needed)) return 0;
+
+    memcpy(&(req->buffer[req->size]), contents, realsize);
+    req->size += realsize;
+    req->buffer[req->size] = 0;
+
+    return realsize;
+}
+
+static int ProgressCallback(void *userp, curl_off_t dltotal, curl_off_t dlnow, curl_off_t ultotal, curl_off_t ulnow)
+{
+    (void)dltotal;
+    (void)dlnow;
+    (void)ultotal;
+    (void)ulnow;
+    HttpRequest *req = (HttpRequest *)userp;
+    pthread_mutex_lock(&req->lock);
+    bool cancelled = req->cancelled;
+    pthread_mutex_unlock(&req->lock);
+    return cancelled ? 1 : 0;
+}
+
+static size_t HeaderCallback(const char *line, size_t size, size_t nmemb, void *userp)
+{
+    size_t length = size * nmemb;
+    HttpRequest *req = (HttpRequest *)userp;
+
+    char value[32];
+    if (length >= 5 && strncmp(line, "HTTP/", 5) == 0) {
+        memset(&req->validators, 0, sizeof(req->validators)); // A new response starts
+        req->retryAfter = -1;
+    }
+    else if (ReadHeaderValue(line, length, "Content-Length", value, sizeof(value))) {
+        unsigned long long bodySize = strtoull(value, NULL, 10);
+        if (bodySize > HTTP_MAX_RESPONSE_SIZE) {
+            req->tooLarge = true;
+            return 0; // Aborts the transfer before any of the body is read
+        }
+        if (bodySize + 1 > req->capacity && !GrowHttpBuffer(req, (size_t)bodySize + 1)) return 0;
+    }
+    else if (ReadHeaderValue(line, length, "Retry-After", value, sizeof(value))) {
+        char *end;
+        long seconds = strtol(value, &end, 10);
+        if (end != value && *end == '\0' && seconds >= 0 && seconds <= INT_MAX) req->retryAfter = (int)seconds;
+    }
+    else if (!ReadHeaderValue(line, length, "ETag", req->validators.etag, sizeof(req->validators.etag))) {
+        ReadHeaderValue(line, length, "Last-Modified", req->validators.lastModified,
+                        sizeof(req->validators.lastModified));
+    }
+    return length;
+}
+
+static bool ReadHeaderValue(const char *line, size_t length, const char *name, char *out, size_t outSize)
+{
+    size_t nameLength = strlen(name);
+    if (length <= nameLength || line[nameLength] != ':' || strncasecmp(line, name, nameLength) != 0) return false;
+
+    const char *value = line + nameLength + 1;
+    const char *end = line + length;
+    while (value < end && (*value == ' ' || *value == '\t')) value++;
+    while (end > value && (end[-1] == '\r' || end[-1] == '\n' || end[-1] == ' ')) end--;
+
+    size_t valueLength = (size_t)(end - value);
+    if (valueLength < outSize) {
+        memcpy(out, value, valueLength);
+        out[valueLength] = '\0';
+    }
+    return true;
+}
+#endif
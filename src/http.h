@@ -0,0 +1,136 @@
+//================================================================================================
+//
+//   http.h - Asynchronous HTTP requests for Tailgunner
+//
+//   Runs one request in the background and lets the game loop poll for the result, so
+//   the frame never waits on the network. The desktop build performs each request with
+//   libcurl on its own thread; the web build uses emscripten_fetch.
+//
+//   Desktop requests may be conditional (If-None-Match / If-Modified-Since); the response's
+//   ETag and Last-Modified validators are returned for the next revalidation. The web build
+//   leaves revalidation to the browser's HTTP cache: explicit conditional headers would make
+//   every cross-origin request wait for a CORS preflight. There an unchanged resource comes
+//   back as the same 200 body rather than a 304.
+//
+//   Bodies larger than HTTP_MAX_RESPONSE_SIZE (config.h) are not kept; the request fails
+//   with tooLarge set. On desktop the transfer is aborted as soon as the size is known.
+//
+//   Every request has a deadline: one that has not completed within HTTP_REQUEST_TIMEOUT_MS
+//   (on desktop also one that cannot connect within HTTP_CONNECT_TIMEOUT_MS) fails with
+//   timedOut set, so a dead or stalled server can't hold a request forever. An in-flight
+//   request can also be cancelled, and still completes through PollHttpRequest.
+//
+//================================================================================================
+
+#ifndef HTTP_H
+#define HTTP_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+#if !defined(PLATFORM_WEB)
+#include <pthread.h>
+#endif
+
+// Longest request URL, including the terminator
+#define HTTP_URL_LENGTH 256
+// Longest ETag or Last-Modified value kept, including the terminator (longer ones are ignored)
+#define HTTP_VALIDATOR_LENGTH 96
+// Desktop receive buffers: first size (doubled as a body grows), and how many finished
+// buffers are kept for reuse by later requests
+#define HTTP_BUFFER_INITIAL_SIZE (4 * 1024)
+#define HTTP_BUFFER_POOL_SIZE 4
+
+// Response validators, as sent back in a conditional request
+typedef struct HttpValidators {
+    char etag[HTTP_VALIDATOR_LENGTH];         // ETag header, or ""
+    char lastModified[HTTP_VALIDATOR_LENGTH]; // Last-Modified header, or ""
+} HttpValidators;
+
+// One request and, once complete, its response
+//
+// Must stay at the same address while in flight. Only the game thread calls the functions
+// below; the result fields are valid after PollHttpRequest returns true.
+typedef struct HttpRequest {
+    unsigned int id; // Nonzero number of the request last started with this struct, for logs
+    bool inFlight;   // Started and not yet collected by PollHttpRequest
+    bool ok;         // A response arrived (of any status); false on a transport failure
+    bool tooLarge;   // The body exceeded HTTP_MAX_RESPONSE_SIZE (ok is then false)
+    bool timedOut;   // The deadline passed first (ok is then false)
+    bool cancelled;  // CancelHttpRequest was called while in flight (ok is then false)
+    long status;    // HTTP status code, 0 without a response
+    int retryAfter; // Retry-After header in seconds, or -1 (desktop only; date values are ignored)
+    bool post;      // POST with an empty body rather than GET
+    char url[HTTP_URL_LENGTH];
+    HttpValidators conditions; // Validators sent with the request
+    HttpValidators validators; // Validators of the response
+    const char *body;          // Response body (not NUL-terminated), owned by the request
+    size_t size;               // Body length in bytes
+
+#if defined(PLATFORM_WEB)
+    struct emscripten_fetch_t *fetch; // Owns body; the fetch in progress while in flight
+    double startTime;                 // emscripten_get_now() at the start, to recognise a timeout
+    bool done;
+#else
+    char *buffer;    // Owns body; taken from the buffer pool when the request starts
+    size_t capacity; // Allocated size of buffer
+    pthread_t thread;
+    pthread_mutex_t lock;
+    bool done; // Set by the worker thread under lock (as is cancelled by the game thread)
+#endif
+} HttpRequest;
+
+//----------------------------------------------------------------------------------
+// HTTP Module Functions
+//----------------------------------------------------------------------------------
+
+// One-time setup before the first request (libcurl global state on desktop)
+void InitHttp(void);
+
+// Free the pooled receive buffers and libcurl global state at shutdown
+//
+// Every request must have been closed with CloseHttpRequest (or collected and released) first.
+void CloseHttp(void);
+
+// Start a GET in the background
+//
+// @param conditions Validators to revalidate against, or NULL for an unconditional GET;
+//                   a 304 status then means the caller's copy is still current (desktop only)
+// @return false if the request could not be started (req is left idle)
+bool StartHttpGet(HttpRequest *req, const char *url, const HttpValidators *conditions);
+
+// Start a POST with an empty body (parameters in the URL) in the background
+//
+// @return false if the request could not be started (req is left idle)
+bool StartHttpPost(HttpRequest *req, const char *url);
+
+// Check whether a started request has finished
+//
+// @return true once, when the request completes; the result fields are then valid until
+//         ReleaseHttpRequest. false while still in flight or if nothing was started.
+bool PollHttpRequest(HttpRequest *req);
+
+// Abort a request in flight; nothing happens if req is idle or already collected
+//
+// PollHttpRequest still has to collect it, with cancelled set. On the web that is the next
+// poll; on desktop the transfer stops at its next progress check, within about a second.
+void CancelHttpRequest(HttpRequest *req);
+
+// Give back a collected response's body so the request can be started again
+//
+// On desktop the receive buffer returns to the pool for the next request.
+void ReleaseHttpRequest(HttpRequest *req);
+
+// Returns true if status asks the client to try again later (408, 429 or any 5xx)
+//
+// Other 4xx statuses are the server's final answer to the request.
+bool IsHttpStatusTransient(long status);
+
+// Cancel a request in flight, wait for it to stop and release it, whatever its state
+//
+// For shutdown, before req's memory goes away. On desktop this blocks until the worker
+// thread has exited, which a transfer stuck connecting may take up to
+// HTTP_CONNECT_TIMEOUT_MS to do.
+void CloseHttpRequest(HttpRequest *req);
+
+#endif // HTTP_H
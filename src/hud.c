@@ -0,0 +1,103 @@
+//================================================================================================
+//
+//   hud.c - Retained-mode gameplay HUD implementation
+//
+//   See hud.h for module interface documentation.
+//
+//   Implementation notes:
+//   - The force field charge is tracked as an integer percentage bucket, so the layer is
+//     redrawn at most ~10 times a second during cooldown instead of every frame
+//   - The texture is only the HUD strip, not the full screen, to keep fill cost low
+//   - Render textures are stored upside down, hence the negative source height on composite
+//
+//================================================================================================
+
+#include "hud.h"
+#include "forcefield.h"
+#include "textcache.h"
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// Charge value shown by DrawForceFieldUI: percentage, or -1 when it reads FULL
+static int GetChargeBucket(const ForceFieldManager *ffmgr);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see hud.h for documentation)
+//----------------------------------------------------------------------------------
+
+void InitHud(HudLayer *hud)
+{
+    *hud = (HudLayer){0};
+    hud->dirty = true;
+}
+
+void UnloadHud(HudLayer *hud)
+{
+    if (hud->target.id != 0) UnloadRenderTexture(hud->target);
+    hud->target = (RenderTexture2D){0};
+    hud->width = 0;
+    hud->dirty = true;
+}
+
+//----------------------------------------------------------------------------------
+// UpdateHud - Implementation Notes:
+// - Recreates the texture when the screen width changes (marks dirty)
+// - Re-renders only when score, lives, wave or charge bucket differ from last render
+//----------------------------------------------------------------------------------
+void UpdateHud(HudLayer *hud, int score, int lives, int wave, const ForceFieldManager *ffmgr)
+{
+    int width = GetScreenWidth();
+    if (hud->target.id == 0 || hud->width != width) {
+        if (hud->target.id != 0) UnloadRenderTexture(hud->target);
+        hud->target = LoadRenderTexture(width, HUD_LAYER_HEIGHT);
+        hud->width = width;
+        hud->dirty = true;
+    }
+
+    int chargeBucket = GetChargeBucket(ffmgr);
+    if (score != hud->score || lives != hud->lives || wave != hud->wave || chargeBucket != hud->chargeBucket) {
+        hud->dirty = true;
+    }
+    if (!hud->dirty) return;
+
+    hud->score = score;
+    hud->lives = lives;
+    hud->wave = wave;
+    hud->chargeBucket = chargeBucket;
+
+    BeginTextureMode(hud->target);
+    ClearBackground(BLANK);
+    DrawHudImmediate(hud, score, lives, wave, ffmgr);
+    EndTextureMode();
+
+    hud->dirty = false;
+}
+
+void DrawHud(const HudLayer *hud)
+{
+    if (hud->target.id == 0) return;
+    Rectangle source = {0.0f, 0.0f, (float)hud->target.texture.width, -(float)hud->target.texture.height};
+    DrawTextureRec(hud->target.texture, source, (Vector2){0.0f, 0.0f}, WHITE);
+}
+
+void DrawHudImmediate(HudLayer *hud, int score, int lives, int wave, const ForceFieldManager *ffmgr)
+{
+    DrawTextCached(FormatCounter(&hud->scoreText, "Score: %i", score), 10, 10, 20, COLOR_TEXT_SCORE);
+    DrawTextCached(FormatCounter(&hud->livesText, "Lives: %i", lives), GetScreenWidth() - 100, 10, 20,
+                   COLOR_TEXT_LIVES);
+    DrawTextCached(FormatCounter(&hud->waveText, "Wave: %i", wave), GetScreenWidth() / 2 - 20, 10, 20,
+                   COLOR_TEXT_WAVE);
+    DrawForceFieldUI(ffmgr);
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static int GetChargeBucket(const ForceFieldManager *ffmgr)
+{
+    if (ffmgr->state == FF_STATE_READY) return -1;
+    return (int)(ffmgr->charge * 100);
+}
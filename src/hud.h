@@ -0,0 +1,57 @@
+//================================================================================================
+//
+//   hud.h - Retained-mode gameplay HUD for Tailgunner
+//
+//   Renders score, lives, wave and force field charge into an offscreen texture that
+//   is only redrawn when one of those values (or the window width) changes. Each frame
+//   the texture is composited with a single textured quad.
+//
+//================================================================================================
+
+#ifndef HUD_H
+#define HUD_H
+
+#include "config.h"
+#include "forcefield.h"
+#include "raylib.h"
+#include "textcache.h"
+
+// Height in pixels of the HUD strip at the top of the screen
+#define HUD_LAYER_HEIGHT 64
+
+// Retained HUD layer and the values it was last rendered with
+typedef struct HudLayer {
+    RenderTexture2D target; // Offscreen HUD strip (screen width x HUD_LAYER_HEIGHT)
+    bool dirty;             // Needs re-rendering before the next composite
+    int score;
+    int lives;
+    int wave;
+    int chargeBucket; // Charge percentage shown, or -1 when the field reads FULL
+    int width;        // Screen width the texture was created for
+    TextCounter scoreText;
+    TextCounter livesText;
+    TextCounter waveText;
+} HudLayer;
+
+//----------------------------------------------------------------------------------
+// HUD Module Functions
+//----------------------------------------------------------------------------------
+
+// Initialize the HUD layer (texture is created on first update)
+void InitHud(HudLayer *hud);
+
+// Release the HUD render texture
+void UnloadHud(HudLayer *hud);
+
+// Compare HUD values against the last rendered ones and re-render the layer if any changed
+//
+// Must be called outside BeginMode3D; typically just before BeginDrawing.
+void UpdateHud(HudLayer *hud, int score, int lives, int wave, const ForceFieldManager *ffmgr);
+
+// Composite the HUD layer over the current frame
+void DrawHud(const HudLayer *hud);
+
+// Draw the HUD directly to the current target every call (used when HUD_RETAINED is 0)
+void DrawHudImmediate(HudLayer *hud, int score, int lives, int wave, const ForceFieldManager *ffmgr);
+
+#endif // HUD_H
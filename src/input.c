@@ -0,0 +1,179 @@
+//================================================================================================
+//
+//   input.c - Timestamped mouse input implementation
+//
+//   See input.h for module interface documentation.
+//
+//   Implementation notes:
+//   - GLFW backs raylib on both desktop and web (-s USE_GLFW=3), so the entry points are
+//     declared here directly rather than pulling in GLFW headers
+//   - The press time is taken when GLFW delivers the event. On desktop pacing.c keeps
+//     pumping events while it sleeps, so this is within a millisecond or so of arrival;
+//     on web the browser delivers events as they happen between frames
+//   - Injected events are stamped with their scheduled time, so a measured delay includes
+//     the wait until the pump delivers them, as it would for a real event
+//   - A press is only current in the frame whose input sample first sees it, i.e. if it
+//     arrived after the previous sample; older pending presses are dropped at each sample
+//   - GLFW passes no user pointer here, so the state is module-level like textcache.c
+//
+//================================================================================================
+
+#include "input.h"
+#include "config.h"
+#include <stddef.h>
+
+// GLFW types and entry points used here (GLFW is linked through raylib)
+typedef struct GLFWwindow GLFWwindow;
+typedef void (*GLFWmousebuttonfun)(GLFWwindow *window, int button, int action, int mods);
+GLFWwindow *glfwGetCurrentContext(void);
+GLFWmousebuttonfun glfwSetMouseButtonCallback(GLFWwindow *window, GLFWmousebuttonfun callback);
+#if defined(PLATFORM_DESKTOP)
+int glfwWindowShouldClose(GLFWwindow *window);
+void glfwPollEvents(void);
+void glfwWaitEventsTimeout(double timeout);
+#endif
+
+#define INPUT_GLFW_RELEASE 0
+#define INPUT_GLFW_PRESS 1
+#define INPUT_MAX_BUTTONS 8
+#define INPUT_MAX_INJECTED 8
+
+// Synthetic button event waiting for its delivery time
+typedef struct InjectedEvent {
+    double time;
+    int button;
+    int action;
+} InjectedEvent;
+
+//----------------------------------------------------------------------------------
+// Module Variables
+//----------------------------------------------------------------------------------
+static GLFWwindow *inputWindow = NULL;
+static GLFWmousebuttonfun previousButtonCallback = NULL;
+static double pressTime[INPUT_MAX_BUTTONS];
+static bool pressPending[INPUT_MAX_BUTTONS];
+static InjectedEvent injected[INPUT_MAX_INJECTED]; // Sorted by time
+static int injectedCount = 0;
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// GLFW mouse button callback: stamps presses, then forwards to raylib's callback
+static void MouseButtonCallback(GLFWwindow *window, int button, int action, int mods);
+
+// Record a button event delivered at time and forward it to raylib
+static void DeliverMouseButton(GLFWwindow *window, int button, int action, int mods, double time);
+
+#if defined(PLATFORM_DESKTOP)
+// Deliver every injected event due by now
+static void DispatchInjectedEvents(double now);
+#endif
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see input.h for documentation)
+//----------------------------------------------------------------------------------
+
+void InitInputTimestamps(void)
+{
+    inputWindow = glfwGetCurrentContext();
+    if (inputWindow == NULL) {
+        TraceLog(LOG_WARNING, "INPUT: No GLFW window, click timestamps disabled");
+        return;
+    }
+    previousButtonCallback = glfwSetMouseButtonCallback(inputWindow, MouseButtonCallback);
+}
+
+double TakeClickTime(int button, double fallback)
+{
+    if (button < 0 || button >= INPUT_MAX_BUTTONS || !pressPending[button]) return fallback;
+    pressPending[button] = false;
+
+    double oldest = GetTime() - LAG_COMP_MAX_AGE;
+    return (pressTime[button] < oldest) ? oldest : pressTime[button];
+}
+
+void DiscardStaleClicks(double time)
+{
+    for (int i = 0; i < INPUT_MAX_BUTTONS; i++) {
+        if (pressPending[i] && pressTime[i] < time) pressPending[i] = false;
+    }
+}
+
+bool IsCloseRequested(void)
+{
+#if defined(PLATFORM_DESKTOP)
+    return inputWindow != NULL && glfwWindowShouldClose(inputWindow);
+#else
+    return false;
+#endif
+}
+
+void InjectMouseButton(int button, bool pressed, double time)
+{
+    if (injectedCount == INPUT_MAX_INJECTED) {
+        TraceLog(LOG_WARNING, "INPUT: Injected event queue full, event dropped");
+        return;
+    }
+    int i = injectedCount++;
+    while (i > 0 && injected[i - 1].time > time) {
+        injected[i] = injected[i - 1];
+        i--;
+    }
+    injected[i] = (InjectedEvent){time, button, pressed ? INPUT_GLFW_PRESS : INPUT_GLFW_RELEASE};
+}
+
+//----------------------------------------------------------------------------------
+// PumpInputEvents - Implementation Notes:
+// - The wait is cut short at the next injected event, then due events are delivered
+//   after the real ones GLFW processed in the same pump
+//----------------------------------------------------------------------------------
+void PumpInputEvents(double timeout)
+{
+#if defined(PLATFORM_DESKTOP)
+    double now = GetTime();
+    if (injectedCount > 0 && injected[0].time - now < timeout) timeout = injected[0].time - now;
+
+    if (timeout > 0.0)
+        glfwWaitEventsTimeout(timeout);
+    else
+        glfwPollEvents();
+
+    DispatchInjectedEvents(GetTime());
+#else
+    (void)timeout;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static void MouseButtonCallback(GLFWwindow *window, int button, int action, int mods)
+{
+    DeliverMouseButton(window, button, action, mods, GetTime());
+}
+
+static void DeliverMouseButton(GLFWwindow *window, int button, int action, int mods, double time)
+{
+    if (action == INPUT_GLFW_PRESS && button >= 0 && button < INPUT_MAX_BUTTONS) {
+        pressTime[button] = time;
+        pressPending[button] = true;
+    }
+    if (previousButtonCallback != NULL) previousButtonCallback(window, button, action, mods);
+}
+
+#if defined(PLATFORM_DESKTOP)
+static void DispatchInjectedEvents(double now)
+{
+    int due = 0;
+    while (due < injectedCount && injected[due].time <= now) {
+        DeliverMouseButton(inputWindow, injected[due].button, injected[due].action, 0, injected[due].time);
+        due++;
+    }
+    for (int i = due; i < injectedCount; i++) {
+        injected[i - due] = injected[i];
+    }
+    injectedCount -= due;
+}
+#endif
@@ -0,0 +1,61 @@
+//================================================================================================
+//
+//   input.h - Timestamped mouse input for Tailgunner
+//
+//   Records when each mouse button press was delivered, at sub-frame resolution, so
+//   gameplay can evaluate a click against the world as it looked when the player clicked
+//   rather than when the frame that processes the click starts. Also owns the desktop
+//   event pump, which can deliver synthetic button events at scheduled times.
+//
+//================================================================================================
+
+#ifndef INPUT_H
+#define INPUT_H
+
+#include "config.h"
+#include "raylib.h"
+
+//----------------------------------------------------------------------------------
+// Input Module Functions
+//----------------------------------------------------------------------------------
+
+// Start recording button press times (call once after InitWindow)
+//
+// Chains onto raylib's own GLFW mouse button callback, so raylib input is unaffected.
+void InitInputTimestamps(void);
+
+// Return and consume the time (GetTime clock) of the latest unconsumed press of button
+//
+// Call when IsMouseButtonPressed reports the press. Presses older than LAG_COMP_MAX_AGE
+// are reported as that old.
+//
+// @param fallback Time returned when no press was recorded (e.g. touch input)
+double TakeClickTime(int button, double fallback);
+
+// Drop unconsumed presses recorded before time (GetTime clock)
+//
+// Call at each input sample with the previous sample's time. A press raylib already
+// reported in an earlier frame but nobody took (e.g. the click that started the game)
+// would otherwise be taken for a later press that has no timestamp of its own, such as
+// a web touch.
+void DiscardStaleClicks(double time);
+
+// Queue a synthetic mouse button event to be delivered at time (GetTime clock)
+//
+// The event goes through the same path as a real one (raylib sees a press/release and
+// TakeClickTime reports time), once the event pump runs at or after time. Desktop only.
+void InjectMouseButton(int button, bool pressed, double time);
+
+// Returns true if the window has a close request raylib has not picked up yet
+//
+// raylib only reads the close request when EndDrawing polls events, so a loop that skips
+// drawing must check this to notice the close button. Always false on web.
+bool IsCloseRequested(void);
+
+// Process pending window and input events, waiting up to timeout seconds for one to arrive
+//
+// Returns early to deliver an injected event when it falls due. A timeout of 0 only polls.
+// Desktop only (the browser dispatches events on web).
+void PumpInputEvents(double timeout);
+
+#endif // INPUT_H
@@ -6,6 +6,8 @@
 //
 //   Implementation notes:
 //   - Uses ray-sphere intersection for enemy hit detection
+//   - With LAG_COMPENSATION the spheres are placed where each enemy was shown at the click
+//     time (see GetEnemyPositionAt), not where it is when the frame handles the click
 //   - Beams start slightly offset (left/right) from camera for visual effect
 //   - Overwrites oldest beam if all slots are active when firing
 //
@@ -34,12 +36,13 @@ void InitLasers(LaserManager *mgr)
 //----------------------------------------------------------------------------------
 // FireLasers - Implementation Notes:
 // - Uses ray-sphere intersection test to detect enemy hits
+// - Hit test uses the lag-compensated position; the beam ends at the current position
 // - Places beam start points offset from camera for visual effect
 // - Only destroys closest enemy hit by ray
 // - Will overwrite oldest beam if all slots are active
 // - Audio playback is caller's responsibility (keeps function side-effect-free)
 //----------------------------------------------------------------------------------
-int FireLasers(LaserManager *lmgr, struct EnemyManager *emgr, Ray ray, Camera camera)
+int FireLasers(LaserManager *lmgr, struct EnemyManager *emgr, Ray ray, Camera camera, double clickTime)
 {
     int hits = 0;
     // Find closest enemy hit by the ray
@@ -48,8 +51,13 @@ int FireLasers(LaserManager *lmgr, struct EnemyManager *emgr, Ray ray, Camera ca
 
     for (int i = 0; i < WAVE_SIZE; i++) {
         if (emgr->enemies[i].active) {
-            RayCollision collision =
-                GetRayCollisionSphere(ray, emgr->enemies[i].position, emgr->enemies[i].radius * 1.5f);
+#if LAG_COMPENSATION
+            Vector3 target = GetEnemyPositionAt(&emgr->enemies[i], clickTime);
+#else
+            (void)clickTime;
+            Vector3 target = emgr->enemies[i].position;
+#endif
+            RayCollision collision = GetRayCollisionSphere(ray, target, emgr->enemies[i].radius * 1.5f);
             if (collision.hit && collision.distance < closestHitDist) {
                 closestHitDist = collision.distance;
                 closestEnemyIndex = i;
@@ -108,14 +116,14 @@ int FireLasers(LaserManager *lmgr, struct EnemyManager *emgr, Ray ray, Camera ca
 
 //----------------------------------------------------------------------------------
 // UpdateLasers - Implementation Notes:
-// - Decrements lifetime of active beams using frame time
+// - Decrements lifetime of active beams by the tick length
 // - Deactivates beams when lifetime expires
 //----------------------------------------------------------------------------------
-void UpdateLasers(LaserManager *mgr)
+void UpdateLasers(LaserManager *mgr, float dt)
 {
     for (int i = 0; i < MAX_LASERS; i++) {
         if (mgr->lasers[i].active) {
-            mgr->lasers[i].lifeTime -= GetFrameTime();
+            mgr->lasers[i].lifeTime -= dt;
             if (mgr->lasers[i].lifeTime <= 0.0f) {
                 mgr->lasers[i].active = false;
             }
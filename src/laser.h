@@ -40,11 +40,15 @@ void InitLasers(LaserManager *mgr);
 //
 // @param ray Ray representing the shot direction
 // @param camera Current camera for shot origin
+// @param clickTime When the shot was fired, on the simulation clock used by RecordEnemyHistory;
+//                  with LAG_COMPENSATION enemies are hit-tested where they were shown at that time
 // @return Number of enemies hit by this shot
-int FireLasers(LaserManager *lmgr, struct EnemyManager *emgr, Ray ray, Camera camera);
+int FireLasers(LaserManager *lmgr, struct EnemyManager *emgr, Ray ray, Camera camera, double clickTime);
 
 // Update all active lasers, handling lifetime and deactivation
-void UpdateLasers(LaserManager *mgr);
+//
+// @param dt Tick length in seconds
+void UpdateLasers(LaserManager *mgr, float dt);
 
 // Render all active laser beams in 3D space
 void DrawLasers(const LaserManager *mgr);
@@ -0,0 +1,145 @@
+//================================================================================================
+//
+//   latency.c - Input-to-present latency test harness implementation
+//
+//   See latency.h for module interface documentation.
+//
+//   Implementation notes:
+//   - Clicks go through InjectMouseButton, so they take the same path as real input:
+//     event pump -> raylib button state -> IsMouseButtonPressed -> FireLasers
+//   - One click is in flight at a time; the next is scheduled LATENCY_SHOT_GAP after the
+//     previous laser is presented, plus a random fraction of a frame so clicks land at
+//     every phase of the frame
+//   - The end point is the return from EndDrawing (buffer swap handed to the driver). With
+//     VSync this includes the wait for the swap; scan-out time of the display is not included
+//
+//================================================================================================
+
+#include "latency.h"
+#include "config.h"
+#include "input.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// qsort comparison for ascending doubles
+static int CompareDoubles(const void *a, const void *b);
+
+// Sample at fraction p (0-1) of sorted samples
+static double Percentile(const double *sorted, int count, double p);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see latency.h for documentation)
+//----------------------------------------------------------------------------------
+
+void InitLatencyHarness(LatencyHarness *lh, int shots)
+{
+    *lh = (LatencyHarness){0};
+    if (shots <= 0) return;
+    lh->enabled = true;
+    lh->shotsWanted = (shots > LATENCY_MAX_SHOTS) ? LATENCY_MAX_SHOTS : shots;
+}
+
+void UpdateLatencyHarness(LatencyHarness *lh)
+{
+    if (!lh->enabled || lh->shotPending || IsLatencyTestDone(lh)) return;
+
+    double jitter = (double)GetRandomValue(0, 999) / 1000.0 / TARGET_FPS;
+    lh->eventTime = GetTime() + LATENCY_SHOT_GAP + jitter;
+    lh->shotPending = true;
+    lh->shotFired = false;
+    InjectMouseButton(MOUSE_BUTTON_LEFT, true, lh->eventTime);
+}
+
+void MarkLatencyShot(LatencyHarness *lh)
+{
+    if (lh->enabled && lh->shotPending && GetTime() >= lh->eventTime) lh->shotFired = true;
+}
+
+//----------------------------------------------------------------------------------
+// RecordLatencyPresent - Implementation Notes:
+// - Releases the button once the shot is measured, so the next click is a fresh press
+//----------------------------------------------------------------------------------
+void RecordLatencyPresent(LatencyHarness *lh, double presentTime)
+{
+    if (!lh->enabled || !lh->shotFired) return;
+
+    if (lh->shotsTaken >= LATENCY_WARMUP_SHOTS && lh->sampleCount < LATENCY_MAX_SHOTS) {
+        lh->samples[lh->sampleCount++] = presentTime - lh->eventTime;
+    }
+    lh->shotsTaken++;
+    lh->shotPending = false;
+    lh->shotFired = false;
+    InjectMouseButton(MOUSE_BUTTON_LEFT, false, presentTime);
+}
+
+bool IsLatencyTestDone(const LatencyHarness *lh)
+{
+    return lh->enabled && lh->sampleCount >= lh->shotsWanted;
+}
+
+//----------------------------------------------------------------------------------
+// ReportLatency - Implementation Notes:
+// - Histogram uses LATENCY_BIN_MS wide bins; the last bin collects everything above
+// - Summary line starts with "LATENCY" so scripts can grep it
+//----------------------------------------------------------------------------------
+void ReportLatency(LatencyHarness *lh, const char *configName)
+{
+    int count = lh->sampleCount;
+    if (count == 0) {
+        printf("LATENCY config=%s n=0\n", configName);
+        return;
+    }
+
+    qsort(lh->samples, count, sizeof(lh->samples[0]), CompareDoubles);
+
+    int bins[LATENCY_HISTOGRAM_BINS] = {0};
+    int peak = 0;
+    double sum = 0.0;
+    for (int i = 0; i < count; i++) {
+        double ms = lh->samples[i] * 1000.0;
+        int bin = (int)(ms / LATENCY_BIN_MS);
+        if (bin < 0) bin = 0;
+        if (bin >= LATENCY_HISTOGRAM_BINS) bin = LATENCY_HISTOGRAM_BINS - 1;
+        if (++bins[bin] > peak) peak = bins[bin];
+        sum += ms;
+    }
+
+    printf("Click-to-present latency, %s (%d shots):\n", configName, count);
+    for (int b = 0; b < LATENCY_HISTOGRAM_BINS; b++) {
+        if (bins[b] == 0) continue;
+        int bar = bins[b] * 50 / peak;
+        if (b == LATENCY_HISTOGRAM_BINS - 1)
+            printf("  >=%5.1f ms %5d ", b * LATENCY_BIN_MS, bins[b]);
+        else
+            printf("  %5.1f-%5.1f %5d ", b * LATENCY_BIN_MS, (b + 1) * LATENCY_BIN_MS, bins[b]);
+        for (int i = 0; i < bar; i++) {
+            putchar('#');
+        }
+        putchar('\n');
+    }
+
+    printf("LATENCY config=%s n=%d mean=%.2f p50=%.2f p90=%.2f p99=%.2f min=%.2f max=%.2f\n", configName, count,
+           sum / count, Percentile(lh->samples, count, 0.50) * 1000.0, Percentile(lh->samples, count, 0.90) * 1000.0,
+           Percentile(lh->samples, count, 0.99) * 1000.0, lh->samples[0] * 1000.0, lh->samples[count - 1] * 1000.0);
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static int CompareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static double Percentile(const double *sorted, int count, double p)
+{
+    int index = (int)(p * (count - 1) + 0.5);
+    return sorted[index];
+}
@@ -0,0 +1,54 @@
+//================================================================================================
+//
+//   latency.h - Input-to-present latency test harness for Tailgunner
+//
+//   Test mode (--latency-test) that injects synthetic left clicks at known times during
+//   play, finds the frame that first draws the resulting laser, and measures the time
+//   from the click to the return of that frame's buffer swap. Prints a histogram and a
+//   one-line summary, then the game exits. Desktop only.
+//
+//================================================================================================
+
+#ifndef LATENCY_H
+#define LATENCY_H
+
+#include "config.h"
+#include "raylib.h"
+
+// Latency test state and collected samples
+typedef struct LatencyHarness {
+    bool enabled;
+    int shotsWanted;  // Measured shots to collect (after LATENCY_WARMUP_SHOTS)
+    int shotsTaken;   // Shots measured so far, including warm-up
+    bool shotPending; // A click has been injected and its laser not yet presented
+    bool shotFired;   // FireLasers handled the pending click this frame
+    double eventTime; // Injected time of the pending click
+    double samples[LATENCY_MAX_SHOTS]; // Click-to-present times (seconds), warm-up excluded
+    int sampleCount;
+} LatencyHarness;
+
+//----------------------------------------------------------------------------------
+// Latency Harness Functions
+//----------------------------------------------------------------------------------
+
+// Initialize the harness; shots <= 0 leaves it disabled
+void InitLatencyHarness(LatencyHarness *lh, int shots);
+
+// Call at the start of each frame, after input is sampled; schedules the next click
+void UpdateLatencyHarness(LatencyHarness *lh);
+
+// Call when FireLasers has handled a click this frame
+void MarkLatencyShot(LatencyHarness *lh);
+
+// Call after the frame is presented with the time the present returned
+void RecordLatencyPresent(LatencyHarness *lh, double presentTime);
+
+// True once all requested shots have been measured
+bool IsLatencyTestDone(const LatencyHarness *lh);
+
+// Print the histogram and summary line for the collected samples
+//
+// @param configName Pacing configuration label included in the summary (e.g. "capped+vsync")
+void ReportLatency(LatencyHarness *lh, const char *configName);
+
+#endif // LATENCY_H
@@ -5,95 +5,111 @@
 // See leaderboard.h for module interface documentation.
 //
 // Implementation notes:
-// - Uses cJSON for JSON parsing
-// - Uses emscripten_fetch for web requests on web platforms
-// - Uses libcurl for HTTP requests on native platforms
+// - Response parsing lives in leaderboard_parse.c
+// - Score lists are fetched in the background through http.c and collected by
+//   PollLeaderboard; submissions go through the journaled queue in scorequeue.c
+// - Queued scores are merged into both lists until the service has them, so a new score
+//   shows at once and stays shown while offline
+// - The last good response of each list is cached in storage.c items next to the player
+//   name as a few "key value" header lines, a blank line, then the body exactly as received
+// - Lists are prefetched between games. A list revalidated recently is not fetched again
+//   when the leaderboard opens; a score the service accepts makes both lists stale, so the
+//   board shown with the locally merged score is confirmed in the background
+// - Every fetch ends: http.c gives each request a deadline, and leaving the leaderboard
+//   cancels the list fetches. A cancelled fetch counts as neither success nor failure
+// - The scrolling list shows the board from scoreboard.c. The top 10 is merged into it
+//   every frame (a few hash lookups when nothing changed); pages are unconditional GETs
+//   with count and offset, and stop at a short page, or at a page adding no rows, which is
+//   also what a service without offset support gives for the second page
 //
 //================================================================================================
 
 #include "leaderboard.h"
-#include "cJSON.h"
 #include "config.h"
 #include "game.h"
+#include "leaderboard_parse.h"
+#include "scoreboard.h"
+#include "storage.h"
+#include <math.h> // For fabsf
 #include <stdio.h>
-#include <stdlib.h> // For malloc, realloc, free
+#include <stdlib.h> // For malloc, free
 #include <string.h>
 
+#define LEADERBOARD_HASH_SEED 0xcbf29ce484222325ull // FNV-1a 64-bit offset basis
+#define LEADERBOARD_HASH_PRIME 0x100000001b3ull     // FNV-1a 64-bit prime
+#define GLOBAL_SCORES_CACHE_NAME "global.cache"
+#define USER_SCORES_CACHE_NAME "user.cache"
+#define SCORE_JOURNAL_NAME "scores"
+#define LEADERBOARD_LIST_Y 120        // Top of the global list heading
+#define LEADERBOARD_ROW_HEIGHT 30     // Pixels per list row
+#define LEADERBOARD_WHEEL_ROWS 3.0f   // Rows scrolled per mouse wheel notch
+#define LEADERBOARD_CLICK_SLOP 8.0f   // Pixels a press may move and still count as a click
+#define OVERRIDE_STORAGE_PREFIX "override." // Storage items of a service set by LEADERBOARD_URL_ENV
 #if defined(PLATFORM_WEB)
-#include <emscripten/emscripten.h>
-#include <emscripten/fetch.h>
-#include <emscripten/html5.h> // For local storage
+#define PLAYER_NAME_STORAGE_NAME "player_name" // localStorage "tailgunner_player_name"
 #else
-#include <curl/curl.h>
+#define PLAYER_NAME_STORAGE_NAME "conf" // ~/.tailgunner.conf
 #endif
 
 //----------------------------------------------------------------------------------
 // Internal Function Declarations
 //----------------------------------------------------------------------------------
-#if defined(PLATFORM_WEB)
-// onSubmitSuccess - Emscripten fetch success callback for score submission
-// @param fetch: pointer to emscripten_fetch_t containing response data and metadata
-static void onSubmitSuccess(emscripten_fetch_t *fetch);
+// FinishScoresFetch - Log parsed entries and mark a fetch complete
+// @param parsed: entry count returned by ParseGlobalScores/ParseUserScores (-1 on parse error)
+// @param entries: the parsed entries
+// @param fetchedFlag: pointer to bool set to true (also on error, to avoid continuous retries)
+// @param fetchingFlag: pointer to bool cleared
+static void FinishScoresFetch(int parsed, const LeaderboardEntry *entries, bool *fetchedFlag, bool *fetchingFlag);
 
-// onFetchFailure - Emscripten fetch error callback for any leaderboard request
-// @param fetch: pointer to emscripten_fetch_t containing error info
-static void onFetchFailure(emscripten_fetch_t *fetch);
+// FinishScoresRequest - Apply a completed global or user scores request and release it
+// @param global: true for the global top 10, false for the user's scores
+static void FinishScoresRequest(LeaderboardManager *mgr, bool global);
 
-// onGlobalScoresSuccess - Emscripten fetch success callback for global top scores
-// @param fetch: pointer to emscripten_fetch_t containing JSON payload
-static void onGlobalScoresSuccess(emscripten_fetch_t *fetch);
+// IsListFresh - True if a list revalidated at fetchTime needs no refetch at now
+static bool IsListFresh(double fetchTime, double now);
 
-// onUserScoresSuccess - Emscripten fetch success callback for user-specific scores
-// @param fetch: pointer to emscripten_fetch_t containing JSON payload
-static void onUserScoresSuccess(emscripten_fetch_t *fetch);
-#else
-// Structure to hold memory for libcurl response
-typedef struct {
-    char *memory; // pointer to allocated buffer containing response body
-    size_t size;  // size of the buffer (bytes)
-} MemoryStruct;
-
-// WriteMemoryCallback - libcurl write callback that appends incoming data to MemoryStruct
-// @param contents: pointer to incoming data buffer
-// @param size: size of an element (usually 1)
-// @param nmemb: number of elements
-// @param userp: pointer to MemoryStruct instance to append into
-// @return number of bytes handled (size * nmemb) on success, 0 on failure
-static size_t WriteMemoryCallback(const void *contents, size_t size, size_t nmemb, void *userp);
-
-// CurlGetToMemory - Perform HTTP GET and store response body in MemoryStruct
-// @param url: null-terminated URL to fetch
-// @param out: pointer to MemoryStruct to receive response (caller frees out->memory)
-// @return true on success, false on failure
-static bool CurlGetToMemory(const char *url, MemoryStruct *out);
-
-// CurlPerformNoWrite - Perform HTTP request when response body is not needed
-// @param url: null-terminated URL to request
-// @return true on success (HTTP request completed), false on failure
-static bool CurlPerformNoWrite(const char *url);
-
-// GetConfigPath - Returns path to local configuration file for native platforms
-// @return pointer to static buffer containing path (do not free)
-static const char *GetConfigPath(void);
-#endif
+// FetchRetryDelay - Seconds to wait before refetching a list after its failures-th failure in a row
+static double FetchRetryDelay(int failures);
+
+// MergeTop10IntoBoard - Add global top 10 entries the board does not have yet
+static void MergeTop10IntoBoard(LeaderboardManager *mgr);
+
+// ScrollLeaderboard - Apply this frame's scrolling input to the list
+// @return true if the player asked to close the leaderboard (Enter, or a click that is not a drag)
+static bool ScrollLeaderboard(LeaderboardManager *mgr);
+
+// FetchBoardPage - Initiate retrieval of the next page of the global board (asynchronous)
+static void FetchBoardPage(LeaderboardManager *mgr);
+
+// FinishPageRequest - Add a completed page's rows to the board and release the request
+static void FinishPageRequest(LeaderboardManager *mgr);
+
+// AddPageEntry - ParseScoresPage callback adding an entry to the ScoreBoard in context
+static void AddPageEntry(void *context, const char *name, int score);
+
+// HashBody - FNV-1a hash of a response body
+static uint64_t HashBody(const char *data, size_t size);
+
+// MergeQueuedScores - Add scores still waiting to be submitted to the global and user lists
+static void MergeQueuedScores(LeaderboardManager *mgr);
+
+// InsertScore - Insert an entry into a list sorted by descending score, unless it is already there
+// @return true if the list changed
+static bool InsertScore(LeaderboardEntry *entries, const char *name, int score);
 
-// ParseUserScores - Parse JSON payload into user-specific leaderboard entries
-// @param data: pointer to JSON data buffer
-// @param size: length of data buffer in bytes
-// @param entries: output array of LeaderboardEntry to populate
-// @param fetchedFlag: pointer to bool set to true when parsing completes
-// @param fetchingFlag: pointer to bool cleared when parsing completes
-static void ParseUserScores(const char *data, size_t size, LeaderboardEntry *entries, bool *fetchedFlag,
-                            bool *fetchingFlag);
-
-// ParseGlobalScores - Parse JSON payload into global leaderboard entries
-// @param data: pointer to JSON data buffer
-// @param size: length of data buffer in bytes
-// @param entries: output array of LeaderboardEntry to populate
-// @param fetchedFlag: pointer to bool set to true when parsing completes
-// @param fetchingFlag: pointer to bool cleared when parsing completes
-static void ParseGlobalScores(const char *data, size_t size, LeaderboardEntry *entries, bool *fetchedFlag,
-                              bool *fetchingFlag);
+// LoadCachedScores - Load and parse a cached score list from platform storage
+// @param key: storage item name (globalCacheName or userCacheName)
+// @param parse: ParseGlobalScores or ParseUserScores
+// @return true if a cached list was found and parsed into entries and cache
+static bool LoadCachedScores(const char *key, int (*parse)(const char *, size_t, LeaderboardEntry *),
+                             LeaderboardEntry *entries, LeaderboardCache *cache);
+
+// SaveCachedScores - Persist a score list response and where it came from to platform storage
+static void SaveCachedScores(const char *key, const LeaderboardCache *cache, const char *body, size_t size);
+
+// SelectLeaderboardService - Pick the service URL and the cache item names that go with it
+// @return prefix for the service's other storage item names ("" for the real service)
+static const char *SelectLeaderboardService(LeaderboardManager *mgr);
 
 // UpdateLeaderboardLayout - Recompute positions of name input boxes and buttons
 // This ensures UI elements follow the current screen size when the window is resized
@@ -116,15 +132,6 @@ static void FetchGlobalTop10(LeaderboardManager *mgr);
 // @param name: user name string to query scores for
 static void FetchUserTop10(LeaderboardManager *mgr, const char *name);
 
-// RequestLeaderboardUpdate - Mark leaderboard manager to refresh data on next update
-// (used by callbacks that cannot receive a user pointer)
-static void RequestLeaderboardUpdate(void);
-
-// Use the LeaderboardManager declared in the header.
-// A small static pointer is used only for web callbacks which cannot receive
-// a user-data pointer from emscripten_fetch handlers.
-static LeaderboardManager *s_lb_for_callbacks = NULL;
-
 // ================================================================================
 // Public functions
 // ================================================================================
@@ -135,21 +142,41 @@ void DrawLeaderboard(const LeaderboardManager *mgr)
 
     DrawText("Leaderboard", GetScreenWidth() / 2 - MeasureText("Leaderboard", 40) / 2, 50, 40, COLOR_TEXT_TITLE);
 
-    if (mgr->globalScoresFetched && mgr->userScoresFetched) {
-        int startY = 120;
-        int lineHeight = 30;
+    // A list given up on is shown too, as unavailable or empty
+    bool globalGivenUp = !mgr->globalScoresLoaded && mgr->globalFailures > LEADERBOARD_FETCH_MAX_RETRIES;
+    bool userGivenUp = !mgr->userScoresLoaded && mgr->userFailures > LEADERBOARD_FETCH_MAX_RETRIES;
+    if ((mgr->globalScoresLoaded || globalGivenUp) && (mgr->userScoresLoaded || userGivenUp)) {
+        int startY = LEADERBOARD_LIST_Y;
+        int lineHeight = LEADERBOARD_ROW_HEIGHT;
 
-        DrawText("GLOBAL TOP 10", GetScreenWidth() / 2 - MeasureText("GLOBAL TOP 10", 25) / 2, startY, 25,
+        DrawText("GLOBAL TOP SCORES", GetScreenWidth() / 2 - MeasureText("GLOBAL TOP SCORES", 25) / 2, startY, 25,
                  COLOR_TEXT_SUBTITLE);
-        for (int i = 0; i < LEADERBOARD_MAX_SCORES; i++) {
-            if (mgr->globalTop10[i].score > 0) {
-                DrawText(TextFormat("%d. %s - %d", i + 1, mgr->globalTop10[i].name, mgr->globalTop10[i].score),
-                         GetScreenWidth() / 2 - MeasureText(TextFormat("%d. %s - %d", i + 1, mgr->globalTop10[i].name,
-                                                                       mgr->globalTop10[i].score),
-                                                            20) /
-                                                    2,
-                         startY + (i + 1) * lineHeight, 20, COLOR_TEXT_LEADERBOARD);
-            }
+        if (globalGivenUp) {
+            DrawText("Leaderboard unavailable",
+                     GetScreenWidth() / 2 - MeasureText("Leaderboard unavailable", 20) / 2, startY + lineHeight, 20,
+                     COLOR_TEXT_LEADERBOARD);
+        }
+
+        // Only the rows in view are drawn, plus the one scrolled partly into it
+        const ScoreBoard *board = &mgr->board;
+        int listY = startY + lineHeight;
+        int listHeight = LEADERBOARD_MAX_SCORES * lineHeight;
+        int firstRow = (int)mgr->boardScroll;
+        int rowOffset = (int)((mgr->boardScroll - (float)firstRow) * lineHeight);
+        BeginScissorMode(0, listY, GetScreenWidth(), listHeight);
+        for (int row = firstRow; row < board->count && row <= firstRow + LEADERBOARD_MAX_SCORES; row++) {
+            const char *text = TextFormat("%d. %s - %d", row + 1, board->rows[row].name, board->rows[row].score);
+            DrawText(text, GetScreenWidth() / 2 - MeasureText(text, 20) / 2,
+                     listY + (row - firstRow) * lineHeight - rowOffset, 20, COLOR_TEXT_LEADERBOARD);
+        }
+        EndScissorMode();
+        if (board->count > LEADERBOARD_MAX_SCORES) {
+            // Scroll bar thumb to the right of the list
+            int thumbHeight = listHeight * LEADERBOARD_MAX_SCORES / board->count;
+            if (thumbHeight < 8) thumbHeight = 8;
+            float position = mgr->boardScroll / (float)(board->count - LEADERBOARD_MAX_SCORES);
+            DrawRectangle(GetScreenWidth() / 2 + 140, listY + (int)(position * (float)(listHeight - thumbHeight)), 4,
+                          thumbHeight, COLOR_TEXT_SUBTITLE);
         }
 
         // Check if current player is in global top 10
@@ -226,22 +253,131 @@ void InitLeaderboard(LeaderboardManager *mgr)
     mgr->userScoresFetching = false;
     mgr->requestUpdate = false;
     mgr->skipSubmission = false;
+    mgr->globalScoresLoaded = false;
+    mgr->userScoresLoaded = false;
+    mgr->globalFetchTime = -1.0;
+    mgr->userFetchTime = -1.0;
+    mgr->globalFailures = 0;
+    mgr->userFailures = 0;
+    mgr->globalRetryTime = 0.0;
+    mgr->userRetryTime = 0.0;
+    mgr->prefetchTime = -1.0;
+    mgr->boardOffset = 0;
+    mgr->boardComplete = false;
+    mgr->boardWanted = false;
+    mgr->pageFetching = false;
+    mgr->pageFailures = 0;
+    mgr->pageRetryTime = 0.0;
+    mgr->boardScroll = 0.0f;
+    mgr->listPressed = false;
 
     // Compute layout based on current screen size
     UpdateLeaderboardLayout(mgr);
 
-    // Save pointer for emscripten callbacks
-    s_lb_for_callbacks = mgr;
-
     LoadPlayerName(mgr);
+    const char *storagePrefix = SelectLeaderboardService(mgr);
+    InitHttp();
+#if !LEADERBOARD_STREAM_PARSER
+    SetParseArenaEnabled(true); // Before any parse; responses are parsed on this thread
+#endif
+    char journalName[32];
+    snprintf(journalName, sizeof(journalName), "%s%s", storagePrefix, SCORE_JOURNAL_NAME);
+    LoadScoreQueue(&mgr->scoreQueue, mgr->baseUrl, journalName);
+
+    // Show the last lists straight away; UpdateLeaderboard revalidates them in the background
+    mgr->globalScoresLoaded =
+        LoadCachedScores(mgr->globalCacheName, ParseGlobalScores, mgr->globalTop10, &mgr->globalCache);
+    mgr->userScoresLoaded =
+        LoadCachedScores(mgr->userCacheName, ParseUserScores, mgr->userTop10, &mgr->userCache) &&
+        strcmp(mgr->userCache.name, mgr->playerName) == 0;
+    if (!mgr->userScoresLoaded) {
+        // Nothing cached for this player
+        memset(mgr->userTop10, 0, sizeof(mgr->userTop10));
+        memset(&mgr->userCache, 0, sizeof(mgr->userCache));
+        snprintf(mgr->userCache.name, sizeof(mgr->userCache.name), "%s", mgr->playerName);
+    }
+    MergeQueuedScores(mgr);
+}
+
+void UnloadLeaderboard(LeaderboardManager *mgr)
+{
+    if (!mgr) return;
+    // The requests live in mgr, so their workers must be gone before it is
+    CloseHttpRequest(&mgr->globalRequest);
+    CloseHttpRequest(&mgr->userRequest);
+    CloseHttpRequest(&mgr->pageRequest);
+    UnloadScoreQueue(&mgr->scoreQueue);
+    CloseHttp();
+    FreeScoreBoard(&mgr->board);
+}
+
+bool PollLeaderboard(LeaderboardManager *mgr)
+{
+    if (!mgr) return false;
+    bool finished = false;
+    if (PollHttpRequest(&mgr->globalRequest)) {
+        FinishScoresRequest(mgr, true);
+        finished = true;
+    }
+    if (PollHttpRequest(&mgr->userRequest)) {
+        FinishScoresRequest(mgr, false);
+        finished = true;
+    }
+    if (PollHttpRequest(&mgr->pageRequest)) {
+        FinishPageRequest(mgr);
+        finished = true;
+    }
+
+    if (UpdateScoreQueue(&mgr->scoreQueue, GetTime()) > 0) {
+        // The lists can now come from the service; fetch them again if they are on screen,
+        // or when they are next shown
+        mgr->requestUpdate = true;
+        mgr->globalFetchTime = -1.0;
+        mgr->userFetchTime = -1.0;
+        finished = true;
+    }
+    return finished;
+}
+
+void PrefetchLeaderboard(LeaderboardManager *mgr)
+{
+    if (!mgr || mgr->isActive) return;
+    double now = GetTime();
+    if (mgr->prefetchTime >= 0.0 && now - mgr->prefetchTime < LEADERBOARD_FRESH_TIME) return;
+
+    bool globalStale = !IsListFresh(mgr->globalFetchTime, now);
+    bool userStale = !IsListFresh(mgr->userFetchTime, now) || strcmp(mgr->userCache.name, mgr->playerName) != 0;
+    if (!globalStale && !userStale) return;
+
+    mgr->prefetchTime = now;
+    if (globalStale) FetchGlobalTop10(mgr);
+    if (userStale) FetchUserTop10(mgr, mgr->playerName);
 }
 
 void ResetLeaderboardFlags(LeaderboardManager *mgr)
 {
     if (!mgr) return;
+    double now = GetTime();
     mgr->scoreSubmitted = false;
-    mgr->globalScoresFetched = false;
-    mgr->userScoresFetched = false;
+    if (!IsListFresh(mgr->globalFetchTime, now)) mgr->globalScoresFetched = false;
+    if (!IsListFresh(mgr->userFetchTime, now) || strcmp(mgr->userCache.name, mgr->playerName) != 0)
+        mgr->userScoresFetched = false;
+    mgr->globalFailures = 0;
+    mgr->userFailures = 0;
+    mgr->globalRetryTime = 0.0;
+    mgr->userRetryTime = 0.0;
+
+    // Pages fetched for an earlier visit may overlap or miss rows by now
+    CancelHttpRequest(&mgr->pageRequest);
+    ClearScoreBoard(&mgr->board);
+    MergeTop10IntoBoard(mgr);
+    mgr->boardOffset = 0;
+    mgr->boardComplete = false;
+    mgr->boardWanted = false;
+    mgr->pageFailures = 0;
+    mgr->pageRetryTime = 0.0;
+    mgr->boardScroll = 0.0f;
+    mgr->listPressed = false;
 }
 
 void SetLeaderboardActive(LeaderboardManager *mgr, bool active)
@@ -252,31 +388,10 @@ void SetLeaderboardActive(LeaderboardManager *mgr, bool active)
 
 void SubmitScore(LeaderboardManager *mgr, int score)
 {
-    char url[256];
     if (!mgr) return;
-    sprintf(url, "%s?action=newScore&gameID=%d&userName=%s&score=%d", LEADERBOARD_BASE_URL, LEADERBOARD_GAME_ID,
-            mgr->playerName, score);
-
-#if defined(PLATFORM_WEB)
-    emscripten_fetch_attr_t attr;
-    emscripten_fetch_attr_init(&attr);
-    strcpy(attr.requestMethod, "POST");
-    attr.attributes = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY;
-    attr.onsuccess = onSubmitSuccess;
-    attr.onerror = onFetchFailure;
-
-    emscripten_fetch(&attr, url);
-#else
-    if (!CurlPerformNoWrite(url)) {
-        fprintf(stderr, "Score submission failed for URL: %s\n", url);
-    }
-    else {
-        printf("Score submitted successfully.\n");
-        mgr->scoreSubmitted = true;
-        mgr->requestUpdate = true;
-        RequestLeaderboardUpdate();
-    }
-#endif
+    if (!EnqueueScore(&mgr->scoreQueue, mgr->playerName, score)) return;
+    mgr->scoreSubmitted = true;
+    MergeQueuedScores(mgr);
 }
 
 void UpdateLeaderboard(LeaderboardManager *mgr, int *gameState)
@@ -284,14 +399,32 @@ void UpdateLeaderboard(LeaderboardManager *mgr, int *gameState)
     if (!mgr || !mgr->isActive) return;
 
     if (mgr->requestUpdate) {
-        ResetLeaderboardFlags(mgr);
+        // A queued score reached the service: confirm the locally merged lists
+        mgr->globalScoresFetched = false;
+        mgr->userScoresFetched = false;
         mgr->requestUpdate = false;
     }
 
-    if (!mgr->globalScoresFetched && !mgr->globalScoresFetching) FetchGlobalTop10(mgr);
-    if (!mgr->userScoresFetched && !mgr->userScoresFetching) FetchUserTop10(mgr, mgr->playerName);
+    double now = GetTime();
+    if (!mgr->globalScoresFetched && !mgr->globalScoresFetching && now >= mgr->globalRetryTime) {
+        FetchGlobalTop10(mgr);
+    }
+    if (!mgr->userScoresFetched && !mgr->userScoresFetching && now >= mgr->userRetryTime) {
+        FetchUserTop10(mgr, mgr->playerName);
+    }
+
+    MergeTop10IntoBoard(mgr);
+    bool closeRequested = ScrollLeaderboard(mgr);
+    if (mgr->boardWanted && !mgr->boardComplete && !mgr->pageFetching && now >= mgr->pageRetryTime &&
+        mgr->boardScroll + 2 * LEADERBOARD_MAX_SCORES >= (float)mgr->board.count) {
+        FetchBoardPage(mgr);
+    }
 
-    if (IsKeyPressed(KEY_ENTER) || IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+    if (closeRequested) {
+        // Nobody is waiting for the lists any more; prefetching picks them up later
+        CancelHttpRequest(&mgr->globalRequest);
+        CancelHttpRequest(&mgr->userRequest);
+        CancelHttpRequest(&mgr->pageRequest);
         SetLeaderboardActive(mgr, false);
         *gameState = STATE_START;
     }
@@ -329,243 +462,359 @@ bool UpdateNameInput(LeaderboardManager *mgr)
 // Internal Function Implementations
 //----------------------------------------------------------------------------------
 
-#if defined(PLATFORM_WEB)
-#define PLAYER_NAME_STORAGE_KEY "tailgunner_player_name"
-// clang-format off
-EM_JS(char*, emscripten_local_storage_get_item_js, (const char* key_ptr), {
-  var key = UTF8ToString(key_ptr);
-  var value = localStorage.getItem(key);
-  if (value === null) {
-    return 0; // Return null pointer if item not found
-  }
-  var length = lengthBytesUTF8(value) + 1;
-  var value_ptr = _malloc(length);
-  stringToUTF8(value, value_ptr, length);
-  return value_ptr;
-});
-
-EM_JS(int, emscripten_local_storage_set_item_js, (const char* key_ptr, const char* value_ptr), {
-  var key = UTF8ToString(key_ptr);
-  var value = UTF8ToString(value_ptr);
-  try {
-    localStorage.setItem(key, value);
-    return 0; // Success
-  } catch (e) {
-    return 1; // Failure
-  }
-});
-// clang-format on
-
-static void onSubmitSuccess(emscripten_fetch_t *fetch)
+static void FinishScoresFetch(int parsed, const LeaderboardEntry *entries, bool *fetchedFlag, bool *fetchingFlag)
 {
-    printf("Score submitted successfully.\n");
-    if (s_lb_for_callbacks) s_lb_for_callbacks->scoreSubmitted = true;
-    emscripten_fetch_close(fetch);
-    RequestLeaderboardUpdate();
+    for (int i = 0; i < parsed; i++) {
+        printf("Parsed: %s - %d\n", entries[i].name, entries[i].score);
+    }
+    *fetchedFlag = true; // Also on a parse error, to avoid continuous retries
+    *fetchingFlag = false;
 }
 
-static void onFetchFailure(emscripten_fetch_t *fetch)
+//----------------------------------------------------------------------------------
+// FinishScoresRequest - Implementation Notes:
+// - 304, or a 200 whose body hashes the same as the loaded list's, keeps the list as it is
+// - A user scores response for a name other than the current player's (the name changed
+//   while it was in flight) is dropped, so the list is fetched again
+// - A cancelled request only clears the fetching flag; the list stays as it was
+// - After a transport failure (or timeout) or a "try again later" status (408, 429, 5xx) a
+//   cached list stays shown. Without one the list is retried after a backoff, and once the
+//   retries run out it is shown as unavailable. Any other 4xx is final
+// - Only an answer with the list (200 or 304) counts as a revalidation for freshness
+//----------------------------------------------------------------------------------
+static void FinishScoresRequest(LeaderboardManager *mgr, bool global)
 {
-    printf("Failed to fetch data: %s\n", fetch->statusText);
-    if (!s_lb_for_callbacks) {
-        emscripten_fetch_close(fetch);
-        return;
+    HttpRequest *req = global ? &mgr->globalRequest : &mgr->userRequest;
+    LeaderboardEntry *entries = global ? mgr->globalTop10 : mgr->userTop10;
+    LeaderboardCache *cache = global ? &mgr->globalCache : &mgr->userCache;
+    bool *loaded = global ? &mgr->globalScoresLoaded : &mgr->userScoresLoaded;
+    bool *fetched = global ? &mgr->globalScoresFetched : &mgr->userScoresFetched;
+    bool *fetching = global ? &mgr->globalScoresFetching : &mgr->userScoresFetching;
+    double *fetchTime = global ? &mgr->globalFetchTime : &mgr->userFetchTime;
+    int *failures = global ? &mgr->globalFailures : &mgr->userFailures;
+    double *retryTime = global ? &mgr->globalRetryTime : &mgr->userRetryTime;
+    const char *label = global ? "Global" : "User";
+    const char *cacheName = global ? mgr->globalCacheName : mgr->userCacheName;
+
+    bool answered = req->ok && !IsHttpStatusTransient(req->status); // A final answer, not "try later"
+    if (answered) *failures = 0;
+    if (req->cancelled || (!global && strcmp(cache->name, mgr->playerName) != 0)) {
+        *fetching = false;
     }
-    if (strcmp(fetch->url + strlen(fetch->url) - 8, "topScores") == 0) {
-        s_lb_for_callbacks->globalScoresFetching = false;
+    else if (!answered) {
+        fprintf(stderr, "Failed to fetch %s scores from URL: %s (HTTP %ld%s)\n", global ? "global" : "user", req->url,
+                req->status, req->timedOut ? ", timed out" : "");
+        *fetching = false;
+        if (*loaded) {
+            *fetched = true;
+        }
+        else if (++*failures > LEADERBOARD_FETCH_MAX_RETRIES) {
+            fprintf(stderr, "Giving up on %s scores\n", global ? "global" : "user");
+            *fetched = true;
+        }
+        else {
+            *retryTime = GetTime() + FetchRetryDelay(*failures);
+        }
+    }
+    else if (req->status == 304 && *loaded) {
+        printf("%s scores not modified.\n", label);
+        *fetched = true;
+        *fetching = false;
+        *fetchTime = GetTime();
+    }
+    else if (req->status < 200 || req->status > 299) {
+        fprintf(stderr, "%s scores request returned HTTP %ld\n", label, req->status);
+        *loaded = true;
+        *fetched = true;
+        *fetching = false;
     }
     else {
-        s_lb_for_callbacks->userScoresFetching = false;
+        uint64_t hash = HashBody(req->body, req->size);
+        if (*loaded && hash == cache->bodyHash) {
+            printf("%s scores unchanged.\n", label);
+            *fetched = true;
+            *fetching = false;
+            *fetchTime = GetTime();
+            if (memcmp(&cache->validators, &req->validators, sizeof(req->validators)) != 0) {
+                cache->validators = req->validators;
+                SaveCachedScores(cacheName, cache, req->body, req->size);
+            }
+        }
+        else {
+            printf("%s scores fetched successfully.\n", label);
+            int parsed = global ? ParseGlobalScores(req->body, req->size, entries)
+                                : ParseUserScores(req->body, req->size, entries);
+            FinishScoresFetch(parsed, entries, fetched, fetching);
+            *loaded = true;
+            if (parsed >= 0) {
+                *fetchTime = GetTime();
+                cache->validators = req->validators;
+                cache->bodyHash = hash;
+                SaveCachedScores(cacheName, cache, req->body, req->size);
+            }
+        }
     }
-    emscripten_fetch_close(fetch);
+    ReleaseHttpRequest(req);
+    if (answered) RetryScoreQueueNow(&mgr->scoreQueue); // The service answers again: no point waiting out a backoff
+    MergeQueuedScores(mgr);
 }
 
-static void onGlobalScoresSuccess(emscripten_fetch_t *fetch)
+static bool IsListFresh(double fetchTime, double now)
 {
-    printf("Global scores fetched successfully.\n");
-    if (!s_lb_for_callbacks) return;
-    ParseGlobalScores(fetch->data, fetch->numBytes, s_lb_for_callbacks->globalTop10,
-                      &s_lb_for_callbacks->globalScoresFetched, &s_lb_for_callbacks->globalScoresFetching);
+    return fetchTime >= 0.0 && now - fetchTime < LEADERBOARD_FRESH_TIME;
 }
 
-static void onUserScoresSuccess(emscripten_fetch_t *fetch)
+static double FetchRetryDelay(int failures)
 {
-    printf("User scores fetched successfully.\n");
-    if (!s_lb_for_callbacks) return;
-    ParseUserScores(fetch->data, fetch->numBytes, s_lb_for_callbacks->userTop10, &s_lb_for_callbacks->userScoresFetched,
-                    &s_lb_for_callbacks->userScoresFetching);
+    double delay = LEADERBOARD_FETCH_RETRY_DELAY;
+    for (int i = 1; i < failures; i++) delay *= 2.0;
+    return delay * (0.5 + GetRandomValue(0, 1000) / 1000.0); // +/- 50%, so clients don't retry in step
 }
-#else
-static size_t WriteMemoryCallback(const void *contents, size_t size, size_t nmemb, void *userp)
-{
-    size_t realsize = size * nmemb;
-    MemoryStruct *mem = (MemoryStruct *)userp;
 
-    char *ptr = realloc(mem->memory, mem->size + realsize + 1);
-    if (ptr == NULL) {
-        // out of memory!
-        printf("not enough memory (realloc returned NULL)\n");
-        return 0;
+static void MergeTop10IntoBoard(LeaderboardManager *mgr)
+{
+    for (int i = 0; i < LEADERBOARD_MAX_SCORES; i++) {
+        AddBoardScore(&mgr->board, mgr->globalTop10[i].name, mgr->globalTop10[i].score);
     }
-
-    mem->memory = ptr;
-    memcpy(&(mem->memory[mem->size]), contents, realsize);
-    mem->size += realsize;
-    mem->memory[mem->size] = 0;
-
-    return realsize;
 }
 
-// Helper: perform a GET request into memory using libcurl. Caller must free out->memory on success.
-static bool CurlGetToMemory(const char *url, MemoryStruct *out)
+//----------------------------------------------------------------------------------
+// ScrollLeaderboard - Implementation Notes:
+// - A press starts a drag or a click; the leaderboard closes on the release of a press made
+//   on it that moved less than LEADERBOARD_CLICK_SLOP, so the release of the click that
+//   opened it does not close it again
+// - The scroll position is clamped so the last row can reach the bottom of the list
+//----------------------------------------------------------------------------------
+static bool ScrollLeaderboard(LeaderboardManager *mgr)
 {
-    CURL *curl;
-    CURLcode res;
-
-    out->memory = malloc(1);
-    if (!out->memory) return false;
-    out->size = 0;
-
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-    curl = curl_easy_init();
-    if (!curl) {
-        curl_global_cleanup();
-        free(out->memory);
-        out->memory = NULL;
-        return false;
+    float maxScroll = (float)(mgr->board.count - LEADERBOARD_MAX_SCORES);
+    if (maxScroll < 0.0f) maxScroll = 0.0f;
+
+    float rows = -GetMouseWheelMove() * LEADERBOARD_WHEEL_ROWS;
+    if (IsKeyPressed(KEY_DOWN)) rows += 1.0f;
+    if (IsKeyPressed(KEY_UP)) rows -= 1.0f;
+    if (IsKeyPressed(KEY_PAGE_DOWN)) rows += LEADERBOARD_MAX_SCORES;
+    if (IsKeyPressed(KEY_PAGE_UP)) rows -= LEADERBOARD_MAX_SCORES;
+    if (IsKeyPressed(KEY_HOME)) rows = -mgr->boardScroll;
+    if (IsKeyPressed(KEY_END)) rows = (float)mgr->board.count; // Clamped to the last row below
+
+    bool closeRequested = IsKeyPressed(KEY_ENTER);
+    if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
+        mgr->listPressed = true;
+        mgr->dragDistance = 0.0f;
     }
-
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteMemoryCallback);
-    curl_easy_setopt(curl, CURLOPT_WRITEDATA, (void *)out);
-
-    res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
-    curl_global_cleanup();
-
-    if (res != CURLE_OK) {
-        free(out->memory);
-        out->memory = NULL;
-        out->size = 0;
-        return false;
+    else if (mgr->listPressed && IsMouseButtonDown(MOUSE_LEFT_BUTTON)) {
+        float dy = GetMouseDelta().y;
+        mgr->dragDistance += fabsf(dy);
+        rows -= dy / LEADERBOARD_ROW_HEIGHT;
+    }
+    if (mgr->listPressed && IsMouseButtonReleased(MOUSE_LEFT_BUTTON)) {
+        mgr->listPressed = false;
+        if (mgr->dragDistance < LEADERBOARD_CLICK_SLOP) closeRequested = true;
     }
 
-    return true;
+    if (rows != 0.0f) mgr->boardWanted = true;
+    mgr->boardScroll += rows;
+    if (mgr->boardScroll > maxScroll) mgr->boardScroll = maxScroll;
+    if (mgr->boardScroll < 0.0f) mgr->boardScroll = 0.0f;
+    return closeRequested;
 }
 
-// Helper: perform a request when we don't need response body (e.g., submit score)
-static bool CurlPerformNoWrite(const char *url)
+static void FetchBoardPage(LeaderboardManager *mgr)
 {
-    CURL *curl;
-    CURLcode res;
+    char url[HTTP_URL_LENGTH];
+    snprintf(url, sizeof(url), "%s?action=topScores&gameID=%d&count=%d&offset=%d", mgr->baseUrl, LEADERBOARD_GAME_ID,
+             LEADERBOARD_PAGE_SIZE, mgr->boardOffset);
+    if (StartHttpGet(&mgr->pageRequest, url, NULL)) mgr->pageFetching = true;
+}
 
-    curl_global_init(CURL_GLOBAL_DEFAULT);
-    curl = curl_easy_init();
-    if (!curl) {
-        curl_global_cleanup();
-        return false;
+//----------------------------------------------------------------------------------
+// FinishPageRequest - Implementation Notes:
+// - Rows already on the board (the top 10, the overlap left when scores were added between
+//   pages, or a whole page from a service ignoring the offset) are skipped by its hash set
+// - A failed page (transport failure, 408, 429 or 5xx) is retried after a backoff, when the
+//   list is next scrolled; after LEADERBOARD_FETCH_MAX_RETRIES, or at once on any other
+//   non-2xx status, the board is left as it is until the leaderboard reopens
+//----------------------------------------------------------------------------------
+static void FinishPageRequest(LeaderboardManager *mgr)
+{
+    HttpRequest *req = &mgr->pageRequest;
+    mgr->pageFetching = false;
+    if (req->cancelled) {
+        // The leaderboard closed or reopened; the board no longer expects this page
     }
+    else if (!req->ok || req->status < 200 || req->status > 299) {
+        fprintf(stderr, "Failed to fetch leaderboard page at row %d (HTTP %ld%s)\n", mgr->boardOffset, req->status,
+                req->timedOut ? ", timed out" : "");
+        if ((req->ok && !IsHttpStatusTransient(req->status)) || ++mgr->pageFailures > LEADERBOARD_FETCH_MAX_RETRIES)
+            mgr->boardComplete = true;
+        else
+            mgr->pageRetryTime = GetTime() + FetchRetryDelay(mgr->pageFailures);
+    }
+    else {
+        int rowsBefore = mgr->board.count;
+        int read = ParseScoresPage(req->body, req->size, AddPageEntry, &mgr->board);
+        int added = mgr->board.count - rowsBefore;
+        printf("Leaderboard page at row %d: %d entries, %d new.\n", mgr->boardOffset, read, added);
+        mgr->pageFailures = 0;
+        mgr->boardOffset += LEADERBOARD_PAGE_SIZE;
+        if (read < LEADERBOARD_PAGE_SIZE || added == 0 || mgr->board.count == LEADERBOARD_BOARD_MAX_ROWS) {
+            mgr->boardComplete = true;
+        }
+    }
+    ReleaseHttpRequest(req);
+}
 
-    curl_easy_setopt(curl, CURLOPT_URL, url);
-    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, NULL);
-
-    res = curl_easy_perform(curl);
-    curl_easy_cleanup(curl);
-    curl_global_cleanup();
-
-    return (res == CURLE_OK);
+static void AddPageEntry(void *context, const char *name, int score)
+{
+    AddBoardScore((ScoreBoard *)context, name, score);
 }
 
-static const char *GetConfigPath(void)
+static uint64_t HashBody(const char *data, size_t size)
 {
-    const char *homeDir = getenv("HOME");
-    if (homeDir == NULL) {
-        return ".tailgunner.conf";
+    uint64_t h = LEADERBOARD_HASH_SEED;
+    for (size_t i = 0; i < size; i++) {
+        h = (h ^ (unsigned char)data[i]) * LEADERBOARD_HASH_PRIME;
     }
-    static char path[256];
-    snprintf(path, sizeof(path), "%s/.tailgunner.conf", homeDir);
-    return path;
+    return h;
 }
-#endif
 
-static void ParseUserScores(const char *data, size_t size, LeaderboardEntry *entries, bool *fetchedFlag,
-                            bool *fetchingFlag)
+//----------------------------------------------------------------------------------
+// LoadCachedScores - Implementation Notes:
+// - Unknown header keys are skipped, and a missing or malformed entry (or a body that no
+//   longer parses) just means there is no cached list
+// - The body hash is recomputed rather than stored, so it always matches the body
+//----------------------------------------------------------------------------------
+static bool LoadCachedScores(const char *key, int (*parse)(const char *, size_t, LeaderboardEntry *),
+                             LeaderboardEntry *entries, LeaderboardCache *cache)
 {
-    memset(entries, 0, sizeof(LeaderboardEntry) * LEADERBOARD_MAX_SCORES);
-    cJSON *json = cJSON_ParseWithLength(data, size);
-    if (json == NULL) {
-        const char *error_ptr = cJSON_GetErrorPtr();
-        if (error_ptr != NULL) {
-            fprintf(stderr, "Error before: %s\n", error_ptr);
+    memset(cache, 0, sizeof(*cache));
+    char *text = LoadStorageItem(key);
+    if (text == NULL) return false;
+
+    // "key value" lines up to a blank line, then the body
+    char *line = text;
+    char *body = NULL;
+    while (*line != '\0') {
+        char *end = strchr(line, '\n');
+        if (end == NULL) break;
+        *end = '\0';
+        if (line == end) {
+            body = end + 1;
+            break;
         }
-        *fetchedFlag = true; // Mark as fetched to avoid continuous retries on parse error
-        *fetchingFlag = false;
-        return;
-    }
-
-    int count = cJSON_GetArraySize(json);
-    int entryIndex = 0;
-    for (int i = 0; i < count && entryIndex < LEADERBOARD_MAX_SCORES; i++) {
-        cJSON *item = cJSON_GetArrayItem(json, i);
-        if (item != NULL && item->child != NULL) {
-            strncpy(entries[entryIndex].name, item->child->string, LEADERBOARD_NAME_LENGTH);
-            entries[entryIndex].name[LEADERBOARD_NAME_LENGTH] = '\0';
-            entries[entryIndex].score = item->child->valueint;
-            printf("Parsed: %s - %d\n", entries[entryIndex].name, entries[entryIndex].score);
-            entryIndex++;
+        char *value = strchr(line, ' ');
+        if (value != NULL) {
+            *value++ = '\0';
+            if (strcmp(line, "name") == 0)
+                snprintf(cache->name, sizeof(cache->name), "%s", value);
+            else if (strcmp(line, "etag") == 0)
+                snprintf(cache->validators.etag, sizeof(cache->validators.etag), "%s", value);
+            else if (strcmp(line, "last-modified") == 0)
+                snprintf(cache->validators.lastModified, sizeof(cache->validators.lastModified), "%s", value);
         }
+        line = end + 1;
     }
 
-    cJSON_Delete(json);
-    *fetchedFlag = true;
-    *fetchingFlag = false;
+    bool loaded = false;
+    if (body != NULL) {
+        size_t size = strlen(body);
+        loaded = parse(body, size, entries) >= 0;
+        cache->bodyHash = HashBody(body, size);
+    }
+    free(text);
+    if (!loaded) memset(cache, 0, sizeof(*cache));
+    return loaded;
 }
 
-static void ParseGlobalScores(const char *data, size_t size, LeaderboardEntry *entries, bool *fetchedFlag,
-                              bool *fetchingFlag)
+//----------------------------------------------------------------------------------
+// SaveCachedScores - Implementation Notes:
+// - Header values never contain newlines (HTTP header values and player initials)
+// - A body containing NUL bytes can't be stored as text and is not cached
+//----------------------------------------------------------------------------------
+static void SaveCachedScores(const char *key, const LeaderboardCache *cache, const char *body, size_t size)
 {
-    memset(entries, 0, sizeof(LeaderboardEntry) * LEADERBOARD_MAX_SCORES);
-    cJSON *json = cJSON_ParseWithLength(data, size);
-    if (json == NULL) {
-        const char *error_ptr = cJSON_GetErrorPtr();
-        if (error_ptr != NULL) {
-            fprintf(stderr, "Error before: %s\n", error_ptr);
-        }
-        *fetchedFlag = true; // Mark as fetched to avoid continuous retries on parse error
-        *fetchingFlag = false;
-        return;
-    }
-
-    int count = cJSON_GetArraySize(json);
-    int entryIndex = 0;
-    for (int i = 0; i < count && entryIndex < LEADERBOARD_MAX_SCORES; i++) {
-        cJSON *item = cJSON_GetArrayItem(json, i);
-        const cJSON *name = cJSON_GetObjectItemCaseSensitive(item, "userName");
-        cJSON *score = cJSON_GetObjectItemCaseSensitive(item, "score");
-
-        if (cJSON_IsString(name) && (name->valuestring != NULL) && cJSON_IsNumber(score)) {
-            // Check if this (user, score) pair already exists to avoid exact duplicates
-            bool isDuplicate = false;
-            for (int j = 0; j < entryIndex; j++) {
-                if (strcmp(entries[j].name, name->valuestring) == 0 && entries[j].score == (int)score->valuedouble) {
-                    isDuplicate = true;
-                    break;
-                }
-            }
+    char header[64 + 2 * HTTP_VALIDATOR_LENGTH];
+    int headerLength = snprintf(header, sizeof(header), "name %s\netag %s\nlast-modified %s\n\n", cache->name,
+                                cache->validators.etag, cache->validators.lastModified);
+    if (headerLength < 0 || (size_t)headerLength >= sizeof(header)) return;
+    if (memchr(body, '\0', size) != NULL) return;
+
+    char *text = malloc((size_t)headerLength + size + 1);
+    if (text == NULL) return;
+    memcpy(text, header, (size_t)headerLength);
+    memcpy(text + headerLength, body, size);
+    text[headerLength + size] = '\0';
+    SaveStorageItem(key, text);
+    free(text);
+}
 
-            if (!isDuplicate) {
-                strncpy(entries[entryIndex].name, name->valuestring, LEADERBOARD_NAME_LENGTH);
-                entries[entryIndex].name[LEADERBOARD_NAME_LENGTH] = '\0';
-                entries[entryIndex].score = (int)score->valuedouble;
-                printf("Parsed: %s - %d\n", entries[entryIndex].name, entries[entryIndex].score);
-                entryIndex++;
-            }
+//----------------------------------------------------------------------------------
+// MergeQueuedScores - Implementation Notes:
+// - A list changed this way no longer matches its cached response, so its hash and
+//   validators are dropped: the next fetch is unconditional and always re-parsed
+// - A list with nothing loaded yet becomes loaded, so a new score shows even offline
+//----------------------------------------------------------------------------------
+static void MergeQueuedScores(LeaderboardManager *mgr)
+{
+    const ScoreQueue *queue = &mgr->scoreQueue;
+    for (int i = 0; i < queue->count; i++) {
+        const QueuedScore *entry = &queue->scores[i];
+        if (InsertScore(mgr->globalTop10, entry->name, entry->score)) {
+            mgr->globalCache.bodyHash = 0;
+            memset(&mgr->globalCache.validators, 0, sizeof(mgr->globalCache.validators));
+            mgr->globalScoresLoaded = true;
+        }
+        if (strcmp(entry->name, mgr->userCache.name) == 0 && InsertScore(mgr->userTop10, entry->name, entry->score)) {
+            mgr->userCache.bodyHash = 0;
+            memset(&mgr->userCache.validators, 0, sizeof(mgr->userCache.validators));
+            mgr->userScoresLoaded = true;
         }
     }
+}
 
-    cJSON_Delete(json);
-    *fetchedFlag = true;
-    *fetchingFlag = false;
+static bool InsertScore(LeaderboardEntry *entries, const char *name, int score)
+{
+    if (score <= 0) return false;
+    int at = LEADERBOARD_MAX_SCORES;
+    for (int i = 0; i < LEADERBOARD_MAX_SCORES; i++) {
+        if (entries[i].score == score && strcmp(entries[i].name, name) == 0) return false; // Already listed
+        if (at == LEADERBOARD_MAX_SCORES && entries[i].score < score) at = i;
+    }
+    if (at == LEADERBOARD_MAX_SCORES) return false; // Doesn't make the list
+
+    memmove(&entries[at + 1], &entries[at], (LEADERBOARD_MAX_SCORES - at - 1) * sizeof(LeaderboardEntry));
+    snprintf(entries[at].name, sizeof(entries[at].name), "%s", name);
+    entries[at].score = score;
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// SelectLeaderboardService - Implementation Notes:
+// - An overriding service gets its own cache and journal items, so test scores are never
+//   submitted to the real service and test lists never shown for it; the player name is
+//   shared
+// - Web builds have no environment to read and always use LEADERBOARD_BASE_URL
+//----------------------------------------------------------------------------------
+static const char *SelectLeaderboardService(LeaderboardManager *mgr)
+{
+    const char *url = NULL;
+#if !defined(PLATFORM_WEB)
+    url = getenv(LEADERBOARD_URL_ENV);
+#endif
+    if (url != NULL && url[0] != '\0' && strlen(url) < sizeof(mgr->baseUrl) - 64) {
+        printf("Leaderboard service: %s\n", url);
+    }
+    else {
+        if (url != NULL && url[0] != '\0') fprintf(stderr, "%s is too long, ignoring it\n", LEADERBOARD_URL_ENV);
+        url = LEADERBOARD_BASE_URL;
+    }
+    snprintf(mgr->baseUrl, sizeof(mgr->baseUrl), "%s", url);
+
+    const char *prefix = strcmp(mgr->baseUrl, LEADERBOARD_BASE_URL) == 0 ? "" : OVERRIDE_STORAGE_PREFIX;
+    snprintf(mgr->globalCacheName, sizeof(mgr->globalCacheName), "%s%s", prefix, GLOBAL_SCORES_CACHE_NAME);
+    snprintf(mgr->userCacheName, sizeof(mgr->userCacheName), "%s%s", prefix, USER_SCORES_CACHE_NAME);
+    return prefix;
 }
 
 static void UpdateLeaderboardLayout(LeaderboardManager *mgr)
@@ -585,115 +834,50 @@ static void UpdateLeaderboardLayout(LeaderboardManager *mgr)
 
 static void SavePlayerName(const LeaderboardManager *mgr)
 {
-#if defined(PLATFORM_WEB)
-    emscripten_local_storage_set_item_js(PLAYER_NAME_STORAGE_KEY, mgr->playerName);
-#else
-    FILE *f = fopen(GetConfigPath(), "w");
-    if (f != NULL) {
-        fputs(mgr->playerName, f);
-        fclose(f);
-    }
-#endif
+    SaveStorageItem(PLAYER_NAME_STORAGE_NAME, mgr->playerName);
 }
 
 static void LoadPlayerName(LeaderboardManager *mgr)
 {
-#if defined(PLATFORM_WEB)
-    char *storedName = emscripten_local_storage_get_item_js(PLAYER_NAME_STORAGE_KEY);
+    char *storedName = LoadStorageItem(PLAYER_NAME_STORAGE_NAME);
     if (storedName != NULL) {
-        strncpy(mgr->playerName, storedName, LEADERBOARD_NAME_LENGTH);
-        mgr->playerName[LEADERBOARD_NAME_LENGTH] = '\0';
-        free(storedName);
-    }
-#else
-    FILE *f = fopen(GetConfigPath(), "r");
-    if (f != NULL) {
-        if (fgets(mgr->playerName, sizeof(mgr->playerName), f) != NULL) {
-            // remove newline character
-            mgr->playerName[strcspn(mgr->playerName, "\n")] = 0;
+        // remove newline character
+        storedName[strcspn(storedName, "\n")] = 0;
+        if (storedName[0] != '\0') {
+            strncpy(mgr->playerName, storedName, LEADERBOARD_NAME_LENGTH);
+            mgr->playerName[LEADERBOARD_NAME_LENGTH] = '\0';
         }
-        fclose(f);
+        free(storedName);
     }
-#endif
 }
 
 static void FetchGlobalTop10(LeaderboardManager *mgr)
 {
-    char url[256];
-    sprintf(url, "%s?action=topScores&gameID=%d", LEADERBOARD_BASE_URL, LEADERBOARD_GAME_ID); // &count=10 is default
-
-#if defined(PLATFORM_WEB)
-    if (mgr->globalScoresFetching) return;
-    mgr->globalScoresFetching = true;
-
-    // arrange for callbacks to reference this manager
-    s_lb_for_callbacks = mgr;
+    char url[HTTP_URL_LENGTH];
+    snprintf(url, sizeof(url), "%s?action=topScores&gameID=%d", mgr->baseUrl,
+             LEADERBOARD_GAME_ID); // &count=10 is default
 
-    emscripten_fetch_attr_t attr;
-    emscripten_fetch_attr_init(&attr);
-    strcpy(attr.requestMethod, "GET");
-    attr.attributes = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY;
-    attr.onsuccess = onGlobalScoresSuccess;
-    attr.onerror = onFetchFailure;
-
-    emscripten_fetch(&attr, url);
-#else
     if (mgr->globalScoresFetching) return;
-    mgr->globalScoresFetching = true;
-
-    MemoryStruct chunk;
-    if (!CurlGetToMemory(url, &chunk)) {
-        fprintf(stderr, "Failed to fetch global scores from URL: %s\n", url);
-        mgr->globalScoresFetching = false;
-    }
-    else {
-        printf("Global scores fetched successfully.\n");
-        ParseGlobalScores(chunk.memory, chunk.size, mgr->globalTop10, &mgr->globalScoresFetched,
-                          &mgr->globalScoresFetching);
-        free(chunk.memory);
-    }
-#endif
+    const HttpValidators *conditions = mgr->globalScoresLoaded ? &mgr->globalCache.validators : NULL;
+    if (StartHttpGet(&mgr->globalRequest, url, conditions)) mgr->globalScoresFetching = true;
 }
 
 static void FetchUserTop10(LeaderboardManager *mgr, const char *name)
 {
-    char url[256];
-    sprintf(url, "%s?action=userScores&gameID=%d&userName=%s", LEADERBOARD_BASE_URL, LEADERBOARD_GAME_ID,
-            name); // &count=10 is default
-
-#if defined(PLATFORM_WEB)
-    if (mgr->userScoresFetching) return;
-    mgr->userScoresFetching = true;
+    char url[HTTP_URL_LENGTH];
+    snprintf(url, sizeof(url), "%s?action=userScores&gameID=%d&userName=%s", mgr->baseUrl, LEADERBOARD_GAME_ID,
+             name); // &count=10 is default
 
-    // arrange for callbacks to reference this manager
-    s_lb_for_callbacks = mgr;
-
-    emscripten_fetch_attr_t attr;
-    emscripten_fetch_attr_init(&attr);
-    strcpy(attr.requestMethod, "GET");
-    attr.attributes = EMSCRIPTEN_FETCH_LOAD_TO_MEMORY;
-    attr.onsuccess = onUserScoresSuccess;
-    attr.onerror = onFetchFailure;
-
-    emscripten_fetch(&attr, url);
-#else
     if (mgr->userScoresFetching) return;
-    mgr->userScoresFetching = true;
-
-    MemoryStruct chunk;
-    if (!CurlGetToMemory(url, &chunk)) {
-        fprintf(stderr, "Failed to fetch user scores from URL: %s\n", url);
-        mgr->userScoresFetching = false;
-    }
-    else {
-        printf("User scores fetched successfully.\n");
-        ParseUserScores(chunk.memory, chunk.size, mgr->userTop10, &mgr->userScoresFetched, &mgr->userScoresFetching);
-        free(chunk.memory);
+    if (strcmp(mgr->userCache.name, name) != 0) {
+        // Someone else's scores: not worth showing or revalidating
+        memset(&mgr->userCache, 0, sizeof(mgr->userCache));
+        snprintf(mgr->userCache.name, sizeof(mgr->userCache.name), "%s", name);
+        memset(mgr->userTop10, 0, sizeof(mgr->userTop10));
+        mgr->userScoresLoaded = false;
+        mgr->userFetchTime = -1.0;
+        MergeQueuedScores(mgr);
     }
-#endif
-}
-
-static void RequestLeaderboardUpdate(void)
-{
-    if (s_lb_for_callbacks) s_lb_for_callbacks->requestUpdate = true;
+    const HttpValidators *conditions = mgr->userScoresLoaded ? &mgr->userCache.validators : NULL;
+    if (StartHttpGet(&mgr->userRequest, url, conditions)) mgr->userScoresFetching = true;
 }
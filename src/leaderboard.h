@@ -2,18 +2,29 @@
 #define LEADERBOARD_H
 
 #include "config.h"
+#include "http.h"
+#include "leaderboard_parse.h"
 #include "raylib.h"
+#include "scoreboard.h"
+#include "scorequeue.h"
+#include <stdint.h>
 
-typedef struct {
-    char name[LEADERBOARD_NAME_LENGTH + 1];
-    int score;
-} LeaderboardEntry;
+// The response a score list was last loaded from; persisted with it so the list can be shown
+// at once on the next run and revalidated with a conditional GET
+typedef struct LeaderboardCache {
+    char name[LEADERBOARD_NAME_LENGTH + 1]; // Player the list belongs to (user scores), "" for global
+    HttpValidators validators;              // ETag / Last-Modified of the response
+    uint64_t bodyHash;                      // Hash of the response body, to skip re-parsing an unchanged one
+} LeaderboardCache;
 
 // Encapsulated leaderboard manager to avoid file-level globals.
 typedef struct LeaderboardManager {
     LeaderboardEntry globalTop10[LEADERBOARD_MAX_SCORES];
     LeaderboardEntry userTop10[LEADERBOARD_MAX_SCORES];
     char playerName[LEADERBOARD_NAME_LENGTH + 1];
+    char baseUrl[HTTP_URL_LENGTH]; // Leaderboard service: LEADERBOARD_BASE_URL unless overridden
+    char globalCacheName[32];      // Storage items of the cached lists (per service)
+    char userCacheName[32];
 
     bool isActive;
     bool scoreSubmitted;
@@ -23,6 +34,36 @@ typedef struct LeaderboardManager {
     bool userScoresFetching;
     bool requestUpdate;
 
+    // Loaded: the list holds scores to show, from the on-disk cache or a fetch. Fetched only
+    // says the list was revalidated since the last ResetLeaderboardFlags.
+    bool globalScoresLoaded;
+    bool userScoresLoaded;
+    LeaderboardCache globalCache;
+    LeaderboardCache userCache;
+    HttpRequest globalRequest;
+    HttpRequest userRequest;
+    double globalFetchTime; // GetTime() of the list's last revalidation, -1 if it needs one
+    double userFetchTime;
+    int globalFailures;     // Failed fetches in a row while the list had nothing to show
+    int userFailures;
+    double globalRetryTime; // UpdateLeaderboard doesn't refetch the list before this GetTime()
+    double userRetryTime;
+    double prefetchTime; // GetTime() of the last PrefetchLeaderboard that started a fetch, or -1
+    ScoreQueue scoreQueue; // Scores waiting to be submitted
+
+    // Global board in the scrolling list: the top 10, then pages fetched as it is scrolled
+    ScoreBoard board;
+    HttpRequest pageRequest;
+    int boardOffset;      // Rows requested so far; the next page starts here
+    bool boardComplete;   // No more pages: end of the board, LEADERBOARD_BOARD_MAX_ROWS, or given up
+    bool boardWanted;     // The list was scrolled since the leaderboard opened
+    bool pageFetching;
+    int pageFailures;     // Failed page fetches in a row
+    double pageRetryTime; // No page is fetched before this GetTime()
+    float boardScroll;    // Row at the top of the list (fractional while dragged)
+    bool listPressed;     // The mouse button went down on the leaderboard and is still down
+    float dragDistance;   // Pixels dragged since then, to tell a drag from a click
+
     Rectangle upArrows[LEADERBOARD_NAME_LENGTH];
     Rectangle downArrows[LEADERBOARD_NAME_LENGTH];
     Rectangle charBoxes[LEADERBOARD_NAME_LENGTH];
@@ -34,8 +75,10 @@ typedef struct LeaderboardManager {
 // Public Functions
 
 // DrawLeaderboard - Implementation Notes:
-// - Renders the global top 10 and the user's best scores when available
-// - Shows a loading message while data is being fetched
+// - Renders the global board as a scrolling list and the user's best scores when available,
+//   including cached ones still being revalidated
+// - Draws only the rows in view, so a board of thousands of rows costs the same as the top 10
+// - Shows a loading message while there is nothing to show yet
 // - Centers and formats text for the current screen resolution
 void DrawLeaderboard(const LeaderboardManager *mgr);
 
@@ -46,13 +89,36 @@ void DrawNameInput(LeaderboardManager *mgr);
 
 // InitLeaderboard - Implementation Notes:
 // - Initializes UI rectangles, default player initials, and state flags
-// - Loads saved player name from persistent storage (platform-specific)
+// - Uses the service named by LEADERBOARD_URL_ENV instead of LEADERBOARD_BASE_URL when set
+// - Loads saved player name and cached score lists from persistent storage (platform-specific)
 void InitLeaderboard(LeaderboardManager *mgr);
 
+// Stop every request in flight, waiting for it, and free the board and HTTP state
+//
+// Call before mgr goes out of scope at shutdown.
+void UnloadLeaderboard(LeaderboardManager *mgr);
+
 // ResetLeaderboardFlags - Implementation Notes:
-// - Clears fetched/submitted flags so the UI will request fresh data
+// - Clears the submitted flag, and the fetched flag of each list not revalidated within
+//   LEADERBOARD_FRESH_TIME, so the UI revalidates those (cached lists stay shown)
+// - Clears fetch failures, so lists given up on are tried again
+// - Empties the board down to the top 10 and scrolls it back to the top
 void ResetLeaderboardFlags(LeaderboardManager *mgr);
 
+// PrefetchLeaderboard - Implementation Notes:
+// - Call each frame while the player is between games (title screen, game over, name
+//   entry) so the lists are current by the time the leaderboard opens
+// - Revalidates lists that are not fresh, at most once per LEADERBOARD_FRESH_TIME; does
+//   nothing while the leaderboard is on screen
+void PrefetchLeaderboard(LeaderboardManager *mgr);
+
+// PollLeaderboard - Implementation Notes:
+// - Call once per frame in every state: collects finished list fetches and keeps the
+//   score submission queue flushing in the background
+// - Requests a leaderboard update once the service accepts a queued score
+// - Returns true when a request finished, so a static screen can redraw what it shows
+bool PollLeaderboard(LeaderboardManager *mgr);
+
 // SetLeaderboardActive - Implementation Notes:
 // - Sets the active/inactive state of the leaderboard UI
 // - Caller can use this to show or hide the leaderboard
@@ -60,15 +126,26 @@ void ResetLeaderboardFlags(LeaderboardManager *mgr);
 void SetLeaderboardActive(LeaderboardManager *mgr, bool active);
 
 // SubmitScore - Implementation Notes:
-// - Submits the provided score to the remote leaderboard service
-// - Uses platform-specific HTTP code (emscripten fetch on web, libcurl on native)
-// - On success, marks scoreSubmitted and requests a leaderboard update
+// - Journals the score for submission by PollLeaderboard and returns without waiting
+// - Merges it into the local global and user lists so it shows straight away; with freshly
+//   prefetched lists that is the board as it will be after the submission, so the
+//   leaderboard needs no fetch until the service accepts the score
+// - Marks scoreSubmitted once the score is queued
 // @param score The score value to submit
 void SubmitScore(LeaderboardManager *mgr, int score);
 
 // UpdateLeaderboard - Implementation Notes:
-// - Polls for updates and triggers network fetches for global/user scores
-// - Handles input to close the leaderboard (Enter or click)
+// - Starts background fetches for global/user scores (PollLeaderboard collects them)
+// - A 304 or an unchanged body keeps the current list without re-parsing it; a new list is
+//   parsed and written to the cache
+// - A list with nothing to show is refetched after a failure (no response, or 408, 429 or
+//   5xx), with jittered exponential backoff, up to LEADERBOARD_FETCH_MAX_RETRIES times;
+//   then it is shown as unavailable
+// - Scrolls the list with the mouse wheel, arrow, Page Up/Down, Home and End keys or by
+//   dragging; once scrolled, fetches further pages of LEADERBOARD_PAGE_SIZE rows while the
+//   view is within a screenful of the last row
+// - Handles input to close the leaderboard (Enter, or a click that is not a drag),
+//   cancelling fetches in flight
 void UpdateLeaderboard(LeaderboardManager *mgr, int *gameState);
 
 // UpdateNameInput - Implementation Notes:
@@ -0,0 +1,821 @@
+//================================================================================================
+//
+//   leaderboard_parse.c - Leaderboard API response parsing implementation
+//
+//   See leaderboard_parse.h for module interface documentation.
+//
+//   Implementation notes:
+//   - Streaming: a byte-at-a-time JSON state machine. Entries are the objects directly
+//     inside the top-level array (or object, which cJSON iterates the same way); their
+//     fields are picked out as values complete and the entry is stored when its object
+//     closes. The whole body is still validated, so the result is -1 for the bodies cJSON
+//     rejects
+//   - Streaming follows cJSON where JSON leaves room: text after the root value is
+//     ignored, control characters in strings are accepted, for repeated keys the first
+//     one counts, a \u escape with a non-hex digit decodes as U+0000, and a true userScores
+//     value counts as 1. tools/parsecheck.c checks that the two parsers agree
+//   - Tree: cJSON parses the whole body, then the first entries are copied out
+//   - Pages skip the duplicate scan: a board receiving thousands of entries checks them
+//     against its own hash set instead
+//   - Arena: while a tree parse runs, the cJSON hooks hand out memory from the thread's
+//     block, so freeing the tree is a reset. Allocations that don't fit fall back to
+//     malloc; only then is the tree walked to free them, and the block is grown for next
+//     time. The block is thread-local, but that does not make tree parses thread-safe:
+//     cJSON_ParseWithLengthOpts always writes cJSON's global error slot, so tree parses
+//     must not overlap (see leaderboard_parse.h)
+//   - Names longer than LEADERBOARD_NAME_LENGTH are truncated
+//
+//================================================================================================
+
+#include "leaderboard_parse.h"
+#include "cJSON.h"
+#include "config.h"
+#include <limits.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+// What the streaming tokenizer expects next
+enum {
+    SCORES_PARSE_VALUE,               // A value
+    SCORES_PARSE_VALUE_OR_END,        // A value or ']' (just after '[')
+    SCORES_PARSE_KEY,                 // A member key (after ',' in an object)
+    SCORES_PARSE_KEY_OR_END,          // A member key or '}' (just after '{')
+    SCORES_PARSE_COLON,               // ':' after a key
+    SCORES_PARSE_AFTER_VALUE,         // ',' or the end of the enclosing container
+    SCORES_PARSE_STRING,              // String characters up to the closing quote
+    SCORES_PARSE_ESCAPE,              // The character after a backslash
+    SCORES_PARSE_UNICODE,             // Hex digits of a \u escape
+    SCORES_PARSE_SURROGATE_BACKSLASH, // '\' starting the second half of a surrogate pair
+    SCORES_PARSE_SURROGATE_U,         // 'u' of the second half of a surrogate pair
+    SCORES_PARSE_NUMBER,              // Number characters
+    SCORES_PARSE_LITERAL,             // The rest of true, false or null
+    SCORES_PARSE_DONE                 // Root value complete; anything after it is ignored
+};
+
+// Entry field the next value in an entry object belongs to
+enum { SCORES_FIELD_NONE, SCORES_FIELD_NAME, SCORES_FIELD_SCORE, SCORES_FIELD_FIRST };
+
+// Kind of a completed value, as far as entries care
+enum { SCORES_VALUE_STRING, SCORES_VALUE_NUMBER, SCORES_VALUE_TRUE, SCORES_VALUE_OTHER };
+
+// Arena allocation alignment (enough for any cJSON field)
+#define PARSE_ARENA_ALIGN 16
+
+#if defined(_MSC_VER)
+#define PARSE_THREAD_LOCAL __declspec(thread)
+#else
+#define PARSE_THREAD_LOCAL __thread
+#endif
+
+// Bump allocator behind the cJSON hooks for one thread
+typedef struct ParseArena {
+    unsigned char *block;
+    size_t capacity;     // Size of block
+    size_t used;         // Bytes handed out in the current parse
+    size_t spilled;      // Bytes that did not fit and came from malloc in the current parse
+    size_t nextCapacity; // Size to allocate when block is NULL
+    bool active;         // A tree parse is running on this thread
+} ParseArena;
+
+static PARSE_THREAD_LOCAL ParseArena s_arena;
+static bool s_arenaEnabled = false; // Set before threads parse; read-only afterwards
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// Parse data, reporting where a syntax error was found
+//
+// @return Parsed tree (caller deletes), or NULL on error
+static cJSON *ParseResponse(const char *data, size_t size);
+
+// Start a tree parse of data, on the thread's arena when enabled
+//
+// @return Parsed tree, or NULL on error; pass a tree to EndTreeParse
+static cJSON *BeginTreeParse(const char *data, size_t size);
+
+// Free a tree from BeginTreeParse and reset the arena
+static void EndTreeParse(cJSON *json);
+
+// cJSON allocation hooks
+static void *ArenaAllocate(size_t size);
+static void ArenaFree(void *pointer);
+
+// Run a whole body through the streaming parser
+static int ParseStream(const char *data, size_t size, bool userScores, LeaderboardEntry *entries);
+
+// Streaming ParseScoresPage
+static int ParsePageStream(const char *data, size_t size, ScoresEntryCallback onEntry, void *context);
+
+// Handle one character
+//
+// @return false if the character ended a number and must be seen again in the new state
+static bool ParseChar(ScoresParser *parser, unsigned char c);
+
+// Start the value beginning with c
+static void StartValue(ScoresParser *parser, unsigned char c);
+
+// Open or close an array/object
+static void PushContainer(ScoresParser *parser, bool object);
+static void PopContainer(ScoresParser *parser);
+
+// A scalar value is complete
+static void CompleteValue(ScoresParser *parser, int kind);
+
+// Validate and convert the number in token, then complete it
+static void EndNumber(ScoresParser *parser);
+
+// Add decoded string bytes to token (bytes past its capacity are dropped)
+static void AppendToken(ScoresParser *parser, const char *bytes, size_t count);
+
+// Add a code point to token as UTF-8
+static void AppendCodePoint(ScoresParser *parser, uint32_t codePoint);
+
+// The string in token is complete: a key or a value
+static void EndString(ScoresParser *parser);
+
+// True while the parser is directly inside an entry object
+static bool InEntry(const ScoresParser *parser);
+
+// Entry object events
+static void BeginEntry(ScoresParser *parser);
+static void OnEntryKey(ScoresParser *parser);
+static void OnEntryValue(ScoresParser *parser, int kind);
+static void EndEntry(ScoresParser *parser);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see leaderboard_parse.h for documentation)
+//----------------------------------------------------------------------------------
+
+int ParseGlobalScores(const char *data, size_t size, LeaderboardEntry *entries)
+{
+#if LEADERBOARD_STREAM_PARSER
+    return ParseStream(data, size, false, entries);
+#else
+    return ParseGlobalScoresTree(data, size, entries);
+#endif
+}
+
+int ParseUserScores(const char *data, size_t size, LeaderboardEntry *entries)
+{
+#if LEADERBOARD_STREAM_PARSER
+    return ParseStream(data, size, true, entries);
+#else
+    return ParseUserScoresTree(data, size, entries);
+#endif
+}
+
+int ParseScoresPage(const char *data, size_t size, ScoresEntryCallback onEntry, void *context)
+{
+#if LEADERBOARD_STREAM_PARSER
+    return ParsePageStream(data, size, onEntry, context);
+#else
+    return ParseScoresPageTree(data, size, onEntry, context);
+#endif
+}
+
+int ParseGlobalScoresTree(const char *data, size_t size, LeaderboardEntry *entries)
+{
+    memset(entries, 0, sizeof(LeaderboardEntry) * LEADERBOARD_MAX_SCORES);
+    cJSON *json = BeginTreeParse(data, size);
+    if (json == NULL) return -1;
+
+    int entryIndex = 0;
+    const cJSON *item;
+    cJSON_ArrayForEach(item, json)
+    {
+        if (entryIndex == LEADERBOARD_MAX_SCORES) break;
+        const cJSON *name = cJSON_GetObjectItemCaseSensitive(item, "userName");
+        const cJSON *score = cJSON_GetObjectItemCaseSensitive(item, "score");
+
+        if (cJSON_IsString(name) && (name->valuestring != NULL) && cJSON_IsNumber(score)) {
+            // Compare as stored: truncated name, saturated score
+            char entryName[LEADERBOARD_NAME_LENGTH + 1];
+            strncpy(entryName, name->valuestring, LEADERBOARD_NAME_LENGTH);
+            entryName[LEADERBOARD_NAME_LENGTH] = '\0';
+
+            // Check if this (user, score) pair already exists to avoid exact duplicates
+            bool isDuplicate = false;
+            for (int j = 0; j < entryIndex; j++) {
+                if (strcmp(entries[j].name, entryName) == 0 && entries[j].score == score->valueint) {
+                    isDuplicate = true;
+                    break;
+                }
+            }
+
+            if (!isDuplicate) {
+                memcpy(entries[entryIndex].name, entryName, sizeof(entryName));
+                entries[entryIndex].score = score->valueint;
+                entryIndex++;
+            }
+        }
+    }
+
+    EndTreeParse(json);
+    return entryIndex;
+}
+
+int ParseUserScoresTree(const char *data, size_t size, LeaderboardEntry *entries)
+{
+    memset(entries, 0, sizeof(LeaderboardEntry) * LEADERBOARD_MAX_SCORES);
+    cJSON *json = BeginTreeParse(data, size);
+    if (json == NULL) return -1;
+
+    int entryIndex = 0;
+    const cJSON *item;
+    cJSON_ArrayForEach(item, json)
+    {
+        if (entryIndex == LEADERBOARD_MAX_SCORES) break;
+        if (item->child != NULL && item->child->string != NULL) {
+            strncpy(entries[entryIndex].name, item->child->string, LEADERBOARD_NAME_LENGTH);
+            entries[entryIndex].name[LEADERBOARD_NAME_LENGTH] = '\0';
+            entries[entryIndex].score = item->child->valueint;
+            entryIndex++;
+        }
+    }
+
+    EndTreeParse(json);
+    return entryIndex;
+}
+
+int ParseScoresPageTree(const char *data, size_t size, ScoresEntryCallback onEntry, void *context)
+{
+    cJSON *json = BeginTreeParse(data, size);
+    if (json == NULL) return -1;
+
+    int entryCount = 0;
+    const cJSON *item;
+    cJSON_ArrayForEach(item, json)
+    {
+        const cJSON *name = cJSON_GetObjectItemCaseSensitive(item, "userName");
+        const cJSON *score = cJSON_GetObjectItemCaseSensitive(item, "score");
+        if (cJSON_IsString(name) && (name->valuestring != NULL) && cJSON_IsNumber(score)) {
+            char entryName[LEADERBOARD_NAME_LENGTH + 1];
+            strncpy(entryName, name->valuestring, LEADERBOARD_NAME_LENGTH);
+            entryName[LEADERBOARD_NAME_LENGTH] = '\0';
+            onEntry(context, entryName, score->valueint);
+            entryCount++;
+        }
+    }
+
+    EndTreeParse(json);
+    return entryCount;
+}
+
+void SetParseArenaEnabled(bool enabled)
+{
+    cJSON_Hooks hooks = {ArenaAllocate, ArenaFree};
+    cJSON_InitHooks(enabled ? &hooks : NULL);
+    s_arenaEnabled = enabled;
+}
+
+void ReleaseParseArena(void)
+{
+    free(s_arena.block);
+    memset(&s_arena, 0, sizeof(s_arena));
+}
+
+void InitScoresParser(ScoresParser *parser, bool userScores, LeaderboardEntry *entries)
+{
+    memset(parser, 0, sizeof(*parser));
+    parser->entries = entries;
+    parser->userScores = userScores;
+    parser->state = SCORES_PARSE_VALUE;
+    memset(entries, 0, sizeof(LeaderboardEntry) * LEADERBOARD_MAX_SCORES);
+}
+
+void InitScoresPageParser(ScoresParser *parser, ScoresEntryCallback onEntry, void *context)
+{
+    memset(parser, 0, sizeof(*parser));
+    parser->onEntry = onEntry;
+    parser->context = context;
+    parser->state = SCORES_PARSE_VALUE;
+}
+
+//----------------------------------------------------------------------------------
+// FeedScoresParser - Implementation Notes:
+// - Whitespace and plain string characters are consumed in runs; everything else goes
+//   through ParseChar one character at a time
+//----------------------------------------------------------------------------------
+bool FeedScoresParser(ScoresParser *parser, const char *data, size_t size)
+{
+    size_t i = 0;
+    while (i < size && !parser->failed && parser->state != SCORES_PARSE_DONE) {
+        if (parser->state == SCORES_PARSE_STRING && !parser->scanEscaped) {
+            size_t run = i;
+            while (run < size && data[run] != '"' && data[run] != '\\') run++;
+            AppendToken(parser, data + i, run - i);
+            i = run;
+            if (i == size) break;
+            if (data[i] == '"') {
+                EndString(parser); // The common closing quote, without ParseChar's string checks
+                i++;
+                continue;
+            }
+        }
+        else if ((unsigned char)data[i] <= ' ' && parser->state <= SCORES_PARSE_AFTER_VALUE) {
+            i++; // Whitespace between tokens
+            continue;
+        }
+        if (ParseChar(parser, (unsigned char)data[i])) i++;
+    }
+    return !parser->failed;
+}
+
+int FinishScoresParser(ScoresParser *parser)
+{
+    if (!parser->failed && parser->state == SCORES_PARSE_NUMBER && parser->depth == 0) EndNumber(parser);
+    if (parser->failed || parser->state != SCORES_PARSE_DONE) return -1;
+    return parser->count;
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static cJSON *ParseResponse(const char *data, size_t size)
+{
+    // The error position comes back through parseEnd rather than cJSON_GetErrorPtr, which
+    // a later parse would overwrite
+    const char *parseEnd = NULL;
+    cJSON *json = cJSON_ParseWithLengthOpts(data, size, &parseEnd, false);
+    if (json == NULL && parseEnd != NULL) {
+        fprintf(stderr, "Error before: %.*s\n", (int)(size - (size_t)(parseEnd - data)), parseEnd);
+    }
+    return json;
+}
+
+static cJSON *BeginTreeParse(const char *data, size_t size)
+{
+    if (s_arenaEnabled) {
+        if (s_arena.block == NULL) {
+            if (s_arena.nextCapacity == 0) s_arena.nextCapacity = PARSE_ARENA_MIN_SIZE;
+            s_arena.block = malloc(s_arena.nextCapacity);
+            s_arena.capacity = (s_arena.block != NULL) ? s_arena.nextCapacity : 0;
+        }
+        s_arena.used = 0;
+        s_arena.spilled = 0;
+        s_arena.active = true;
+    }
+    cJSON *json = ParseResponse(data, size);
+    if (json == NULL) EndTreeParse(NULL);
+    return json;
+}
+
+static void EndTreeParse(cJSON *json)
+{
+    if (!s_arena.active) {
+        cJSON_Delete(json);
+        return;
+    }
+    if (s_arena.spilled > 0) {
+        cJSON_Delete(json); // ArenaFree skips the nodes in the block
+        // Grow so a tree this size fits next time, up to the limit
+        size_t needed = s_arena.used + s_arena.spilled;
+        size_t capacity = s_arena.capacity > 0 ? s_arena.capacity : PARSE_ARENA_MIN_SIZE;
+        while (capacity < needed && capacity < PARSE_ARENA_MAX_SIZE) capacity *= 2;
+        if (capacity > PARSE_ARENA_MAX_SIZE) capacity = PARSE_ARENA_MAX_SIZE;
+        if (capacity > s_arena.capacity) {
+            free(s_arena.block);
+            s_arena.block = NULL;
+            s_arena.capacity = 0;
+            s_arena.nextCapacity = capacity;
+        }
+    }
+    s_arena.used = 0;
+    s_arena.spilled = 0;
+    s_arena.active = false;
+}
+
+static void *ArenaAllocate(size_t size)
+{
+    if (!s_arena.active) return malloc(size);
+
+    size_t rounded = (size + PARSE_ARENA_ALIGN - 1) & ~(size_t)(PARSE_ARENA_ALIGN - 1);
+    if (rounded <= s_arena.capacity - s_arena.used) {
+        void *pointer = s_arena.block + s_arena.used;
+        s_arena.used += rounded;
+        return pointer;
+    }
+    s_arena.spilled += rounded;
+    return malloc(size);
+}
+
+static void ArenaFree(void *pointer)
+{
+    unsigned char *bytes = (unsigned char *)pointer;
+    if (s_arena.block != NULL && bytes >= s_arena.block && bytes < s_arena.block + s_arena.capacity) return;
+    free(pointer);
+}
+
+static int ParseStream(const char *data, size_t size, bool userScores, LeaderboardEntry *entries)
+{
+    ScoresParser parser;
+    InitScoresParser(&parser, userScores, entries);
+    FeedScoresParser(&parser, data, size);
+    int count = FinishScoresParser(&parser);
+    if (count < 0) fprintf(stderr, "Invalid JSON in leaderboard response\n");
+    return count;
+}
+
+static int ParsePageStream(const char *data, size_t size, ScoresEntryCallback onEntry, void *context)
+{
+    ScoresParser parser;
+    InitScoresPageParser(&parser, onEntry, context);
+    FeedScoresParser(&parser, data, size);
+    int count = FinishScoresParser(&parser);
+    if (count < 0) fprintf(stderr, "Invalid JSON in leaderboard response\n");
+    return count;
+}
+
+static bool ParseChar(ScoresParser *parser, unsigned char c)
+{
+    // Where a string ends is decided as cJSON's scan decides it: at the first quote not
+    // right after an escaping backslash, even if decoding escapes lines up differently
+    bool stringEnds = false;
+    if (parser->state >= SCORES_PARSE_STRING && parser->state <= SCORES_PARSE_SURROGATE_U) {
+        stringEnds = (c == '"' && !parser->scanEscaped);
+        parser->scanEscaped = (c == '\\' && !parser->scanEscaped);
+    }
+
+    switch (parser->state) {
+    case SCORES_PARSE_VALUE_OR_END:
+        if (c == ']') {
+            PopContainer(parser);
+            break;
+        }
+        StartValue(parser, c);
+        break;
+    case SCORES_PARSE_VALUE:
+        StartValue(parser, c);
+        break;
+    case SCORES_PARSE_KEY_OR_END:
+    case SCORES_PARSE_KEY:
+        if (c == '}' && parser->state == SCORES_PARSE_KEY_OR_END) {
+            PopContainer(parser);
+        }
+        else if (c == '"') {
+            parser->tokenLength = 0;
+            parser->token[0] = '\0';
+            parser->tokenTruncated = false;
+            parser->tokenIsKey = true;
+            parser->scanEscaped = false;
+            parser->state = SCORES_PARSE_STRING;
+        }
+        else {
+            parser->failed = true;
+        }
+        break;
+    case SCORES_PARSE_COLON:
+        if (c == ':')
+            parser->state = SCORES_PARSE_VALUE;
+        else
+            parser->failed = true;
+        break;
+    case SCORES_PARSE_AFTER_VALUE: {
+        bool inObject = (parser->objectMask >> (parser->depth - 1)) & 1;
+        if (c == ',')
+            parser->state = inObject ? SCORES_PARSE_KEY : SCORES_PARSE_VALUE;
+        else if (c == (inObject ? '}' : ']'))
+            PopContainer(parser);
+        else
+            parser->failed = true;
+    } break;
+    case SCORES_PARSE_STRING:
+        if (stringEnds)
+            EndString(parser);
+        else if (c == '\\')
+            parser->state = SCORES_PARSE_ESCAPE;
+        else
+            AppendToken(parser, (const char *)&c, 1); // A quote the scan took as escaped
+        break;
+    case SCORES_PARSE_ESCAPE: {
+        if (stringEnds) {
+            // cJSON decodes the closing quote as the escaped character and ends the string
+            AppendToken(parser, "\"", 1);
+            EndString(parser);
+            break;
+        }
+        static const char escapes[] = "\"\"\\\\//b\bf\fn\nr\rt\t";
+        const char *e = NULL;
+        for (int k = 0; escapes[k] != '\0'; k += 2) {
+            if (escapes[k] == (char)c) e = &escapes[k + 1];
+        }
+        if (e != NULL) {
+            AppendToken(parser, e, 1);
+            parser->state = SCORES_PARSE_STRING;
+        }
+        else if (c == 'u') {
+            parser->codePoint = 0;
+            parser->hexDigits = 0;
+            parser->hexInvalid = false;
+            parser->state = SCORES_PARSE_UNICODE;
+        }
+        else {
+            parser->failed = true;
+        }
+    } break;
+    case SCORES_PARSE_UNICODE: {
+        int digit = (c >= '0' && c <= '9') ? c - '0'
+                    : (c >= 'a' && c <= 'f') ? c - 'a' + 10
+                    : (c >= 'A' && c <= 'F') ? c - 'A' + 10
+                                             : -1;
+        if (stringEnds) {
+            parser->failed = true; // cJSON needs the whole escape before the closing quote
+            break;
+        }
+        if (digit < 0)
+            parser->hexInvalid = true;
+        else
+            parser->codePoint = parser->codePoint * 16 + (uint32_t)digit;
+        if (++parser->hexDigits < 4) break;
+
+        uint32_t cp = parser->hexInvalid ? 0 : parser->codePoint; // cJSON reads bad hex as 0
+        parser->state = SCORES_PARSE_STRING;
+        if (parser->highSurrogate != 0) {
+            if (cp < 0xDC00 || cp > 0xDFFF) {
+                parser->failed = true;
+                break;
+            }
+            AppendCodePoint(parser, 0x10000 + ((parser->highSurrogate - 0xD800) << 10) + (cp - 0xDC00));
+            parser->highSurrogate = 0;
+        }
+        else if (cp >= 0xD800 && cp <= 0xDBFF) {
+            parser->highSurrogate = cp;
+            parser->state = SCORES_PARSE_SURROGATE_BACKSLASH;
+        }
+        else if (cp >= 0xDC00 && cp <= 0xDFFF) {
+            parser->failed = true; // Second half without a first
+        }
+        else {
+            AppendCodePoint(parser, cp);
+        }
+    } break;
+    case SCORES_PARSE_SURROGATE_BACKSLASH:
+        if (c == '\\')
+            parser->state = SCORES_PARSE_SURROGATE_U;
+        else
+            parser->failed = true;
+        break;
+    case SCORES_PARSE_SURROGATE_U:
+        if (c == 'u') {
+            parser->codePoint = 0;
+            parser->hexDigits = 0;
+            parser->hexInvalid = false;
+            parser->state = SCORES_PARSE_UNICODE;
+        }
+        else {
+            parser->failed = true;
+        }
+        break;
+    case SCORES_PARSE_NUMBER:
+        if ((c >= '0' && c <= '9') || c == '-' || c == '+' || c == '.' || c == 'e' || c == 'E') {
+            if (parser->tokenLength == SCORES_PARSER_TOKEN_LENGTH - 1) {
+                // cJSON reads at most 63 number characters too, leaving the rest as the next token
+                if (parser->depth == 0)
+                    EndNumber(parser);
+                else
+                    parser->failed = true;
+                break;
+            }
+            parser->token[parser->tokenLength++] = (char)c;
+            break;
+        }
+        EndNumber(parser);
+        return false;
+    case SCORES_PARSE_LITERAL:
+        if ((char)c != parser->literal[parser->literalIndex]) {
+            parser->failed = true;
+            break;
+        }
+        if (parser->literal[++parser->literalIndex] == '\0') {
+            CompleteValue(parser, (parser->literal[0] == 't') ? SCORES_VALUE_TRUE : SCORES_VALUE_OTHER);
+        }
+        break;
+    default:
+        break;
+    }
+    return true;
+}
+
+static void StartValue(ScoresParser *parser, unsigned char c)
+{
+    if (c == '"') {
+        parser->tokenLength = 0;
+        parser->token[0] = '\0';
+        parser->tokenTruncated = false;
+        parser->tokenIsKey = false;
+        parser->scanEscaped = false;
+        parser->state = SCORES_PARSE_STRING;
+    }
+    else if (c == '{' || c == '[') {
+        PushContainer(parser, c == '{');
+    }
+    else if (c == '-' || (c >= '0' && c <= '9')) {
+        parser->token[0] = (char)c;
+        parser->tokenLength = 1;
+        parser->state = SCORES_PARSE_NUMBER;
+    }
+    else if (c == 't' || c == 'f' || c == 'n') {
+        parser->literal = (c == 't') ? "true" : (c == 'f') ? "false" : "null";
+        parser->literalIndex = 1;
+        parser->state = SCORES_PARSE_LITERAL;
+    }
+    else {
+        parser->failed = true;
+    }
+}
+
+static void PushContainer(ScoresParser *parser, bool object)
+{
+    if (parser->depth == SCORES_PARSER_MAX_DEPTH) {
+        parser->failed = true;
+        return;
+    }
+    if (InEntry(parser)) OnEntryValue(parser, SCORES_VALUE_OTHER);
+
+    uint64_t bit = (uint64_t)1 << parser->depth;
+    parser->objectMask = object ? (parser->objectMask | bit) : (parser->objectMask & ~bit);
+    parser->depth++;
+    parser->state = object ? SCORES_PARSE_KEY_OR_END : SCORES_PARSE_VALUE_OR_END;
+    if (InEntry(parser)) BeginEntry(parser);
+}
+
+static void PopContainer(ScoresParser *parser)
+{
+    if (InEntry(parser)) EndEntry(parser);
+    parser->depth--;
+    parser->state = (parser->depth == 0) ? SCORES_PARSE_DONE : SCORES_PARSE_AFTER_VALUE;
+}
+
+static void CompleteValue(ScoresParser *parser, int kind)
+{
+    if (parser->depth == 0) {
+        parser->state = SCORES_PARSE_DONE;
+        return;
+    }
+    if (InEntry(parser)) OnEntryValue(parser, kind);
+    parser->state = SCORES_PARSE_AFTER_VALUE;
+}
+
+static void EndNumber(ScoresParser *parser)
+{
+    char *end;
+    parser->token[parser->tokenLength] = '\0';
+    parser->number = strtod(parser->token, &end);
+    // Leftover number characters can't follow a value inside a container; after a root
+    // number they are trailing text, which is ignored
+    bool complete = (parser->depth == 0) ? end != parser->token : end == parser->token + parser->tokenLength;
+    if (!complete) {
+        parser->failed = true;
+        return;
+    }
+    CompleteValue(parser, SCORES_VALUE_NUMBER);
+}
+
+static void AppendToken(ScoresParser *parser, const char *bytes, size_t count)
+{
+    size_t room = (size_t)(SCORES_PARSER_TOKEN_LENGTH - 1 - parser->tokenLength);
+    if (count > room) {
+        count = room;
+        parser->tokenTruncated = true;
+    }
+    memcpy(parser->token + parser->tokenLength, bytes, count);
+    parser->tokenLength += (int)count;
+    parser->token[parser->tokenLength] = '\0';
+}
+
+static void AppendCodePoint(ScoresParser *parser, uint32_t codePoint)
+{
+    char utf8[4];
+    size_t length;
+    if (codePoint < 0x80) {
+        utf8[0] = (char)codePoint;
+        length = 1;
+    }
+    else if (codePoint < 0x800) {
+        utf8[0] = (char)(0xC0 | (codePoint >> 6));
+        utf8[1] = (char)(0x80 | (codePoint & 0x3F));
+        length = 2;
+    }
+    else if (codePoint < 0x10000) {
+        utf8[0] = (char)(0xE0 | (codePoint >> 12));
+        utf8[1] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[2] = (char)(0x80 | (codePoint & 0x3F));
+        length = 3;
+    }
+    else {
+        utf8[0] = (char)(0xF0 | (codePoint >> 18));
+        utf8[1] = (char)(0x80 | ((codePoint >> 12) & 0x3F));
+        utf8[2] = (char)(0x80 | ((codePoint >> 6) & 0x3F));
+        utf8[3] = (char)(0x80 | (codePoint & 0x3F));
+        length = 4;
+    }
+    AppendToken(parser, utf8, length);
+}
+
+static void EndString(ScoresParser *parser)
+{
+    if (parser->tokenIsKey) {
+        if (InEntry(parser)) OnEntryKey(parser);
+        parser->state = SCORES_PARSE_COLON;
+    }
+    else {
+        CompleteValue(parser, SCORES_VALUE_STRING);
+    }
+}
+
+static bool InEntry(const ScoresParser *parser)
+{
+    return parser->depth == 2 && (parser->objectMask & 2) != 0;
+}
+
+static void BeginEntry(ScoresParser *parser)
+{
+    parser->memberIndex = 0;
+    parser->field = SCORES_FIELD_NONE;
+    parser->nameKeySeen = false;
+    parser->scoreKeySeen = false;
+    parser->haveName = false;
+    parser->haveScore = false;
+    parser->name[0] = '\0';
+    parser->score = 0;
+}
+
+//----------------------------------------------------------------------------------
+// OnEntryKey - Implementation Notes:
+// - topScores: the first "userName" and the first "score" member are the fields, as
+//   cJSON_GetObjectItemCaseSensitive finds them
+// - userScores: the first member's key is the name and its value the score
+//----------------------------------------------------------------------------------
+static void OnEntryKey(ScoresParser *parser)
+{
+    parser->field = SCORES_FIELD_NONE;
+    if (parser->userScores) {
+        if (parser->memberIndex == 0) {
+            strncpy(parser->name, parser->token, LEADERBOARD_NAME_LENGTH);
+            parser->name[LEADERBOARD_NAME_LENGTH] = '\0';
+            parser->field = SCORES_FIELD_FIRST;
+        }
+    }
+    else if (!parser->tokenTruncated && strcmp(parser->token, "userName") == 0) {
+        if (!parser->nameKeySeen) parser->field = SCORES_FIELD_NAME;
+        parser->nameKeySeen = true;
+    }
+    else if (!parser->tokenTruncated && strcmp(parser->token, "score") == 0) {
+        if (!parser->scoreKeySeen) parser->field = SCORES_FIELD_SCORE;
+        parser->scoreKeySeen = true;
+    }
+}
+
+static void OnEntryValue(ScoresParser *parser, int kind)
+{
+    // Numbers convert like cJSON's valueint (saturating)
+    int number = 0;
+    if (kind == SCORES_VALUE_NUMBER) {
+        number = (parser->number >= INT_MAX)   ? INT_MAX
+                 : (parser->number <= INT_MIN) ? INT_MIN
+                                               : (int)parser->number;
+    }
+
+    if (parser->field == SCORES_FIELD_NAME && kind == SCORES_VALUE_STRING) {
+        strncpy(parser->name, parser->token, LEADERBOARD_NAME_LENGTH);
+        parser->name[LEADERBOARD_NAME_LENGTH] = '\0';
+        parser->haveName = true;
+    }
+    else if (parser->field == SCORES_FIELD_SCORE && kind == SCORES_VALUE_NUMBER) {
+        parser->score = number;
+        parser->haveScore = true;
+    }
+    else if (parser->field == SCORES_FIELD_FIRST) {
+        // cJSON's valueint of a non-number: 1 for true, otherwise 0
+        parser->score = (kind == SCORES_VALUE_TRUE) ? 1 : number;
+    }
+    parser->field = SCORES_FIELD_NONE;
+    parser->memberIndex++;
+}
+
+static void EndEntry(ScoresParser *parser)
+{
+    if (parser->onEntry == NULL && parser->count == LEADERBOARD_MAX_SCORES) return;
+    if (parser->userScores ? parser->memberIndex == 0 : !(parser->haveName && parser->haveScore)) return;
+
+    if (parser->onEntry != NULL) {
+        parser->onEntry(parser->context, parser->name, parser->score);
+        parser->count++;
+        return;
+    }
+
+    if (!parser->userScores) {
+        // Skip exact (name, score) duplicates
+        for (int j = 0; j < parser->count; j++) {
+            if (parser->entries[j].score == parser->score && strcmp(parser->entries[j].name, parser->name) == 0)
+                return;
+        }
+    }
+    LeaderboardEntry *entry = &parser->entries[parser->count++];
+    memcpy(entry->name, parser->name, sizeof(entry->name));
+    entry->score = parser->score;
+}
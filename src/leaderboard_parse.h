@@ -0,0 +1,153 @@
+//================================================================================================
+//
+//   leaderboard_parse.h - Leaderboard API response parsing for Tailgunner
+//
+//   Turns the JSON bodies returned by the leaderboard service into LeaderboardEntry
+//   arrays. Kept apart from leaderboard.c (network and UI) so it builds without raylib or
+//   an HTTP client, e.g. for the benchmarks.
+//
+//   Two implementations give the same results: a streaming tokenizer that fills entries
+//   as it reads, with no heap allocation and any split of the input into chunks, and the
+//   original cJSON tree walk. LEADERBOARD_STREAM_PARSER in config.h picks the one behind
+//   ParseGlobalScores/ParseUserScores.
+//
+//   Pages of a large board are parsed the same way, but each entry is handed to a
+//   callback rather than stored, so a page of any length needs no entry array.
+//
+//   The streaming parser keeps all of its state in its ScoresParser, so parses may run on
+//   any number of threads at once. The cJSON functions (and ParseGlobalScores and friends
+//   when LEADERBOARD_STREAM_PARSER is 0) may not: the vendored cJSON writes its global
+//   error slot on every parse, so only one thread at a time may use them (the game thread,
+//   in the game).
+//
+//================================================================================================
+
+#ifndef LEADERBOARD_PARSE_H
+#define LEADERBOARD_PARSE_H
+
+#include "config.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+// Longest string kept while streaming: enough to recognise any key the parser looks for;
+// longer strings are still validated but only their start is kept
+#define SCORES_PARSER_TOKEN_LENGTH 64
+// Deepest nesting the streaming parser accepts (deeper input is rejected as invalid)
+#define SCORES_PARSER_MAX_DEPTH 64
+// cJSON parse arena block: first size, and the largest kept between parses (bigger trees
+// spill to malloc)
+#define PARSE_ARENA_MIN_SIZE (16 * 1024)
+#define PARSE_ARENA_MAX_SIZE (1024 * 1024)
+
+typedef struct {
+    char name[LEADERBOARD_NAME_LENGTH + 1];
+    int score;
+} LeaderboardEntry;
+
+// Receives each entry of a page parse, in response order
+typedef void (*ScoresEntryCallback)(void *context, const char *name, int score);
+
+// Streaming parser state; everything needed to resume at the next chunk
+typedef struct ScoresParser {
+    LeaderboardEntry *entries;   // Filled in place, LEADERBOARD_MAX_SCORES of them (NULL for a page)
+    ScoresEntryCallback onEntry; // Page parse: receives every entry instead, uncapped
+    void *context;               // Passed to onEntry
+    bool userScores;             // userScores format rather than topScores
+    int count;                   // Entries filled (page parse: read) so far
+    bool failed;                 // Input is not valid JSON
+
+    // Syntax
+    int state;           // What the tokenizer expects next (SCORES_PARSE_* in leaderboard_parse.c)
+    int depth;           // Open arrays/objects
+    uint64_t objectMask; // Bit d set: the container at depth d + 1 is an object
+
+    // Token in progress
+    char token[SCORES_PARSER_TOKEN_LENGTH]; // Decoded string start, or number text
+    int tokenLength;
+    bool tokenTruncated;
+    bool tokenIsKey;
+    bool scanEscaped;       // The next string character follows an escaping backslash
+    double number;          // Value of the number just read
+    int literalIndex;       // Characters of true/false/null matched
+    const char *literal;    // The literal being matched
+    uint32_t codePoint;     // \u escape being read
+    int hexDigits;          // Hex digits of it read so far
+    bool hexInvalid;        // A non-hex character was among them (the escape then reads as 0)
+    uint32_t highSurrogate; // First half of a surrogate pair, or 0
+
+    // Entry object being read (objects directly inside the top-level container)
+    int memberIndex; // Members completed so far
+    int field;       // Which entry field the next value is (SCORES_FIELD_* in leaderboard_parse.c)
+    bool nameKeySeen, scoreKeySeen;
+    bool haveName, haveScore;
+    char name[LEADERBOARD_NAME_LENGTH + 1];
+    int score;
+} ScoresParser;
+
+//----------------------------------------------------------------------------------
+// Leaderboard Parse Functions
+//----------------------------------------------------------------------------------
+
+// Parse a topScores response: an array of {"userName": ..., "score": ...} objects
+//
+// Clears entries, then fills up to LEADERBOARD_MAX_SCORES of them in response order,
+// skipping exact (name, score) duplicates.
+//
+// @param data,size Response body (need not be NUL-terminated)
+// @return Number of entries filled, or -1 if the body is not valid JSON
+int ParseGlobalScores(const char *data, size_t size, LeaderboardEntry *entries);
+
+// Parse a userScores response: an array of single-member {"<name>": <score>} objects
+//
+// Clears entries, then fills up to LEADERBOARD_MAX_SCORES of them in response order.
+//
+// @param data,size Response body (need not be NUL-terminated)
+// @return Number of entries filled, or -1 if the body is not valid JSON
+int ParseUserScores(const char *data, size_t size, LeaderboardEntry *entries);
+
+// Parse a topScores response page of any length, handing every entry to onEntry
+//
+// Nothing is capped or de-duplicated; that is up to the receiver. The streaming parser
+// hands entries on as their objects close, so a body found to be invalid further on may
+// already have delivered its first entries.
+//
+// @return Number of entries read, or -1 if the body is not valid JSON
+int ParseScoresPage(const char *data, size_t size, ScoresEntryCallback onEntry, void *context);
+
+// cJSON implementations of ParseGlobalScores/ParseUserScores/ParseScoresPage (same contract,
+// except that an invalid page delivers no entries)
+//
+// Not safe to call from two threads at once (see the top of this file).
+int ParseGlobalScoresTree(const char *data, size_t size, LeaderboardEntry *entries);
+int ParseUserScoresTree(const char *data, size_t size, LeaderboardEntry *entries);
+int ParseScoresPageTree(const char *data, size_t size, ScoresEntryCallback onEntry, void *context);
+
+// Allocate cJSON trees from a per-thread bump arena (true) or with malloc/free (false)
+//
+// Installs cJSON's global allocation hooks, so call it before any tree parse starts. Other
+// cJSON use is unaffected: outside a tree parse the hooks are plain malloc/free.
+void SetParseArenaEnabled(bool enabled);
+
+// Free the calling thread's arena block; call before a thread that parsed exits
+void ReleaseParseArena(void);
+
+// Start a streaming parse; clears entries
+//
+// @param userScores true for a userScores response, false for topScores
+void InitScoresParser(ScoresParser *parser, bool userScores, LeaderboardEntry *entries);
+
+// Start a streaming topScores page parse (see ParseScoresPage)
+void InitScoresPageParser(ScoresParser *parser, ScoresEntryCallback onEntry, void *context);
+
+// Parse the next piece of the body; entries fill in as their objects close
+//
+// @return false once the input is known not to be valid JSON (further input is ignored)
+bool FeedScoresParser(ScoresParser *parser, const char *data, size_t size);
+
+// End a streaming parse after the last piece
+//
+// @return Number of entries filled, or -1 if the body was not valid JSON (or was cut short)
+int FinishScoresParser(ScoresParser *parser);
+
+#endif // LEADERBOARD_PARSE_H
@@ -15,38 +15,150 @@
 #include "raylib.h"
 #if defined(PLATFORM_WEB)
 #include <emscripten/emscripten.h>
+#include <emscripten/html5.h>
 #endif
+#include "autopilot.h"
 #include "config.h"
 #include "enemy.h"
 #include "forcefield.h"
 #include "game.h"
 #include "gl_debug.h"
+#include "hud.h"
+#include "input.h"
+#include "latency.h"
 #include "laser.h"
 #include "leaderboard.h"
+#include "pacing.h"
 #include "raymath.h"
+#include "replay.h"
+#include "resolution.h"
+#include "savestate.h"
 #include "starfield.h"
+#include "textcache.h"
 #include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
 
-void InitGame(int *score, int *lives, int *wave, struct LaserManager *lmgr, struct EnemyManager *emgr,
-              struct ForceFieldManager *ffmgr, struct LeaderboardManager *lbmgr);
+void InitGame(GameSession *session, Camera camera, struct LeaderboardManager *lbmgr, uint64_t seed, int screenWidth,
+              int screenHeight);
+
+// Play the sounds for GameEvent flags returned by StepGame
+//
+// @param sounds One sound per GameEvent bit below GAME_EVENT_SOUND_COUNT, in bit order
+static void PlayGameEventSounds(int events, const Sound *sounds);
+
+// Seed for a new live game (recorded in replays)
+//
+// @param fixedSeed Seed from --seed, or 0 for a fresh one
+static uint64_t NewGameSeed(uint64_t fixedSeed);
+
+// Returns true if the screen for gameState only changes in response to input or new data
+static bool IsStaticScreen(GameState gameState, const LeaderboardManager *lbmgr);
+
+#if defined(PLATFORM_WEB)
+// What the page visibility callback needs to suspend a game in progress
+typedef struct SuspendContext {
+    const GameSession *session;
+    const GameState *gameState;
+} SuspendContext;
+
+// Suspend the game in progress when the page is hidden (mobile browsers may then discard the tab)
+static EM_BOOL OnVisibilityChange(int eventType, const EmscriptenVisibilityChangeEvent *event, void *userData);
+#endif
 
 //----------------------------------------------------------------------------------
 // main - Implementation Notes:
+// - Parses desktop options: --pacing=capped|lowlatency|uncapped, --vsync,
+//   --latency-test[=shots] (starts playing with synthetic clicks, reports latency, exits),
+//   --record=file (saves the input of each game played), --replay=file (replay viewer with
+//   seeking) and --replay-fast (with --replay: simulate the whole recording without a
+//   window, print the result and exit)
+// - --autopilot[=reaction_ms[,aim_error_px]] lets the bot play, starting a new game after
+//   each game over; with --headless it plays one game without a window at a fixed tick,
+//   prints the result and exits. --seed=N starts every game from the same seed
 // - Initializes window, audio and resources
 // - Handles simple state machine for START/PLAYING/GAME_OVER
 // - Updates and renders subsystems each frame
 //----------------------------------------------------------------------------------
-int main(void)
+int main(int argc, char **argv)
 {
     int screenWidth = 1600;
     int screenHeight = 900;
 
-    SetConfigFlags(FLAG_WINDOW_RESIZABLE | FLAG_MSAA_4X_HINT);
-    InitWindow(screenWidth, screenHeight, "raylib - Tailgunner");
+    PacingMode pacingMode = PACING_CAPPED;
+    int latencyShots = 0;
+    const char *recordPath = NULL;
+    const char *replayPath = NULL;
+    bool replayFast = false;
+    bool autopilotOn = false;
+    bool headless = false;
+    uint64_t fixedSeed = 0;
+    AutopilotSkill autopilotSkill = GetDefaultAutopilotSkill();
+    unsigned int windowFlags = FLAG_WINDOW_RESIZABLE | FLAG_MSAA_4X_HINT;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--pacing=", 9) == 0) {
+            if (!ParsePacingMode(argv[i] + 9, &pacingMode)) {
+                fprintf(stderr, "Unknown pacing mode '%s' (use capped, lowlatency or uncapped)\n", argv[i] + 9);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--vsync") == 0) {
+            windowFlags |= FLAG_VSYNC_HINT;
+        }
+        else if (strcmp(argv[i], "--latency-test") == 0) {
+            latencyShots = LATENCY_DEFAULT_SHOTS;
+        }
+        else if (strncmp(argv[i], "--latency-test=", 15) == 0) {
+            latencyShots = atoi(argv[i] + 15);
+        }
+        else if (strncmp(argv[i], "--record=", 9) == 0) {
+            recordPath = argv[i] + 9;
+        }
+        else if (strncmp(argv[i], "--replay=", 9) == 0) {
+            replayPath = argv[i] + 9;
+        }
+        else if (strcmp(argv[i], "--replay-fast") == 0) {
+            replayFast = true;
+        }
+        else if (strcmp(argv[i], "--autopilot") == 0) {
+            autopilotOn = true;
+        }
+        else if (strncmp(argv[i], "--autopilot=", 12) == 0) {
+            autopilotOn = true;
+            if (!ParseAutopilotSkill(argv[i] + 12, &autopilotSkill)) {
+                fprintf(stderr, "Bad autopilot skill '%s' (use reaction_ms[,aim_error_px])\n", argv[i] + 12);
+                return 1;
+            }
+        }
+        else if (strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        }
+        else if (strncmp(argv[i], "--seed=", 7) == 0) {
+            fixedSeed = strtoull(argv[i] + 7, NULL, 10);
+        }
+        else {
+            fprintf(stderr, "Unknown option '%s'\n", argv[i]);
+            return 1;
+        }
+    }
 
-    SetTargetFPS(60);
+    // The latency test keeps the player alive, so its games do not replay; one file mode at a time
+    int fileModes = (recordPath != NULL) + (replayPath != NULL) + (latencyShots > 0);
+    if (fileModes > 1) {
+        fprintf(stderr, "--record, --replay and --latency-test cannot be combined\n");
+        return 1;
+    }
+    // The bot plays instead of the player: nothing to replay, and its shots have no click to time
+    if (autopilotOn && (replayPath != NULL || latencyShots > 0)) {
+        fprintf(stderr, "--autopilot cannot be combined with --replay or --latency-test\n");
+        return 1;
+    }
+    if (headless && !autopilotOn) {
+        fprintf(stderr, "--headless needs --autopilot\n");
+        return 1;
+    }
 
-    GameState gameState = STATE_START;
     Camera camera = {0};
     camera.position = (Vector3){0.0f, 0.0f, 0.0f};
     camera.target = (Vector3){0.0f, 0.0f, -1.0f};
@@ -54,17 +166,66 @@ int main(void)
     camera.fovy = 45.0f;
     camera.projection = CAMERA_PERSPECTIVE;
 
-    int score = 0;
-    int score_at_last_life = 0;
-    int lives = 0;
-    int wave = 0;
-    bool nameRequired = true;
-    Vector2 virtualMouse = {0};
+    // All gameplay state (score, lives, wave, lasers, enemies, force field, RNG)
+    GameSession session = {0};
 
-    // Encapsulated managers (avoid globals)
-    LaserManager laserMgr = {0};
-    EnemyManager enemyMgr = {0};
-    ForceFieldManager ffMgr = {0};
+    // Replays are evaluated at their recorded screen size; open the window at that size too
+    ReplayPlayer replay = {0};
+    if (replayPath != NULL) {
+        if (!LoadReplay(&replay, replayPath)) return 1;
+        screenWidth = replay.screenWidth;
+        screenHeight = replay.screenHeight;
+    }
+    ReplayFile recorder = {0};
+
+    if (replayPath != NULL && replayFast) {
+        // Regression/benchmark run: simulation only, as fast as it goes
+        StartReplay(&replay, &session, camera);
+        clock_t start = clock();
+        while (StepReplay(&replay, &session) >= 0) {
+        }
+        double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("Replay finished: %d ticks, score %d, wave %d, lives %d, state %016llx "
+               "(%.3f s simulated in %.3f s CPU)\n",
+               session.tick, session.score, session.wave, session.lives, (unsigned long long)HashGameSession(&session),
+               session.simTime, seconds);
+        UnloadReplay(&replay);
+        return 0;
+    }
+
+    Autopilot autopilot = {0};
+    if (autopilotOn && headless) {
+        // Profiling/soak run: one bot game at a steady tick, as fast as it goes
+        uint64_t seed = NewGameSeed(fixedSeed);
+        InitGameSession(&session, camera, seed, screenWidth, screenHeight);
+        InitAutopilot(&autopilot, autopilotSkill, seed);
+        if (recordPath != NULL) BeginReplayRecording(&recorder, recordPath, seed, screenWidth, screenHeight);
+        clock_t start = clock();
+        int events = 0;
+        while (!(events & GAME_EVENT_GAME_OVER)) {
+            GameInput input;
+            UpdateAutopilot(&autopilot, &session, AUTOPILOT_HEADLESS_DT, screenWidth, screenHeight, &input);
+            WriteReplayTick(&recorder, &input);
+            events = StepGame(&session, &input);
+        }
+        double seconds = (double)(clock() - start) / CLOCKS_PER_SEC;
+        printf("Autopilot game: seed %llu, %d ticks, score %d, wave %d, state %016llx "
+               "(%.3f s simulated in %.3f s CPU)\n",
+               (unsigned long long)seed, session.tick, session.score, session.wave,
+               (unsigned long long)HashGameSession(&session), session.simTime, seconds);
+        if (recorder.file != NULL) {
+            printf("Replay recorded: %s (%d ticks)\n", recordPath, recorder.ticks);
+            CloseReplay(&recorder);
+        }
+        return 0;
+    }
+
+    SetConfigFlags(windowFlags);
+    InitWindow(screenWidth, screenHeight, "raylib - Tailgunner");
+
+    GameState gameState = STATE_START;
+    bool nameRequired = true;
+    bool replayReported = false;
 
     InitAudioDevice();
 
@@ -79,15 +240,89 @@ int main(void)
     Sound forceFieldHitSound = LoadSound("resources/sounds/bounce.wav");
     Sound lostLifeSound = LoadSound("resources/sounds/past.wav");
     Sound extraLifeSound = LoadSound("resources/sounds/forcefield.wav");
+    // Sound for each GameEvent bit, in bit order (see PlayGameEventSounds)
+    const Sound eventSounds[] = {
+        shootSound,         // GAME_EVENT_SHOT
+        explosionSound,     // GAME_EVENT_HIT
+        forceFieldSound,    // GAME_EVENT_FORCE_FIELD
+        forceFailSound,     // GAME_EVENT_FORCE_FAIL
+        forceFieldHitSound, // GAME_EVENT_FORCE_FIELD_HIT
+        lostLifeSound,      // GAME_EVENT_LOST_LIFE
+        extraLifeSound,     // GAME_EVENT_EXTRA_LIFE
+    };
 
     Rectangle showTop10Button = {0};
     Rectangle showHelpButton = {0};
 
+    // Counters are only re-formatted (and re-laid out) when their values change
+    TextCounter finalScoreText = {0};
+
+    // Loaded once: it is only scenery, and reloading it per game leaked its mesh, shader and buffers
+    InitStarfield();
+
+    HudLayer hud;
+    InitHud(&hud);
+    double hudTime = 0.0; // Seconds spent updating/drawing the HUD since the last FPS report
+
+    ResolutionScaler resScaler;
+    InitResolutionScaler(&resScaler);
+
+    PacingManager pacer;
+    InitPacing(&pacer, pacingMode);
+    InitInputTimestamps();
+
+    LatencyHarness latency;
+    InitLatencyHarness(&latency, latencyShots);
+    char latencyConfig[32];
+    snprintf(latencyConfig, sizeof(latencyConfig), "%s%s", GetPacingModeName(pacer.mode),
+             (windowFlags & FLAG_VSYNC_HINT) ? "+vsync" : "");
+    if (replay.ticks != NULL) {
+        // Replay viewer: straight into play; the cursor stays visible for the scrub bar
+        StartReplay(&replay, &session, camera);
+        gameState = STATE_PLAYING;
+    }
+    else if (latency.enabled) {
+        // Skip the menus and measure during normal play
+        InitGame(&session, camera, &lbMgr, NewGameSeed(fixedSeed), screenWidth, screenHeight);
+        gameState = STATE_PLAYING;
+        DisableCursor();
+    }
+    else if (autopilotOn) {
+        // Skip the menus; the bot plays game after game
+        uint64_t seed = NewGameSeed(fixedSeed);
+        InitGame(&session, camera, &lbMgr, seed, screenWidth, screenHeight);
+        InitAutopilot(&autopilot, autopilotSkill, seed);
+        gameState = STATE_PLAYING;
+        DisableCursor();
+        if (recordPath != NULL) BeginReplayRecording(&recorder, recordPath, seed, screenWidth, screenHeight);
+    }
+    else if (ResumeGameSession(&session)) {
+        // Web: the browser discarded the tab during a game; carry on from where it was hidden
+        ResetLeaderboardFlags(&lbMgr);
+        gameState = STATE_PLAYING;
+        DisableCursor();
+    }
+#if defined(PLATFORM_WEB)
+    SuspendContext suspendContext = {&session, &gameState};
+    emscripten_set_visibilitychange_callback(&suspendContext, false, OnVisibilityChange);
+#endif
+    printf("Frame pacing: %s%s\n", GetPacingModeName(pacer.mode), (windowFlags & FLAG_VSYNC_HINT) ? " + vsync" : "");
+
     int frameCount = 0;
     int touch_count_last_frame = 0;
+    GameState previousState = gameState;
+    double stateStartTime = GetTime(); // When gameState was entered
     double previousTime = GetTime();
+#if !defined(PLATFORM_WEB)
+    clock_t previousCpu = clock(); // Process CPU time, reported as CPU% alongside FPS
+#endif
 
     while (!WindowShouldClose()) {
+        // Blocks for input while a static screen is idle
+        WaitForFrameEvents(&pacer);
+        UpdateLatencyHarness(&latency);
+        if (PollLeaderboard(&lbMgr)) MarkFrameDirty(&pacer);
+
         /* Recompute UI button positions each frame so they follow window size changes */
         showTop10Button.x = GetScreenWidth() / 2 - 60;
         showTop10Button.y = GetScreenHeight() / 2 + 80;
@@ -112,68 +347,89 @@ int main(void)
                 gameState = STATE_HELP;
             }
             else if (IsKeyPressed(KEY_ENTER) || IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                InitGame(&score, &lives, &wave, &laserMgr, &enemyMgr, &ffMgr, &lbMgr);
+                uint64_t seed = NewGameSeed(fixedSeed);
+                InitGame(&session, camera, &lbMgr, seed, GetScreenWidth(), GetScreenHeight());
                 gameState = STATE_PLAYING;
                 DisableCursor();
-                virtualMouse = (Vector2){(float)GetScreenWidth() / 2, (float)GetScreenHeight() / 2};
+                if (recordPath != NULL)
+                    BeginReplayRecording(&recorder, recordPath, seed, GetScreenWidth(), GetScreenHeight());
             }
         } break;
         case STATE_PLAYING: {
-            Vector2 mouseDelta = GetMouseDelta();
-            virtualMouse = Vector2Add(virtualMouse, mouseDelta);
-            virtualMouse.x = Clamp(virtualMouse.x, 0, (float)GetScreenWidth());
-            virtualMouse.y = Clamp(virtualMouse.y, 0, (float)GetScreenHeight());
-
-            if (IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
-                Ray ray = GetMouseRay(virtualMouse, camera);
-                int hits = FireLasers(&laserMgr, &enemyMgr, ray, camera);
-                score += hits;
-                if (hits > 0) PlaySound(explosionSound);
-                PlaySound(shootSound);
+            int events = 0;
+            float dt = 0.0f; // Simulated time this frame (drives the cosmetic starfield)
+
+            if (replay.ticks != NULL) {
+                int steps = UpdateReplayControls(&replay, &session);
+                for (int i = 0; i < steps; i++) {
+                    int tick = session.tick;
+                    int stepEvents = StepReplay(&replay, &session);
+                    if (stepEvents < 0) break;
+                    events |= stepEvents;
+                    dt += GetGameInputDt(&replay.ticks[tick]);
+                }
+                if (session.tick >= replay.tickCount && !replayReported) {
+                    printf("Replay finished: %d ticks, score %d, wave %d, lives %d\n", session.tick, session.score,
+                           session.wave, session.lives);
+                    replayReported = true;
+                }
+                // The viewer stays in play at game over so the recording can still be scrubbed
+                events &= ~GAME_EVENT_GAME_OVER;
             }
+            else {
+                // All player input reaches the simulation through GameInput (see game.h)
+                GameInput input;
+                if (autopilotOn) {
+                    UpdateAutopilot(&autopilot, &session, GetPacingFrameTime(&pacer), GetScreenWidth(),
+                                    GetScreenHeight(), &input);
+                }
+                else {
+                    bool fire = IsMouseButtonPressed(MOUSE_LEFT_BUTTON);
+                    double fireAge =
+                        fire ? pacer.lastPresent - TakeClickTime(MOUSE_BUTTON_LEFT, pacer.lastPresent) : 0.0;
+                    int touch_count = GetTouchPointCount();
+                    bool forceField = IsKeyPressed(KEY_SPACE) || (touch_count == 2 && touch_count_last_frame != 2);
+                    touch_count_last_frame = touch_count;
+                    BuildGameInput(&input, GetPacingFrameTime(&pacer), GetMouseDelta(), fire, fireAge, forceField,
+                                   GetScreenWidth(), GetScreenHeight());
+                }
+                WriteReplayTick(&recorder, &input);
 
-            if (IsKeyPressed(KEY_SPACE)) {
-                bool activated = ActivateForceField(&ffMgr);
-                if (activated)
-                    PlaySound(forceFieldSound);
-                else
-                    PlaySound(forceFailSound);
-            }
+                events = StepGame(&session, &input);
+                dt = GetGameInputDt(&input);
+                if (events & GAME_EVENT_SHOT) MarkLatencyShot(&latency);
 
-            int touch_count = GetTouchPointCount();
-            if (touch_count == 2 && touch_count_last_frame != 2) {
-                bool activated = ActivateForceField(&ffMgr);
-                if (activated)
-                    PlaySound(forceFieldSound);
-                else
-                    PlaySound(forceFailSound);
-            }
-            touch_count_last_frame = touch_count;
-
-            UpdateLasers(&laserMgr);
-            UpdateStarfield();
-            int curLives = lives;
-            UpdateEnemies(&enemyMgr, &lives, &wave);
-            bool ffHit = UpdateForceField(&ffMgr, &enemyMgr);
-            if (ffHit) PlaySound(forceFieldHitSound);
-
-            if (curLives > lives) {
-                // Lost a life this frame
-                PlaySound(lostLifeSound);
+                // Keep the game running for the whole latency measurement
+                if (latency.enabled && session.lives <= 0) {
+                    session.lives = 1;
+                    events &= ~GAME_EVENT_GAME_OVER;
+                }
             }
 
-            if (lives <= 0) {
-                gameState = STATE_GAME_OVER;
-                EnableCursor();
-            }
+            PlayGameEventSounds(events, eventSounds);
+            UpdateResolutionScale(&resScaler, GetFrameTime());
+            UpdateStarfield(dt);
 
-            // Check for extra life
-            if (score - score_at_last_life >= POINTS_FOR_EXTRA_LIFE) {
-                lives++;
-                score_at_last_life += POINTS_FOR_EXTRA_LIFE;
-                PlaySound(extraLifeSound);
+            if (events & GAME_EVENT_GAME_OVER) {
+                ClearSuspendedGameSession();
+                if (recorder.file != NULL) {
+                    printf("Replay recorded: %s (%d ticks, seed %llu)\n", recordPath, recorder.ticks,
+                           (unsigned long long)recorder.seed);
+                    CloseReplay(&recorder);
+                }
+                if (autopilotOn) {
+                    // Only the first bot game is recorded
+                    printf("Autopilot game: %d ticks, score %d, wave %d (%.1f s)\n", session.tick, session.score,
+                           session.wave, session.simTime);
+                    uint64_t seed = NewGameSeed(fixedSeed);
+                    InitGame(&session, camera, &lbMgr, seed, GetScreenWidth(), GetScreenHeight());
+                    InitAutopilot(&autopilot, autopilotSkill, seed);
+                }
+                else {
+                    gameState = STATE_GAME_OVER;
+                    EnableCursor();
+                }
             }
-
         } break;
         case STATE_GAME_OVER: {
             if (IsKeyPressed(KEY_ENTER) || IsMouseButtonPressed(MOUSE_LEFT_BUTTON)) {
@@ -199,7 +455,7 @@ int main(void)
                 lbMgr.skipSubmission = false;
             }
             else {
-                SubmitScore(&lbMgr, score);
+                SubmitScore(&lbMgr, session.score);
             }
             ResetLeaderboardFlags(&lbMgr);
             gameState = STATE_LEADERBOARD;
@@ -219,52 +475,82 @@ int main(void)
         } break;
         }
 
+        // Between games: bring the leaderboard lists up to date before they are asked for
+        if (gameState != previousState) {
+            previousState = gameState;
+            stateStartTime = GetTime();
+        }
+        if ((gameState == STATE_START && GetTime() - stateStartTime >= LEADERBOARD_PREFETCH_IDLE_DELAY) ||
+            gameState == STATE_GAME_OVER || gameState == STATE_ENTER_NAME) {
+            PrefetchLeaderboard(&lbMgr);
+        }
+
+        if (!UpdateFramePacing(&pacer, (int)gameState, IsStaticScreen(gameState, &lbMgr))) {
+            SkipFrame(&pacer);
+            continue;
+        }
+
+#if HUD_RETAINED
+        if (gameState == STATE_PLAYING) {
+            double hudStart = GetTime();
+            UpdateHud(&hud, session.score, session.lives, session.wave, &session.forceField);
+            hudTime += GetTime() - hudStart;
+        }
+#endif
+
         BeginDrawing();
         ClearBackground(COLOR_BACKGROUND);
 
         if (gameState == STATE_START) {
-            DrawText(GAME_TITLE, GetScreenWidth() / 2 - MeasureText(GAME_TITLE, 40) / 2, GetScreenHeight() / 2 - 40, 40,
-                     COLOR_TEXT_TITLE);
-            DrawText("Press ENTER or CLICK to Start",
-                     GetScreenWidth() / 2 - MeasureText("Press ENTER or CLICK to Start", 20) / 2,
-                     GetScreenHeight() / 2 + 20, 20, COLOR_TEXT_SUBTITLE);
+            DrawTextCached(GAME_TITLE, GetScreenWidth() / 2 - MeasureTextCached(GAME_TITLE, 40) / 2,
+                           GetScreenHeight() / 2 - 40, 40, COLOR_TEXT_TITLE);
+            DrawTextCached("Press ENTER or CLICK to Start",
+                           GetScreenWidth() / 2 - MeasureTextCached("Press ENTER or CLICK to Start", 20) / 2,
+                           GetScreenHeight() / 2 + 20, 20, COLOR_TEXT_SUBTITLE);
 
             DrawRectangleLinesEx(showTop10Button, 2, COLOR_BUTTON_BOX);
-            DrawText("Top 10", showTop10Button.x + 30, showTop10Button.y + 5, 20, COLOR_BUTTON_BOX);
+            DrawTextCached("Top 10", showTop10Button.x + 30, showTop10Button.y + 5, 20, COLOR_BUTTON_BOX);
 
             DrawRectangleLinesEx(showHelpButton, 2, COLOR_BUTTON_BOX);
-            DrawText("Help", showHelpButton.x + 40, showHelpButton.y + 5, 20, COLOR_BUTTON_BOX);
+            DrawTextCached("Help", showHelpButton.x + 40, showHelpButton.y + 5, 20, COLOR_BUTTON_BOX);
 
-            DrawText(GAME_VERSION, 10, GetScreenHeight() - 20, 12, COLOR_TEXT_SUBTITLE);
+            DrawTextCached(GAME_VERSION, 10, GetScreenHeight() - 20, 12, COLOR_TEXT_SUBTITLE);
         }
         else if (gameState == STATE_PLAYING) {
-            BeginMode3D(camera);
+            // 3D pass may render at reduced resolution; everything after it is native resolution
+            BeginScenePass(&resScaler, camera);
             DrawStarfield();
-            DrawEnemies(&enemyMgr);
-            DrawLasers(&laserMgr);
-            EndMode3D();
-            DrawForceField2D(&ffMgr);
-
-            DrawCircleLines((int)virtualMouse.x, (int)virtualMouse.y, 10, COLOR_CROSSHAIR_CIRCLE);
-            DrawLine((int)virtualMouse.x - 20, (int)virtualMouse.y, (int)virtualMouse.x + 20, (int)virtualMouse.y,
+            DrawEnemies(&session.enemies);
+            DrawLasers(&session.lasers);
+            EndScenePass(&resScaler);
+            DrawForceField2D(&session.forceField);
+
+            Vector2 crosshair = session.virtualMouse;
+            DrawCircleLines((int)crosshair.x, (int)crosshair.y, 10, COLOR_CROSSHAIR_CIRCLE);
+            DrawLine((int)crosshair.x - 20, (int)crosshair.y, (int)crosshair.x + 20, (int)crosshair.y,
                      COLOR_CROSSHAIR_LINES);
-            DrawLine((int)virtualMouse.x, (int)virtualMouse.y - 20, (int)virtualMouse.x, (int)virtualMouse.y + 20,
+            DrawLine((int)crosshair.x, (int)crosshair.y - 20, (int)crosshair.x, (int)crosshair.y + 20,
                      COLOR_CROSSHAIR_LINES);
 
-            DrawText(TextFormat("Score: %i", score), 10, 10, 20, COLOR_TEXT_SCORE);
-            DrawText(TextFormat("Lives: %i", lives), GetScreenWidth() - 100, 10, 20, COLOR_TEXT_LIVES);
-            DrawText(TextFormat("Wave: %i", wave), GetScreenWidth() / 2 - 20, 10, 20, COLOR_TEXT_WAVE);
-            DrawForceFieldUI(&ffMgr);
+            double hudStart = GetTime();
+#if HUD_RETAINED
+            DrawHud(&hud);
+#else
+            DrawHudImmediate(&hud, session.score, session.lives, session.wave, &session.forceField);
+#endif
+            hudTime += GetTime() - hudStart;
+
+            if (replay.ticks != NULL) DrawReplayBar(&replay, &session);
         }
         else if (gameState == STATE_GAME_OVER) {
-            DrawText("GAME OVER", GetScreenWidth() / 2 - MeasureText("GAME OVER", 40) / 2, GetScreenHeight() / 2 - 40,
-                     40, COLOR_TEXT_GAMEOVER);
-            DrawText(TextFormat("Final Score: %i", score),
-                     GetScreenWidth() / 2 - MeasureText(TextFormat("Final Score: %i", score), 20) / 2,
-                     GetScreenHeight() / 2 + 20, 20, COLOR_TEXT_FINAL_SCORE);
-            DrawText("Press ENTER or CLICK to Continue",
-                     GetScreenWidth() / 2 - MeasureText("Press ENTER or CLICK to Continue", 20) / 2,
-                     GetScreenHeight() / 2 + 60, 20, COLOR_TEXT_SUBTITLE);
+            const char *finalScore = FormatCounter(&finalScoreText, "Final Score: %i", session.score);
+            DrawTextCached("GAME OVER", GetScreenWidth() / 2 - MeasureTextCached("GAME OVER", 40) / 2,
+                           GetScreenHeight() / 2 - 40, 40, COLOR_TEXT_GAMEOVER);
+            DrawTextCached(finalScore, GetScreenWidth() / 2 - MeasureTextCached(finalScore, 20) / 2,
+                           GetScreenHeight() / 2 + 20, 20, COLOR_TEXT_FINAL_SCORE);
+            DrawTextCached("Press ENTER or CLICK to Continue",
+                           GetScreenWidth() / 2 - MeasureTextCached("Press ENTER or CLICK to Continue", 20) / 2,
+                           GetScreenHeight() / 2 + 60, 20, COLOR_TEXT_SUBTITLE);
         }
         else if (gameState == STATE_ENTER_NAME) {
             DrawNameInput(&lbMgr);
@@ -273,40 +559,65 @@ int main(void)
             DrawLeaderboard(&lbMgr);
         }
         else if (gameState == STATE_HELP) {
-            DrawText("Help / Instructions", 100, 50, 30, COLOR_TEXT_TITLE);
-            DrawText("Use the mouse or touch to aim and click to shoot lasers at incoming enemies.", 100, 100, 20,
-                     COLOR_TEXT_SUBTITLE);
-            DrawText("Press SPACE or use two-finger touch to activate the force field.", 100, 125, 20,
-                     COLOR_TEXT_SUBTITLE);
-            DrawText("Avoid letting enemies reach you, or you'll lose lives!", 100, 150, 20, COLOR_TEXT_SUBTITLE);
-            DrawText("Gain an extra life every 50 points scored.", 100, 175, 20, COLOR_TEXT_SUBTITLE);
-            DrawText("Survive as many waves as you can and achieve a high score!", 100, 200, 20, COLOR_TEXT_SUBTITLE);
-            DrawText("Press ENTER or CLICK to return to the main menu.", 100, 250, 20, COLOR_TEXT_SUBTITLE);
+            DrawTextCached("Help / Instructions", 100, 50, 30, COLOR_TEXT_TITLE);
+            DrawTextCached("Use the mouse or touch to aim and click to shoot lasers at incoming enemies.", 100, 100,
+                           20, COLOR_TEXT_SUBTITLE);
+            DrawTextCached("Press SPACE or use two-finger touch to activate the force field.", 100, 125, 20,
+                           COLOR_TEXT_SUBTITLE);
+            DrawTextCached("Avoid letting enemies reach you, or you'll lose lives!", 100, 150, 20,
+                           COLOR_TEXT_SUBTITLE);
+            DrawTextCached("Gain an extra life every 50 points scored.", 100, 175, 20, COLOR_TEXT_SUBTITLE);
+            DrawTextCached("Survive as many waves as you can and achieve a high score!", 100, 200, 20,
+                           COLOR_TEXT_SUBTITLE);
+            DrawTextCached("Press ENTER or CLICK to return to the main menu.", 100, 250, 20, COLOR_TEXT_SUBTITLE);
         }
 
         CHECK_GL_ERRORS();
-        EndDrawing();
+        PresentFrame(&pacer);
+        RecordLatencyPresent(&latency, pacer.lastPresent);
+        if (IsLatencyTestDone(&latency)) {
+            ReportLatency(&latency, latencyConfig);
+            break;
+        }
 
         frameCount++;
         double currentTime = GetTime();
         double elapsedTime = currentTime - previousTime;
         if (elapsedTime >= FPS_INTERVAL) {
+            double latencyAvg, latencyMax;
+            TakePacingLatency(&pacer, &latencyAvg, &latencyMax);
 #if defined(PLATFORM_WEB)
-            emscripten_log(EM_LOG_CONSOLE, "Average FPS: %.2f", frameCount / elapsedTime);
+            emscripten_log(EM_LOG_CONSOLE, "Average FPS: %.2f, HUD: %.3f ms/frame, 3D scale: %.2f, latency: %.2f ms",
+                           frameCount / elapsedTime, hudTime * 1000.0 / frameCount, resScaler.scale, latencyAvg);
 #else
-            printf("Average FPS: %.2f\n", frameCount / elapsedTime);
+            clock_t currentCpu = clock();
+            double cpuPercent = 100.0 * (double)(currentCpu - previousCpu) / CLOCKS_PER_SEC / elapsedTime;
+            printf("Average FPS: %.2f, HUD: %.3f ms/frame, CPU: %.1f%%, 3D scale: %.2f, "
+                   "input-to-present (%s): avg %.2f ms, max %.2f ms\n",
+                   frameCount / elapsedTime, hudTime * 1000.0 / frameCount, cpuPercent, resScaler.scale,
+                   GetPacingModeName(pacer.mode), latencyAvg, latencyMax);
+            previousCpu = currentCpu;
 #endif
             frameCount = 0;
+            hudTime = 0.0;
             previousTime = currentTime;
         }
     }
 
+    CloseReplay(&recorder);
+    UnloadReplay(&replay);
+    UnloadLeaderboard(&lbMgr);
+
     UnloadSound(shootSound);
     UnloadSound(explosionSound);
     UnloadSound(forceFieldSound);
     UnloadSound(forceFailSound);
     UnloadSound(forceFieldHitSound);
+    UnloadSound(lostLifeSound);
+    UnloadSound(extraLifeSound);
     UnloadStarfield();
+    UnloadHud(&hud);
+    UnloadResolutionScaler(&resScaler);
     CloseAudioDevice();
 
     CloseWindow();
@@ -316,21 +627,59 @@ int main(void)
 
 //----------------------------------------------------------------------------------
 // InitGame - Implementation Notes:
-// - Resets score, lives and wave to starting values
-// - Initializes all subsystems used by the gameplay loop
-// - Spawns initial enemy wave
+// - Starts a new GameSession (score, lives, wave, first enemy wave from seed)
+// - Resets the non-gameplay state that belongs to a new game
 //----------------------------------------------------------------------------------
-void InitGame(int *score, int *lives, int *wave, struct LaserManager *lmgr, struct EnemyManager *emgr,
-              struct ForceFieldManager *ffmgr, struct LeaderboardManager *lbmgr)
+void InitGame(GameSession *session, Camera camera, struct LeaderboardManager *lbmgr, uint64_t seed, int screenWidth,
+              int screenHeight)
 {
-    *score = 0;
-    *lives = 3;
-    *wave = 1;
-    InitLasers(lmgr);
-    InitEnemies(emgr);
-    // Spawn the initial set of enemies for the first wave
-    SpawnWave(emgr, *wave);
-    InitStarfield();
-    InitForceField(ffmgr);
+    InitGameSession(session, camera, seed, screenWidth, screenHeight);
     ResetLeaderboardFlags(lbmgr);
 }
+
+static void PlayGameEventSounds(int events, const Sound *sounds)
+{
+    for (int bit = 0; bit < GAME_EVENT_SOUND_COUNT; bit++) {
+        if (events & (1 << bit)) PlaySound(sounds[bit]);
+    }
+}
+
+static bool IsStaticScreen(GameState gameState, const LeaderboardManager *lbmgr)
+{
+    switch (gameState) {
+    case STATE_START:
+    case STATE_HELP:
+    case STATE_GAME_OVER:
+        return true;
+    case STATE_LEADERBOARD:
+        return lbmgr->globalScoresFetched && lbmgr->userScoresFetched && !lbmgr->pageFetching;
+    default:
+        return false;
+    }
+}
+
+static uint64_t NewGameSeed(uint64_t fixedSeed)
+{
+    if (fixedSeed != 0) return fixedSeed;
+    // GetTime needs the window; headless games use process CPU time for the low bits
+    double now = IsWindowReady() ? GetTime() : (double)clock() / CLOCKS_PER_SEC;
+    return ((uint64_t)time(NULL) << 20) ^ (uint64_t)(now * 1e6);
+}
+
+#if defined(PLATFORM_WEB)
+//----------------------------------------------------------------------------------
+// OnVisibilityChange - Implementation Notes:
+// - Events are dispatched between frames, so the session is never mid-step here
+// - Becoming visible again means the tab survived; the stored copy would only be stale
+//----------------------------------------------------------------------------------
+static EM_BOOL OnVisibilityChange(int eventType, const EmscriptenVisibilityChangeEvent *event, void *userData)
+{
+    (void)eventType;
+    const SuspendContext *context = (const SuspendContext *)userData;
+    if (!event->hidden)
+        ClearSuspendedGameSession();
+    else if (*context->gameState == STATE_PLAYING)
+        SuspendGameSession(context->session);
+    return EM_FALSE;
+}
+#endif
@@ -0,0 +1,257 @@
+//================================================================================================
+//
+//   pacing.c - Frame pacing and presentation control implementation
+//
+//   See pacing.h for module interface documentation.
+//
+//   Implementation notes:
+//   - A change (input, resize, state change, MarkFrameDirty) draws IDLE_SETTLE_FRAMES frames
+//     so both swap-chain buffers hold the current image before drawing stops
+//   - Desktop runs raylib uncapped and does all sleeping here, so the time EndDrawing
+//     returns is the present time in every mode
+//   - Late input sampling goes through PumpInputEvents (GLFW event processing, see input.c).
+//     Events are processed into raylib's current input state before game logic runs, and
+//     the previous state is only rolled over by EndDrawing, so pressed/released edges and
+//     mouse deltas are preserved
+//   - Sleeps block in the event pump for the bulk and spin polling events for the last
+//     PACING_SPIN_TAIL, so input events are dispatched (and timestamped) as they arrive
+//   - Low-latency start = last present + frame period - (CPU work estimate + margin)
+//   - A pending window close counts as input, since raylib only reads it in EndDrawing and
+//     an idle loop would otherwise never get there
+//   - Frame time runs from one input sample to the next. Skipped frames never reach
+//     EndDrawing, so raylib's GetFrameTime after an idle stretch covers all of it
+//   - Web keeps raylib's SetTargetFPS loop (emscripten_sleep is what yields to the browser)
+//     and idles by lowering the target FPS to IDLE_WEB_FPS
+//
+//================================================================================================
+
+#include "pacing.h"
+#include "config.h"
+#include "input.h"
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// Returns true if any input arrived since the last presented frame
+static bool HasInputActivity(PacingManager *pm);
+
+// Switch between idle and active presentation
+static void SetIdle(PacingManager *pm, bool idle);
+
+#if defined(PLATFORM_DESKTOP)
+// Sleep until GetTime() reaches time, processing input events as they arrive
+static void WaitUntil(double time);
+#endif
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see pacing.h for documentation)
+//----------------------------------------------------------------------------------
+
+void InitPacing(PacingManager *pm, PacingMode mode)
+{
+    *pm = (PacingManager){0};
+    pm->dirty = true;
+    pm->settleFrames = IDLE_SETTLE_FRAMES;
+    pm->lastState = -1;
+    pm->sampleTime = GetTime();
+    pm->lastPresent = pm->sampleTime;
+    pm->frameTime = 1.0f / TARGET_FPS;
+
+#if defined(PLATFORM_DESKTOP)
+    pm->mode = mode;
+    SetTargetFPS(0);
+#else
+    // The browser drives the web loop; only the capped mode applies there
+    (void)mode;
+    pm->mode = PACING_CAPPED;
+    SetTargetFPS(TARGET_FPS);
+#endif
+}
+
+bool ParsePacingMode(const char *name, PacingMode *mode)
+{
+    for (int m = PACING_CAPPED; m <= PACING_UNCAPPED; m++) {
+        if (strcmp(name, GetPacingModeName((PacingMode)m)) == 0) {
+            *mode = (PacingMode)m;
+            return true;
+        }
+    }
+    return false;
+}
+
+const char *GetPacingModeName(PacingMode mode)
+{
+    switch (mode) {
+    case PACING_CAPPED:
+        return "capped";
+    case PACING_LOW_LATENCY:
+        return "lowlatency";
+    case PACING_UNCAPPED:
+        return "uncapped";
+    }
+    return "unknown";
+}
+
+//----------------------------------------------------------------------------------
+// WaitForFrameEvents - Implementation Notes:
+// - Idle: block on events (desktop)
+// - Capped: next frame starts one period after the previous one started; a late frame
+//   starts immediately rather than trying to catch up
+// - Low latency: start so that CPU work plus margin ends one period after the last present
+// - A frame that woke from idle is timed as one period: the wait says nothing about play
+// - Unconsumed presses that arrived before the previous sample are discarded here
+//----------------------------------------------------------------------------------
+void WaitForFrameEvents(PacingManager *pm)
+{
+    const double period = 1.0 / TARGET_FPS;
+
+#if defined(PLATFORM_DESKTOP)
+    if (pm->idle) {
+        PumpInputEvents(IDLE_WAIT_TIMEOUT);
+    }
+    else if (pm->mode == PACING_CAPPED) {
+        WaitUntil(pm->sampleTime + period);
+    }
+    else if (pm->mode == PACING_LOW_LATENCY) {
+        WaitUntil(pm->lastPresent + period - pm->workEstimate - PACING_PRESENT_MARGIN);
+    }
+
+    // Sample input as late as possible: right before game logic
+    PumpInputEvents(0.0);
+#endif
+    // Presses from before the previous sample belonged to an earlier frame (see input.c)
+    DiscardStaleClicks(pm->sampleTime);
+
+    double now = GetTime();
+    double frameTime = now - pm->sampleTime;
+    if (pm->idle && frameTime > period) frameTime = period;
+    pm->frameTime = (float)frameTime;
+    pm->sampleTime = now;
+}
+
+float GetPacingFrameTime(const PacingManager *pm)
+{
+    return pm->frameTime;
+}
+
+void PresentFrame(PacingManager *pm)
+{
+    double submitTime = GetTime();
+    EndDrawing();
+    double presentTime = GetTime();
+
+    pm->workEstimate += PACING_WORK_SMOOTHING * ((submitTime - pm->sampleTime) - pm->workEstimate);
+    pm->lastPresent = presentTime;
+
+    double latency = presentTime - pm->sampleTime;
+    pm->latencySum += latency;
+    if (latency > pm->latencyMax) pm->latencyMax = latency;
+    pm->latencyCount++;
+}
+
+int TakePacingLatency(PacingManager *pm, double *averageMs, double *maxMs)
+{
+    int count = pm->latencyCount;
+    *averageMs = (count > 0) ? pm->latencySum * 1000.0 / count : 0.0;
+    *maxMs = pm->latencyMax * 1000.0;
+    pm->latencySum = 0.0;
+    pm->latencyMax = 0.0;
+    pm->latencyCount = 0;
+    return count;
+}
+
+void MarkFrameDirty(PacingManager *pm)
+{
+    pm->dirty = true;
+}
+
+//----------------------------------------------------------------------------------
+// UpdateFramePacing - Implementation Notes:
+// - Non-static screens always draw and leave idle mode
+// - Static screens draw until IDLE_SETTLE_FRAMES frames pass without a change
+//----------------------------------------------------------------------------------
+bool UpdateFramePacing(PacingManager *pm, int gameState, bool staticScreen)
+{
+    if (gameState != pm->lastState) pm->dirty = true;
+    pm->lastState = gameState;
+    if (IsWindowResized() || HasInputActivity(pm)) pm->dirty = true;
+
+    if (pm->dirty) {
+        pm->settleFrames = IDLE_SETTLE_FRAMES;
+        pm->dirty = false;
+    }
+
+    if (!staticScreen) {
+        SetIdle(pm, false);
+        return true;
+    }
+
+    if (pm->settleFrames > 0) {
+        pm->settleFrames--;
+        SetIdle(pm, false);
+        return true;
+    }
+
+    SetIdle(pm, true);
+    return false;
+}
+
+void SkipFrame(PacingManager *pm)
+{
+    (void)pm;
+#if defined(PLATFORM_WEB)
+    BeginDrawing();
+    EndDrawing();
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static bool HasInputActivity(PacingManager *pm)
+{
+    bool activity = false;
+
+    Vector2 mouseDelta = GetMouseDelta();
+    if (mouseDelta.x != 0.0f || mouseDelta.y != 0.0f) activity = true;
+    if (GetMouseWheelMove() != 0.0f) activity = true;
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) || IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) activity = true;
+    if (IsMouseButtonPressed(MOUSE_BUTTON_RIGHT) || IsMouseButtonReleased(MOUSE_BUTTON_RIGHT)) activity = true;
+    // Game logic reads keys with IsKeyPressed, so draining the key queue here is harmless
+    if (GetKeyPressed() != 0) activity = true;
+
+    int touchCount = GetTouchPointCount();
+    if (touchCount != pm->lastTouchCount) activity = true;
+    pm->lastTouchCount = touchCount;
+
+    // Draw a frame so EndDrawing polls the close request into WindowShouldClose
+    if (IsCloseRequested()) activity = true;
+
+    return activity;
+}
+
+static void SetIdle(PacingManager *pm, bool idle)
+{
+    if (pm->idle == idle) return;
+    pm->idle = idle;
+#if defined(PLATFORM_WEB)
+    SetTargetFPS(idle ? IDLE_WEB_FPS : TARGET_FPS);
+#endif
+}
+
+#if defined(PLATFORM_DESKTOP)
+static void WaitUntil(double time)
+{
+    // Wake for each event while sleeping so callbacks see it promptly (see input.c)
+    double remaining;
+    while ((remaining = time - GetTime()) > PACING_SPIN_TAIL) {
+        PumpInputEvents(remaining - PACING_SPIN_TAIL);
+    }
+    while (GetTime() < time) {
+        PumpInputEvents(0.0);
+    }
+}
+#endif
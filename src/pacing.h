@@ -0,0 +1,102 @@
+//================================================================================================
+//
+//   pacing.h - Frame pacing and presentation control for Tailgunner
+//
+//   Decides when each frame starts and when input is sampled, and lets static screens
+//   (title, help, game over, loaded leaderboard) stop issuing draw work. While idle the
+//   desktop build blocks waiting for input events and the web build lowers its frame rate.
+//
+//   Desktop pacing modes (web always uses the browser-driven capped loop):
+//   - PACING_CAPPED:      present, sleep to the next frame boundary, sample input, run
+//   - PACING_LOW_LATENCY: sleep until just before the next present is due (timer plus spin
+//                         tail), then sample input, simulate, draw and present
+//   - PACING_UNCAPPED:    no sleeping; combine with VSync for a VSync-only loop
+//
+//================================================================================================
+
+#ifndef PACING_H
+#define PACING_H
+
+#include "config.h"
+#include "raylib.h"
+
+typedef enum PacingMode {
+    PACING_CAPPED,      // Fixed TARGET_FPS cap, sleep at the end of the frame (default)
+    PACING_LOW_LATENCY, // Sleep first, sample input as late as possible
+    PACING_UNCAPPED     // No cap; frame rate limited only by VSync (if enabled) or the GPU
+} PacingMode;
+
+// Encapsulated pacing state to avoid globals
+typedef struct PacingManager {
+    PacingMode mode;
+    bool idle;          // Static screen has settled; waiting for events instead of drawing
+    bool dirty;         // Something changed that needs to be drawn
+    int settleFrames;   // Frames still to draw after the last change before going idle
+    int lastState;      // Game state seen on the previous frame
+    int lastTouchCount; // Touch point count seen on the previous frame
+
+    double sampleTime;   // When input for the current frame was sampled
+    float frameTime;     // Sample-to-sample time of the current frame, at most one period after idling
+    double lastPresent;  // When the previous frame finished presenting
+    double workEstimate; // Smoothed sample-to-submit CPU time, used to schedule PACING_LOW_LATENCY
+
+    double latencySum; // Input-to-present latency totals since the last TakePacingLatency
+    double latencyMax;
+    int latencyCount;
+} PacingManager;
+
+//----------------------------------------------------------------------------------
+// Pacing Module Functions
+//----------------------------------------------------------------------------------
+
+// Initialize pacing state (starts in the drawing, non-idle mode)
+//
+// Must be called after InitWindow; sets the raylib target FPS for the chosen mode.
+void InitPacing(PacingManager *pm, PacingMode mode);
+
+// Parse a pacing mode name ("capped", "lowlatency" or "uncapped")
+//
+// @return true and sets *mode if name is recognised
+bool ParsePacingMode(const char *name, PacingMode *mode);
+
+// Name of a pacing mode, as accepted by ParsePacingMode
+const char *GetPacingModeName(PacingMode mode);
+
+// Call at the top of each loop iteration, before game logic reads input
+//
+// While idle on desktop this blocks until an input event arrives or IDLE_WAIT_TIMEOUT
+// passes. Otherwise it sleeps as the pacing mode requires and then samples input.
+// On web it returns immediately (the loop is throttled by the target FPS instead).
+void WaitForFrameEvents(PacingManager *pm);
+
+// Time the current frame covers, for the simulation (use instead of GetFrameTime)
+//
+// Measured between input samples. The first frame after idling counts as one frame period,
+// where raylib's frame time would span the whole idle stretch.
+float GetPacingFrameTime(const PacingManager *pm);
+
+// Present the frame; replaces EndDrawing and records latency statistics
+void PresentFrame(PacingManager *pm);
+
+// Return and reset input-to-present latency statistics (milliseconds)
+//
+// @return Number of frames the statistics cover (0 if none were presented)
+int TakePacingLatency(PacingManager *pm, double *averageMs, double *maxMs);
+
+// Mark the frame as needing a redraw (e.g. after an asynchronous request completes)
+void MarkFrameDirty(PacingManager *pm);
+
+// Decide whether this frame should be drawn
+//
+// @param gameState Current game state (changes always force a redraw)
+// @param staticScreen True if the current screen looks identical unless input or data changes
+// @return True if the caller should draw and present this frame
+bool UpdateFramePacing(PacingManager *pm, int gameState, bool staticScreen);
+
+// Present nothing for a frame that was skipped by UpdateFramePacing
+//
+// On web this still runs an empty BeginDrawing/EndDrawing so the loop yields to the browser
+// and input is polled; the canvas keeps showing the previous image. On desktop it does nothing.
+void SkipFrame(PacingManager *pm);
+
+#endif // PACING_H
@@ -0,0 +1,387 @@
+//================================================================================================
+//
+//   replay.c - Input recording and replay implementation
+//
+//   See replay.h for module interface documentation and the file layout.
+//
+//   Implementation notes:
+//   - The tick encoding is a pure function of (previous tick, tick), and decoding inverts
+//     it, so playback reconstructs every GameInput exactly
+//   - Files are flushed per tick while recording, so a crash still leaves a usable prefix
+//   - Every decoded field is range-checked before it is narrowed to int, so a damaged or
+//     hand-edited file ends playback at the bad tick instead of feeding StepGame a bad dt,
+//     a zero screen size or a wrapped value
+//   - Snapshots are plain GameSession copies, taken the first time playback reaches each
+//     interval boundary; seeking forward past the last one simulates without rendering
+//
+//================================================================================================
+
+#include "replay.h"
+#include "config.h"
+#include "raymath.h"
+#include "textcache.h"
+#include <limits.h>
+#include <stdlib.h>
+#include <string.h>
+
+// Bits of the per-tick flags varint
+#define REPLAY_FLAG_FIRE 0x01
+#define REPLAY_FLAG_FORCE_FIELD 0x02
+#define REPLAY_FLAG_MOUSE 0x04
+#define REPLAY_FLAG_DT 0x08
+#define REPLAY_FLAG_RESIZE 0x10
+
+// Longest tick a recording may hold (what BuildGameInput clamps to)
+#define REPLAY_MAX_DT_MICROS ((int64_t)(GAME_MAX_DT * 1e6f + 0.5f))
+
+static const char replayMagic[4] = {'T', 'G', 'R', 'P'};
+static const char replayHelp[] = "SPACE pause   LEFT/RIGHT seek   hold F fast-forward   click bar to scrub";
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// Write an unsigned LEB128 varint
+static void WriteVarint(FILE *file, uint64_t value);
+
+// Write a signed value as a zigzag varint
+static void WriteSignedVarint(FILE *file, int64_t value);
+
+// Read an unsigned varint
+//
+// @return false on end of file or an over-long encoding
+static bool ReadVarint(FILE *file, uint64_t *value);
+
+// Read a zigzag varint written by WriteSignedVarint
+static bool ReadSignedVarint(FILE *file, int64_t *value);
+
+// Report a tick whose field is out of range
+//
+// @return false, so the tick reads as the end of the recording
+static bool RejectReplayTick(const ReplayFile *replay, const char *field);
+
+// Screen rectangle of the scrub bar
+static Rectangle GetReplayBarRect(void);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see replay.h for documentation)
+//----------------------------------------------------------------------------------
+
+bool BeginReplayRecording(ReplayFile *replay, const char *path, uint64_t seed, int screenWidth, int screenHeight)
+{
+    *replay = (ReplayFile){0};
+    replay->file = fopen(path, "wb");
+    if (replay->file == NULL) {
+        fprintf(stderr, "Cannot create replay file: %s\n", path);
+        return false;
+    }
+    replay->recording = true;
+    replay->seed = seed;
+    replay->last.screenWidth = screenWidth;
+    replay->last.screenHeight = screenHeight;
+
+    fwrite(replayMagic, 1, sizeof(replayMagic), replay->file);
+    WriteVarint(replay->file, REPLAY_VERSION);
+    WriteVarint(replay->file, seed);
+    WriteVarint(replay->file, (uint64_t)screenWidth);
+    WriteVarint(replay->file, (uint64_t)screenHeight);
+    fflush(replay->file);
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// WriteReplayTick - Implementation Notes:
+// - Fields are written in flag-bit order; ReadReplayTick reads them in the same order
+//----------------------------------------------------------------------------------
+void WriteReplayTick(ReplayFile *replay, const GameInput *input)
+{
+    if (replay->file == NULL || !replay->recording) return;
+    const GameInput *last = &replay->last;
+
+    unsigned int flags = 0;
+    if (input->fire) flags |= REPLAY_FLAG_FIRE;
+    if (input->forceField) flags |= REPLAY_FLAG_FORCE_FIELD;
+    if (input->mouseDx != 0 || input->mouseDy != 0) flags |= REPLAY_FLAG_MOUSE;
+    if (input->dtMicros != last->dtMicros) flags |= REPLAY_FLAG_DT;
+    if (input->screenWidth != last->screenWidth || input->screenHeight != last->screenHeight)
+        flags |= REPLAY_FLAG_RESIZE;
+
+    WriteVarint(replay->file, flags);
+    if (flags & REPLAY_FLAG_DT) WriteSignedVarint(replay->file, (int64_t)input->dtMicros - last->dtMicros);
+    if (flags & REPLAY_FLAG_MOUSE) {
+        WriteSignedVarint(replay->file, input->mouseDx);
+        WriteSignedVarint(replay->file, input->mouseDy);
+    }
+    if (flags & REPLAY_FLAG_FIRE) WriteVarint(replay->file, (uint64_t)input->fireAgeMicros);
+    if (flags & REPLAY_FLAG_RESIZE) {
+        WriteVarint(replay->file, (uint64_t)input->screenWidth);
+        WriteVarint(replay->file, (uint64_t)input->screenHeight);
+    }
+    fflush(replay->file);
+
+    replay->last = *input;
+    replay->ticks++;
+}
+
+bool OpenReplay(ReplayFile *replay, const char *path)
+{
+    *replay = (ReplayFile){0};
+    replay->file = fopen(path, "rb");
+    if (replay->file == NULL) {
+        fprintf(stderr, "Cannot open replay file: %s\n", path);
+        return false;
+    }
+
+    char magic[sizeof(replayMagic)];
+    uint64_t version, width, height;
+    if (fread(magic, 1, sizeof(magic), replay->file) != sizeof(magic) ||
+        memcmp(magic, replayMagic, sizeof(magic)) != 0 || !ReadVarint(replay->file, &version) ||
+        version != REPLAY_VERSION || !ReadVarint(replay->file, &replay->seed) || !ReadVarint(replay->file, &width) ||
+        !ReadVarint(replay->file, &height) || width == 0 || height == 0 || width > INT_MAX || height > INT_MAX) {
+        fprintf(stderr, "Not a version %d Tailgunner replay: %s\n", REPLAY_VERSION, path);
+        CloseReplay(replay);
+        return false;
+    }
+    replay->last.screenWidth = (int)width;
+    replay->last.screenHeight = (int)height;
+    return true;
+}
+
+bool ReadReplayTick(ReplayFile *replay, GameInput *input)
+{
+    if (replay->file == NULL || replay->recording) return false;
+
+    uint64_t flags;
+    if (!ReadVarint(replay->file, &flags)) return false;
+
+    GameInput next = replay->last;
+    next.fire = (flags & REPLAY_FLAG_FIRE) != 0;
+    next.forceField = (flags & REPLAY_FLAG_FORCE_FIELD) != 0;
+    next.mouseDx = 0;
+    next.mouseDy = 0;
+    next.fireAgeMicros = 0;
+
+    int64_t s;
+    uint64_t u;
+    if (flags & REPLAY_FLAG_DT) {
+        if (!ReadSignedVarint(replay->file, &s)) return false;
+        if (s < -(int64_t)replay->last.dtMicros || s > REPLAY_MAX_DT_MICROS - replay->last.dtMicros)
+            return RejectReplayTick(replay, "tick length");
+        next.dtMicros = (int)(replay->last.dtMicros + s);
+    }
+    if (flags & REPLAY_FLAG_MOUSE) {
+        int64_t dy;
+        if (!ReadSignedVarint(replay->file, &s) || !ReadSignedVarint(replay->file, &dy)) return false;
+        if (s < INT_MIN || s > INT_MAX || dy < INT_MIN || dy > INT_MAX) return RejectReplayTick(replay, "mouse delta");
+        next.mouseDx = (int)s;
+        next.mouseDy = (int)dy;
+    }
+    if (flags & REPLAY_FLAG_FIRE) {
+        if (!ReadVarint(replay->file, &u)) return false;
+        if (u > INT_MAX) return RejectReplayTick(replay, "fire age");
+        next.fireAgeMicros = (int)u;
+    }
+    if (flags & REPLAY_FLAG_RESIZE) {
+        uint64_t height;
+        if (!ReadVarint(replay->file, &u) || !ReadVarint(replay->file, &height)) return false;
+        if (u == 0 || height == 0 || u > INT_MAX || height > INT_MAX) return RejectReplayTick(replay, "screen size");
+        next.screenWidth = (int)u;
+        next.screenHeight = (int)height;
+    }
+
+    *input = next;
+    replay->last = next;
+    replay->ticks++;
+    return true;
+}
+
+void CloseReplay(ReplayFile *replay)
+{
+    if (replay->file != NULL) fclose(replay->file);
+    replay->file = NULL;
+}
+
+bool LoadReplay(ReplayPlayer *player, const char *path)
+{
+    *player = (ReplayPlayer){0};
+    ReplayFile file;
+    if (!OpenReplay(&file, path)) return false;
+    player->seed = file.seed;
+    player->screenWidth = file.last.screenWidth;
+    player->screenHeight = file.last.screenHeight;
+
+    int capacity = 0;
+    GameInput input;
+    while (ReadReplayTick(&file, &input)) {
+        if (player->tickCount == capacity) {
+            capacity = (capacity == 0) ? 4096 : capacity * 2;
+            GameInput *ticks = (GameInput *)realloc(player->ticks, capacity * sizeof(GameInput));
+            if (ticks == NULL) {
+                fprintf(stderr, "Not enough memory to load replay: %s\n", path);
+                CloseReplay(&file);
+                UnloadReplay(player);
+                return false;
+            }
+            player->ticks = ticks;
+        }
+        player->ticks[player->tickCount++] = input;
+    }
+    CloseReplay(&file);
+    if (player->tickCount == 0) {
+        // Playback is keyed on ticks != NULL, so an empty replay would silently start a live game
+        fprintf(stderr, "Replay has no playable ticks: %s\n", path);
+        UnloadReplay(player);
+        return false;
+    }
+
+    player->snapshots =
+        (GameSession *)calloc(player->tickCount / REPLAY_SNAPSHOT_INTERVAL + 1, sizeof(GameSession));
+    if (player->snapshots == NULL) {
+        fprintf(stderr, "Not enough memory to load replay: %s\n", path);
+        UnloadReplay(player);
+        return false;
+    }
+    return true;
+}
+
+void UnloadReplay(ReplayPlayer *player)
+{
+    free(player->ticks);
+    free(player->snapshots);
+    *player = (ReplayPlayer){0};
+}
+
+void StartReplay(ReplayPlayer *player, GameSession *session, Camera camera)
+{
+    InitGameSession(session, camera, player->seed, player->screenWidth, player->screenHeight);
+    player->snapshots[0] = *session;
+    if (player->snapshotCount == 0) player->snapshotCount = 1;
+}
+
+int StepReplay(ReplayPlayer *player, GameSession *session)
+{
+    if (session->tick >= player->tickCount) return -1;
+
+    int events = StepGame(session, &player->ticks[session->tick]);
+
+    if (session->tick % REPLAY_SNAPSHOT_INTERVAL == 0 &&
+        session->tick / REPLAY_SNAPSHOT_INTERVAL == player->snapshotCount) {
+        player->snapshots[player->snapshotCount++] = *session;
+    }
+    return events;
+}
+
+//----------------------------------------------------------------------------------
+// SeekReplay - Implementation Notes:
+// - Seeking forward within the current interval keeps simulating from where we are
+//----------------------------------------------------------------------------------
+void SeekReplay(ReplayPlayer *player, GameSession *session, int tick)
+{
+    if (tick < 0) tick = 0;
+    if (tick > player->tickCount) tick = player->tickCount;
+
+    int k = tick / REPLAY_SNAPSHOT_INTERVAL;
+    if (k >= player->snapshotCount) k = player->snapshotCount - 1;
+    int snapshotTick = k * REPLAY_SNAPSHOT_INTERVAL;
+    if (session->tick < snapshotTick || session->tick > tick) *session = player->snapshots[k];
+
+    while (session->tick < tick) {
+        StepReplay(player, session);
+    }
+}
+
+int UpdateReplayControls(ReplayPlayer *player, GameSession *session)
+{
+    if (IsKeyPressed(KEY_SPACE)) player->paused = !player->paused;
+    if (IsKeyPressed(KEY_RIGHT)) SeekReplay(player, session, session->tick + REPLAY_SEEK_STEP);
+    if (IsKeyPressed(KEY_LEFT)) SeekReplay(player, session, session->tick - REPLAY_SEEK_STEP);
+
+    Rectangle bar = GetReplayBarRect();
+    Rectangle grab = {bar.x, bar.y - 10, bar.width, bar.height + 20}; // Easier to hit than the bar itself
+    Vector2 mouse = GetMousePosition();
+    if (IsMouseButtonPressed(MOUSE_BUTTON_LEFT) && CheckCollisionPointRec(mouse, grab)) player->scrubbing = true;
+    if (IsMouseButtonReleased(MOUSE_BUTTON_LEFT)) player->scrubbing = false;
+    if (player->scrubbing) {
+        float fraction = Clamp((mouse.x - bar.x) / bar.width, 0.0f, 1.0f);
+        SeekReplay(player, session, (int)(fraction * player->tickCount));
+        return 0;
+    }
+
+    if (player->paused || session->tick >= player->tickCount) return 0;
+    return IsKeyDown(KEY_F) ? REPLAY_FAST_FORWARD_TICKS : 1;
+}
+
+//----------------------------------------------------------------------------------
+// DrawReplayBar - Implementation Notes:
+// - Progress text changes every tick, so it uses DrawText rather than the text cache
+//----------------------------------------------------------------------------------
+void DrawReplayBar(const ReplayPlayer *player, const GameSession *session)
+{
+    Rectangle bar = GetReplayBarRect();
+    float fraction = (player->tickCount > 0) ? (float)session->tick / player->tickCount : 0.0f;
+
+    DrawRectangle((int)bar.x, (int)bar.y, (int)(bar.width * fraction), (int)bar.height, COLOR_BUTTON_BOX);
+    DrawRectangleLinesEx(bar, 1, COLOR_BUTTON_BOX);
+    for (int k = 1; k < player->snapshotCount; k++) {
+        int x = (int)(bar.x + bar.width * k * REPLAY_SNAPSHOT_INTERVAL / player->tickCount);
+        DrawLine(x, (int)bar.y + (int)bar.height, x, (int)bar.y + (int)bar.height + 4, COLOR_TEXT_SUBTITLE);
+    }
+
+    DrawText(TextFormat("%d / %d  %.1f s%s", session->tick, player->tickCount, session->simTime,
+                        player->paused ? "  PAUSED" : ""),
+             (int)bar.x, (int)bar.y - 22, 20, COLOR_TEXT_SUBTITLE);
+    DrawTextCached(replayHelp, (int)(bar.x + bar.width) - MeasureTextCached(replayHelp, 10), (int)bar.y - 14, 10,
+                   COLOR_TEXT_SUBTITLE);
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static bool RejectReplayTick(const ReplayFile *replay, const char *field)
+{
+    fprintf(stderr, "Malformed replay: bad %s at tick %d, playback stops there\n", field, replay->ticks);
+    return false;
+}
+
+static Rectangle GetReplayBarRect(void)
+{
+    return (Rectangle){20.0f, (float)GetScreenHeight() - 30.0f, (float)GetScreenWidth() - 40.0f, 10.0f};
+}
+
+static void WriteVarint(FILE *file, uint64_t value)
+{
+    while (value >= 0x80) {
+        fputc((int)((value & 0x7f) | 0x80), file);
+        value >>= 7;
+    }
+    fputc((int)value, file);
+}
+
+static void WriteSignedVarint(FILE *file, int64_t value)
+{
+    WriteVarint(file, ((uint64_t)value << 1) ^ (uint64_t)(value >> 63));
+}
+
+static bool ReadVarint(FILE *file, uint64_t *value)
+{
+    uint64_t result = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+        int c = fgetc(file);
+        if (c == EOF) return false;
+        result |= (uint64_t)(c & 0x7f) << shift;
+        if ((c & 0x80) == 0) {
+            *value = result;
+            return true;
+        }
+    }
+    return false;
+}
+
+static bool ReadSignedVarint(FILE *file, int64_t *value)
+{
+    uint64_t u;
+    if (!ReadVarint(file, &u)) return false;
+    *value = (int64_t)(u >> 1) ^ -(int64_t)(u & 1);
+    return true;
+}
@@ -0,0 +1,109 @@
+//================================================================================================
+//
+//   replay.h - Input recording and replay for Tailgunner
+//
+//   Records one game as the simulation seed plus the GameInput of every tick, and plays
+//   such a file back. File layout (all integers are LEB128 varints, signed ones zigzag):
+//
+//     header: "TGRP" version seed screenWidth screenHeight
+//     tick:   flags [dDt] [mouseDx mouseDy] [fireAge] [screenWidth screenHeight]
+//
+//   Each tick only stores what changed: the tick length as a delta from the previous tick,
+//   mouse movement when non-zero, the click age when firing, the screen size when resized.
+//   A tick with no input and an unchanged frame time is a single zero byte.
+//
+//   ReplayPlayer loads a whole recording for viewing. While simulating it copies the
+//   GameSession every REPLAY_SNAPSHOT_INTERVAL ticks, so seeking to any tick restores the
+//   nearest earlier snapshot and simulates at most one interval (no rendering) from there.
+//
+//================================================================================================
+
+#ifndef REPLAY_H
+#define REPLAY_H
+
+#include "game.h"
+#include <stdint.h>
+#include <stdio.h>
+
+#define REPLAY_VERSION 1
+
+// Open recording or replay file
+typedef struct ReplayFile {
+    FILE *file;
+    bool recording; // Writing (true) or reading (false)
+    uint64_t seed;  // Simulation seed from the header
+    GameInput last; // Previous tick; ticks are encoded relative to it
+    int ticks;      // Ticks written or read so far
+} ReplayFile;
+
+// Recording loaded for playback, with the snapshots taken so far
+typedef struct ReplayPlayer {
+    uint64_t seed;
+    int screenWidth; // Screen size at the start of the recording
+    int screenHeight;
+    GameInput *ticks; // Every tick of the recording
+    int tickCount;
+    GameSession *snapshots; // snapshots[k] is the session before tick k * REPLAY_SNAPSHOT_INTERVAL
+    int snapshotCount;      // Snapshots taken so far (they are taken in order)
+    bool paused;
+    bool scrubbing; // Scrub bar is being dragged
+} ReplayPlayer;
+
+//----------------------------------------------------------------------------------
+// Replay Module Functions
+//----------------------------------------------------------------------------------
+
+// Create a recording and write its header
+//
+// @return false (with a message on stderr) if the file cannot be created
+bool BeginReplayRecording(ReplayFile *replay, const char *path, uint64_t seed, int screenWidth, int screenHeight);
+
+// Append one tick of input to a recording
+void WriteReplayTick(ReplayFile *replay, const GameInput *input);
+
+// Open a recording for playback and read its header (seed and initial screen size)
+//
+// @return false (with a message on stderr) if the file is missing or not a valid replay
+bool OpenReplay(ReplayFile *replay, const char *path);
+
+// Read the next tick of a replay
+//
+// @return false at the end of the recording, or on a truncated or malformed tick (a tick
+//         length outside 0..GAME_MAX_DT, a screen size outside 1..INT_MAX, a mouse delta
+//         outside the int range or a fire age outside 0..INT_MAX)
+bool ReadReplayTick(ReplayFile *replay, GameInput *input);
+
+// Close a recording or replay (safe to call on a closed one)
+void CloseReplay(ReplayFile *replay);
+
+// Read a whole recording into memory for playback
+//
+// @return false (with a message on stderr) if it cannot be read or holds no playable tick
+bool LoadReplay(ReplayPlayer *player, const char *path);
+
+// Free a loaded recording and its snapshots
+void UnloadReplay(ReplayPlayer *player);
+
+// Start a session at the beginning of the recording
+void StartReplay(ReplayPlayer *player, GameSession *session, Camera camera);
+
+// Simulate the next tick of the recording, taking a snapshot when one is due
+//
+// @return GameEvent flags, or -1 when the recording has ended
+int StepReplay(ReplayPlayer *player, GameSession *session);
+
+// Move session to the state before tick (clamped to the recording)
+//
+// Restores the nearest snapshot at or before tick and simulates forward from it; seeking
+// past the last snapshot taken simulates (and snapshots) everything up to tick.
+void SeekReplay(ReplayPlayer *player, GameSession *session, int tick);
+
+// Handle viewer controls: SPACE pause, LEFT/RIGHT seek, click or drag on the scrub bar
+//
+// @return Number of ticks to simulate this frame (0 while paused, more while F is held)
+int UpdateReplayControls(ReplayPlayer *player, GameSession *session);
+
+// Draw the scrub bar with the current position and the snapshot marks
+void DrawReplayBar(const ReplayPlayer *player, const GameSession *session);
+
+#endif // REPLAY_H
@@ -0,0 +1,125 @@
+//================================================================================================
+//
+//   resolution.c - Dynamic resolution scaling implementation
+//
+//   See resolution.h for module interface documentation.
+//
+//   Implementation notes:
+//   - The render target is allocated at window size once and the scene is drawn into a
+//     scaled viewport, so changing scale never reallocates GPU memory
+//   - Controller: frame time is smoothed with an EMA; above DYNRES_HIGH_WATER x budget the
+//     scale drops in proportion to the overrun, and after probeDelay seconds within budget
+//     it is raised by DYNRES_STEP_UP. A raise that is undone within DYNRES_PROBE_FAIL_TIME
+//     doubles probeDelay so the scale does not oscillate around the limit
+//   - Frame time with SetTargetFPS is capped at the budget, so headroom can only be found
+//     by probing upwards
+//
+//================================================================================================
+
+#include "resolution.h"
+#include "config.h"
+#include "raymath.h"
+#include "rlgl.h"
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see resolution.h for documentation)
+//----------------------------------------------------------------------------------
+
+void InitResolutionScaler(ResolutionScaler *rs)
+{
+    *rs = (ResolutionScaler){0};
+    rs->scale = 1.0f;
+    rs->smoothedFrameTime = 1.0f / TARGET_FPS;
+    rs->probeDelay = DYNRES_PROBE_DELAY;
+}
+
+void UnloadResolutionScaler(ResolutionScaler *rs)
+{
+    if (rs->target.id != 0) UnloadRenderTexture(rs->target);
+    rs->target = (RenderTexture2D){0};
+    rs->targetWidth = 0;
+    rs->targetHeight = 0;
+}
+
+void UpdateResolutionScale(ResolutionScaler *rs, float frameTime)
+{
+#if DYNRES_ENABLED
+    const float budget = 1.0f / TARGET_FPS;
+
+    // Ignore one-off stalls (window drag, state changes) that say nothing about GPU load
+    if (frameTime <= 0.0f || frameTime > DYNRES_MAX_SAMPLE) return;
+
+    rs->smoothedFrameTime += DYNRES_SMOOTHING * (frameTime - rs->smoothedFrameTime);
+    rs->timeSinceRaise += frameTime;
+
+    if (rs->smoothedFrameTime > budget * DYNRES_HIGH_WATER) {
+        // A raise that did not fit the budget: wait longer before probing again
+        if (rs->timeSinceRaise < DYNRES_PROBE_FAIL_TIME) {
+            rs->probeDelay = fminf(rs->probeDelay * 2.0f, DYNRES_PROBE_DELAY_MAX);
+        }
+        float overrun = rs->smoothedFrameTime / budget - 1.0f;
+        rs->scale = Clamp(rs->scale - DYNRES_STEP_DOWN_GAIN * overrun, DYNRES_MIN_SCALE, 1.0f);
+        rs->timeInBudget = 0.0f;
+        // Restart smoothing at the budget so one overrun does not drive several steps
+        rs->smoothedFrameTime = budget;
+        rs->timeSinceRaise = DYNRES_PROBE_FAIL_TIME;
+    }
+    else {
+        rs->timeInBudget += frameTime;
+        if (rs->scale < 1.0f && rs->timeInBudget >= rs->probeDelay) {
+            rs->scale = Clamp(rs->scale + DYNRES_STEP_UP, DYNRES_MIN_SCALE, 1.0f);
+            rs->timeInBudget = 0.0f;
+            rs->timeSinceRaise = 0.0f;
+        }
+    }
+#else
+    (void)rs;
+    (void)frameTime;
+#endif
+}
+
+//----------------------------------------------------------------------------------
+// BeginScenePass - Implementation Notes:
+// - Recreates the target when the window size changes
+// - Viewport is set after BeginTextureMode; BeginMode3D takes its aspect ratio from the
+//   full target, which matches the window, so the projection is unchanged
+//----------------------------------------------------------------------------------
+void BeginScenePass(ResolutionScaler *rs, Camera camera)
+{
+    int width = GetScreenWidth();
+    int height = GetScreenHeight();
+    rs->sceneWidth = (int)(width * rs->scale);
+    rs->sceneHeight = (int)(height * rs->scale);
+    rs->offscreen = rs->scale < 1.0f && rs->sceneWidth > 0 && rs->sceneHeight > 0;
+
+    if (!rs->offscreen) {
+        BeginMode3D(camera);
+        return;
+    }
+
+    if (rs->target.id == 0 || rs->targetWidth != width || rs->targetHeight != height) {
+        if (rs->target.id != 0) UnloadRenderTexture(rs->target);
+        rs->target = LoadRenderTexture(width, height);
+        SetTextureFilter(rs->target.texture, TEXTURE_FILTER_BILINEAR);
+        rs->targetWidth = width;
+        rs->targetHeight = height;
+    }
+
+    BeginTextureMode(rs->target);
+    ClearBackground(COLOR_BACKGROUND);
+    rlViewport(0, 0, rs->sceneWidth, rs->sceneHeight);
+    BeginMode3D(camera);
+}
+
+void EndScenePass(ResolutionScaler *rs)
+{
+    EndMode3D();
+    if (!rs->offscreen) return;
+    EndTextureMode();
+
+    // Scene occupies the bottom-left (GL origin) region; negative height flips it upright
+    Rectangle source = {0.0f, 0.0f, (float)rs->sceneWidth, -(float)rs->sceneHeight};
+    Rectangle dest = {0.0f, 0.0f, (float)GetScreenWidth(), (float)GetScreenHeight()};
+    DrawTexturePro(rs->target.texture, source, dest, (Vector2){0.0f, 0.0f}, 0.0f, WHITE);
+    rs->offscreen = false;
+}
@@ -0,0 +1,56 @@
+//================================================================================================
+//
+//   resolution.h - Dynamic resolution scaling for the Tailgunner 3D scene
+//
+//   Renders the 3D pass (starfield, enemies, lasers) into an offscreen target at a
+//   scale that adapts to hold the frame-time budget, then upscales it to the window.
+//   2D overlays are drawn afterwards at native resolution so text stays sharp.
+//
+//================================================================================================
+
+#ifndef RESOLUTION_H
+#define RESOLUTION_H
+
+#include "config.h"
+#include "raylib.h"
+
+// Encapsulated scaler state to avoid globals
+typedef struct ResolutionScaler {
+    RenderTexture2D target;  // Window-sized target; the scene uses its lower-left scaled region
+    int targetWidth;         // Window size the target was created for
+    int targetHeight;
+    int sceneWidth;          // Pixel size of the scene region this frame
+    int sceneHeight;
+    bool offscreen;          // True while the current scene pass renders into target
+    float scale;             // Current render scale, DYNRES_MIN_SCALE..1
+    float smoothedFrameTime; // Exponential moving average of frame time (seconds)
+    float timeInBudget;      // Seconds the smoothed frame time has stayed within budget
+    float probeDelay;        // Seconds in budget required before trying a higher scale
+    float timeSinceRaise;    // Seconds since the scale was last raised
+} ResolutionScaler;
+
+//----------------------------------------------------------------------------------
+// Resolution Scaler Module Functions
+//----------------------------------------------------------------------------------
+
+// Initialize the scaler at full resolution (no render target is created until needed)
+void InitResolutionScaler(ResolutionScaler *rs);
+
+// Release the offscreen render target
+void UnloadResolutionScaler(ResolutionScaler *rs);
+
+// Feed the last frame time to the controller and adjust the render scale
+//
+// @param frameTime Duration of the previous frame in seconds (e.g. GetFrameTime())
+void UpdateResolutionScale(ResolutionScaler *rs, float frameTime);
+
+// Begin the 3D scene pass; replaces BeginMode3D
+//
+// At full scale this draws straight to the backbuffer (keeping MSAA); below full scale it
+// renders into the offscreen target. Must be called between BeginDrawing and EndDrawing.
+void BeginScenePass(ResolutionScaler *rs, Camera camera);
+
+// End the 3D scene pass; replaces EndMode3D and upscales the offscreen scene to the window
+void EndScenePass(ResolutionScaler *rs);
+
+#endif // RESOLUTION_H
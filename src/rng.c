@@ -0,0 +1,48 @@
+//================================================================================================
+//
+//   rng.c - Seedable random number generator implementation
+//
+//   See rng.h for module interface documentation.
+//
+//   Implementation notes:
+//   - PCG32 (XSH RR variant) with the reference multiplier and increment
+//   - Ranges use a plain modulo; the bias is negligible for the small ranges the game uses
+//
+//================================================================================================
+
+#include "rng.h"
+
+#define RNG_MULTIPLIER 6364136223846793005ULL
+#define RNG_INCREMENT 1442695040888963407ULL
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see rng.h for documentation)
+//----------------------------------------------------------------------------------
+
+void SeedRng(Rng *rng, uint64_t seed)
+{
+    rng->state = 0;
+    NextRng(rng);
+    rng->state += seed;
+    NextRng(rng);
+}
+
+uint32_t NextRng(Rng *rng)
+{
+    uint64_t old = rng->state;
+    rng->state = old * RNG_MULTIPLIER + RNG_INCREMENT;
+    uint32_t xorshifted = (uint32_t)(((old >> 18u) ^ old) >> 27u);
+    uint32_t rot = (uint32_t)(old >> 59u);
+    return (xorshifted >> rot) | (xorshifted << ((-rot) & 31u));
+}
+
+int GetRngValue(Rng *rng, int min, int max)
+{
+    if (min > max) {
+        int tmp = max;
+        max = min;
+        min = tmp;
+    }
+    uint32_t range = (uint32_t)(max - min) + 1u;
+    return min + (int)(NextRng(rng) % range);
+}
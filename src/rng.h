@@ -0,0 +1,33 @@
+//================================================================================================
+//
+//   rng.h - Seedable random number generator for Tailgunner
+//
+//   Small PCG32 generator owned by the simulation, so a seed fully determines enemy
+//   paths on every platform (raylib's GetRandomValue is global and platform dependent).
+//
+//================================================================================================
+
+#ifndef RNG_H
+#define RNG_H
+
+#include <stdint.h>
+
+// PCG32 generator state
+typedef struct Rng {
+    uint64_t state;
+} Rng;
+
+//----------------------------------------------------------------------------------
+// Random Number Functions
+//----------------------------------------------------------------------------------
+
+// Seed the generator; equal seeds give equal sequences
+void SeedRng(Rng *rng, uint64_t seed);
+
+// Next 32 random bits
+uint32_t NextRng(Rng *rng);
+
+// Random integer in [min, max] inclusive, like GetRandomValue
+int GetRngValue(Rng *rng, int min, int max);
+
+#endif // RNG_H
@@ -0,0 +1,216 @@
+//================================================================================================
+//
+//   savestate.c - GameSession save/restore implementation
+//
+//   See savestate.h for module interface documentation.
+//
+//   Implementation notes:
+//   - Saving is a header plus one memcpy; restoring validates the header and checksum
+//     before the memcpy, so a rejected blob never touches the session
+//   - The hash mixes 8 bytes per step, so it runs at close to memcpy speed on the few KB
+//     a session takes
+//   - The layout fingerprint hashes the struct sizes and array lengths, so changing
+//     WAVE_SIZE, MAX_LASERS or ENEMY_HISTORY_SIZE invalidates old blobs automatically
+//   - Web storage holds the blob as hex text (session storage only stores strings)
+//
+//================================================================================================
+
+#include "savestate.h"
+#include "config.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(PLATFORM_WEB)
+#include <emscripten/emscripten.h>
+#endif
+
+#define SAVE_STATE_HASH_SEED 0xcbf29ce484222325ull // FNV-1a 64-bit offset basis
+#define SAVE_STATE_HASH_PRIME 0x100000001b3ull     // FNV-1a 64-bit prime
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// Continue hash h over size bytes of data (any alignment)
+static uint64_t HashBytes(const void *data, size_t size, uint64_t h);
+
+// Fingerprint of the GameSession layout this build uses
+static uint32_t GetLayoutFingerprint(void);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see savestate.h for documentation)
+//----------------------------------------------------------------------------------
+
+size_t SaveGameSession(const GameSession *session, void *buffer, size_t capacity)
+{
+    if (capacity < SAVE_STATE_SIZE) return 0;
+
+    SaveStateHeader header = {0};
+    header.magic = SAVE_STATE_MAGIC;
+    header.version = SAVE_STATE_VERSION;
+    header.size = (uint32_t)sizeof(GameSession);
+    header.layout = GetLayoutFingerprint();
+    header.checksum = HashGameSession(session);
+
+    memcpy(buffer, &header, sizeof(header));
+    memcpy((unsigned char *)buffer + sizeof(header), session, sizeof(GameSession));
+    return SAVE_STATE_SIZE;
+}
+
+bool RestoreGameSession(GameSession *session, const void *buffer, size_t size)
+{
+    if (size < SAVE_STATE_SIZE) return false;
+
+    SaveStateHeader header;
+    memcpy(&header, buffer, sizeof(header));
+    if (header.magic != SAVE_STATE_MAGIC || header.version != SAVE_STATE_VERSION) return false;
+    if (header.size != sizeof(GameSession) || header.layout != GetLayoutFingerprint()) return false;
+
+    const unsigned char *payload = (const unsigned char *)buffer + sizeof(header);
+    if (HashBytes(payload, sizeof(GameSession), SAVE_STATE_HASH_SEED) != header.checksum) return false;
+
+    memcpy(session, payload, sizeof(GameSession));
+    return true;
+}
+
+uint64_t HashGameSession(const GameSession *session)
+{
+    return HashBytes(session, sizeof(*session), SAVE_STATE_HASH_SEED);
+}
+
+void CloneGameSession(GameSession *dst, const GameSession *src)
+{
+    memcpy(dst, src, sizeof(*dst));
+}
+
+#if defined(PLATFORM_WEB)
+#define SAVE_STATE_STORAGE_KEY "tailgunner_session"
+// clang-format off
+EM_JS(int, emscripten_session_storage_set_hex_js, (const char* key_ptr, const unsigned char* data, int size), {
+  var hex = new Array(size);
+  for (var i = 0; i < size; i++) {
+    hex[i] = (HEAPU8[data + i] + 0x100).toString(16).substring(1);
+  }
+  try {
+    sessionStorage.setItem(UTF8ToString(key_ptr), hex.join(''));
+    return 0; // Success
+  } catch (e) {
+    return 1; // Failure (storage full or disabled)
+  }
+});
+
+EM_JS(int, emscripten_session_storage_get_hex_js, (const char* key_ptr, unsigned char* data, int size), {
+  var hex = null;
+  try {
+    hex = sessionStorage.getItem(UTF8ToString(key_ptr));
+  } catch (e) {
+  }
+  if (hex === null || hex.length !== size * 2) return 0;
+  for (var i = 0; i < size; i++) {
+    HEAPU8[data + i] = parseInt(hex.substr(i * 2, 2), 16);
+  }
+  return size;
+});
+
+EM_JS(void, emscripten_session_storage_remove_js, (const char* key_ptr), {
+  try {
+    sessionStorage.removeItem(UTF8ToString(key_ptr));
+  } catch (e) {
+  }
+});
+// clang-format on
+
+bool SuspendGameSession(const GameSession *session)
+{
+    unsigned char blob[SAVE_STATE_SIZE];
+    size_t size = SaveGameSession(session, blob, sizeof(blob));
+    return emscripten_session_storage_set_hex_js(SAVE_STATE_STORAGE_KEY, blob, (int)size) == 0;
+}
+
+bool ResumeGameSession(GameSession *session)
+{
+    unsigned char blob[SAVE_STATE_SIZE];
+    int size = emscripten_session_storage_get_hex_js(SAVE_STATE_STORAGE_KEY, blob, (int)sizeof(blob));
+    // Resume at most once, even if the restored game is left again before it is re-saved
+    emscripten_session_storage_remove_js(SAVE_STATE_STORAGE_KEY);
+    if (size == 0) return false;
+    if (!RestoreGameSession(session, blob, (size_t)size)) {
+        TraceLog(LOG_WARNING, "SAVESTATE: Suspended game is from another version or corrupt, ignored");
+        return false;
+    }
+    return true;
+}
+
+void ClearSuspendedGameSession(void)
+{
+    emscripten_session_storage_remove_js(SAVE_STATE_STORAGE_KEY);
+}
+#else
+bool SuspendGameSession(const GameSession *session)
+{
+    (void)session;
+    return false;
+}
+
+bool ResumeGameSession(GameSession *session)
+{
+    (void)session;
+    return false;
+}
+
+void ClearSuspendedGameSession(void)
+{
+}
+#endif
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+//----------------------------------------------------------------------------------
+// HashBytes - Implementation Notes:
+// - FNV-1a over 64-bit words instead of bytes, with a shift after each multiply so high
+//   bits feed back into the low ones; the tail is hashed a byte at a time
+// - Finished with the splitmix64 finalizer so nearby sessions give unrelated hashes
+//----------------------------------------------------------------------------------
+static uint64_t HashBytes(const void *data, size_t size, uint64_t h)
+{
+    const unsigned char *p = (const unsigned char *)data;
+    for (; size >= sizeof(uint64_t); p += sizeof(uint64_t), size -= sizeof(uint64_t)) {
+        uint64_t word;
+        memcpy(&word, p, sizeof(word));
+        h = (h ^ word) * SAVE_STATE_HASH_PRIME;
+        h ^= h >> 32;
+    }
+    for (; size > 0; p++, size--) {
+        h = (h ^ *p) * SAVE_STATE_HASH_PRIME;
+    }
+
+    h ^= h >> 30;
+    h *= 0xbf58476d1ce4e5b9ull;
+    h ^= h >> 27;
+    h *= 0x94d049bb133111ebull;
+    h ^= h >> 31;
+    return h;
+}
+
+static uint32_t GetLayoutFingerprint(void)
+{
+    const uint32_t layout[] = {
+        (uint32_t)sizeof(GameSession),
+        (uint32_t)sizeof(LaserManager),
+        (uint32_t)sizeof(EnemyManager),
+        (uint32_t)sizeof(ForceFieldManager),
+        (uint32_t)sizeof(Enemy),
+        (uint32_t)sizeof(Laser),
+        (uint32_t)offsetof(GameSession, lasers),
+        (uint32_t)offsetof(GameSession, enemies),
+        (uint32_t)offsetof(GameSession, forceField),
+        (uint32_t)offsetof(Enemy, history),
+        WAVE_SIZE,
+        MAX_LASERS,
+        ENEMY_HISTORY_SIZE,
+    };
+    uint64_t h = HashBytes(layout, sizeof(layout), SAVE_STATE_HASH_SEED);
+    return (uint32_t)(h ^ (h >> 32));
+}
@@ -0,0 +1,80 @@
+//================================================================================================
+//
+//   savestate.h - GameSession save/restore for Tailgunner
+//
+//   Saves a GameSession to a flat binary blob and restores it, checks two sessions for
+//   equality by hash, and (web only) keeps a suspended game in session storage so a tab the
+//   mobile browser discards in the background resumes where it left off.
+//
+//   Blob layout: SaveStateHeader followed by the raw GameSession bytes. GameSession has no
+//   pointers, so the blob can be stored, sent or loaded at any address. The header records
+//   the layout it was written with; a blob from a build with a different layout, a
+//   different byte order or a bad checksum is rejected rather than misread.
+//
+//================================================================================================
+
+#ifndef SAVESTATE_H
+#define SAVESTATE_H
+
+#include "config.h"
+#include "game.h"
+#include <stddef.h>
+#include <stdint.h>
+
+// Bump when a GameSession field changes meaning without changing the struct layout
+#define SAVE_STATE_VERSION 1
+
+// Identifies a blob; also reads differently on a machine with the other byte order
+#define SAVE_STATE_MAGIC 0x53475454u // "TTGS" little-endian
+
+// Header at the start of every saved blob
+typedef struct SaveStateHeader {
+    uint32_t magic;    // SAVE_STATE_MAGIC
+    uint32_t version;  // SAVE_STATE_VERSION
+    uint32_t size;     // sizeof(GameSession) when written
+    uint32_t layout;   // Fingerprint of the struct layout and array sizes when written
+    uint64_t checksum; // HashGameSession of the payload
+} SaveStateHeader;
+
+// Bytes needed to save a GameSession
+#define SAVE_STATE_SIZE (sizeof(SaveStateHeader) + sizeof(GameSession))
+
+//----------------------------------------------------------------------------------
+// Save State Functions
+//----------------------------------------------------------------------------------
+
+// Save session into buffer
+//
+// @return Bytes written (SAVE_STATE_SIZE), or 0 if capacity is too small
+size_t SaveGameSession(const GameSession *session, void *buffer, size_t capacity);
+
+// Restore session from a blob written by SaveGameSession
+//
+// The buffer need not be aligned. On failure session is left unchanged.
+//
+// @return false if the blob is truncated, from another version or layout, or corrupt
+bool RestoreGameSession(GameSession *session, const void *buffer, size_t size);
+
+// 64-bit hash of the whole session, for determinism checks
+//
+// Equal sessions hash equally on the same build. Sessions must start from
+// InitGameSession (or a restore) so struct padding is zero.
+uint64_t HashGameSession(const GameSession *session);
+
+// Copy src to dst for what-if simulation; dst is independent of src afterwards
+void CloneGameSession(GameSession *dst, const GameSession *src);
+
+// Keep session in browser session storage until resumed or cleared (web only)
+//
+// @return true if stored; always false on desktop
+bool SuspendGameSession(const GameSession *session);
+
+// Restore and clear a session stored by SuspendGameSession (web only)
+//
+// @return true if a valid session was restored; always false on desktop
+bool ResumeGameSession(GameSession *session);
+
+// Drop any session stored by SuspendGameSession (web only)
+void ClearSuspendedGameSession(void);
+
+#endif // SAVESTATE_H
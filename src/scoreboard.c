@@ -0,0 +1,133 @@
+//================================================================================================
+//
+//   scoreboard.c - Large score board implementation
+//
+//   See scoreboard.h for module interface documentation.
+//
+//   Implementation notes:
+//   - A row's key packs its name bytes into the low 32 bits and its score into the high
+//     32; scores are positive, so no key is 0 and 0 can mark an empty slot
+//   - The set uses linear probing on a multiplicative hash and is never deleted from (only
+//     cleared), so no tombstones are needed. It doubles, and is rebuilt from the rows,
+//     before it gets more than half full
+//   - A row goes after every row with an equal or better score, found by binary search;
+//     only a score better than the last row's moves any rows
+//
+//================================================================================================
+
+#include "scoreboard.h"
+#include <stdlib.h>
+#include <string.h>
+
+#if LEADERBOARD_NAME_LENGTH > 4
+#error "Score board keys pack a name into 32 bits"
+#endif
+
+#define SCORE_BOARD_MIN_ROWS 64                           // First row allocation; doubled as rows are added
+#define SCORE_BOARD_HASH_MULTIPLIER 0x9e3779b97f4a7c15ull // 2^64 / golden ratio
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// Key of a (name, score) pair; never 0 for a positive score
+static uint64_t BoardKey(const char *name, int score);
+
+// Slot of key in the set, or of the empty slot where it would go
+static int FindKeySlot(const ScoreBoard *board, uint64_t key);
+
+// Make room for one more row and its key
+//
+// @return false if out of memory (the board is unchanged)
+static bool ReserveBoardRow(ScoreBoard *board);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see scoreboard.h for documentation)
+//----------------------------------------------------------------------------------
+
+bool AddBoardScore(ScoreBoard *board, const char *name, int score)
+{
+    if (score <= 0 || board->count == LEADERBOARD_BOARD_MAX_ROWS) return false;
+    uint64_t key = BoardKey(name, score);
+    if (board->keyCapacity > 0 && board->keys[FindKeySlot(board, key)] == key) return false;
+    if (!ReserveBoardRow(board)) return false;
+    board->keys[FindKeySlot(board, key)] = key;
+
+    // First row with a lower score
+    int low = 0;
+    int high = board->count;
+    while (low < high) {
+        int mid = low + (high - low) / 2;
+        if (board->rows[mid].score >= score)
+            low = mid + 1;
+        else
+            high = mid;
+    }
+    LeaderboardEntry *row = &board->rows[low];
+    memmove(row + 1, row, (size_t)(board->count - low) * sizeof(LeaderboardEntry));
+    strncpy(row->name, name, LEADERBOARD_NAME_LENGTH);
+    row->name[LEADERBOARD_NAME_LENGTH] = '\0';
+    row->score = score;
+    board->count++;
+    return true;
+}
+
+void ClearScoreBoard(ScoreBoard *board)
+{
+    board->count = 0;
+    if (board->keys != NULL) memset(board->keys, 0, (size_t)board->keyCapacity * sizeof(uint64_t));
+}
+
+void FreeScoreBoard(ScoreBoard *board)
+{
+    free(board->rows);
+    free(board->keys);
+    memset(board, 0, sizeof(*board));
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static uint64_t BoardKey(const char *name, int score)
+{
+    uint32_t packed = 0;
+    for (int i = 0; i < LEADERBOARD_NAME_LENGTH && name[i] != '\0'; i++) {
+        packed |= (uint32_t)(unsigned char)name[i] << (8 * i);
+    }
+    return ((uint64_t)(uint32_t)score << 32) | packed;
+}
+
+static int FindKeySlot(const ScoreBoard *board, uint64_t key)
+{
+    int mask = board->keyCapacity - 1;
+    int slot = (int)((key * SCORE_BOARD_HASH_MULTIPLIER) >> 32) & mask;
+    while (board->keys[slot] != 0 && board->keys[slot] != key) slot = (slot + 1) & mask;
+    return slot;
+}
+
+static bool ReserveBoardRow(ScoreBoard *board)
+{
+    if (board->count == board->capacity) {
+        int capacity = (board->capacity > 0) ? board->capacity * 2 : SCORE_BOARD_MIN_ROWS;
+        if (capacity > LEADERBOARD_BOARD_MAX_ROWS) capacity = LEADERBOARD_BOARD_MAX_ROWS;
+        LeaderboardEntry *rows = realloc(board->rows, (size_t)capacity * sizeof(LeaderboardEntry));
+        if (rows == NULL) return false;
+        board->rows = rows;
+        board->capacity = capacity;
+    }
+
+    if (2 * (board->count + 1) > board->keyCapacity) {
+        int keyCapacity = (board->keyCapacity > 0) ? board->keyCapacity * 2 : 2 * SCORE_BOARD_MIN_ROWS;
+        uint64_t *keys = calloc((size_t)keyCapacity, sizeof(uint64_t));
+        if (keys == NULL) return false;
+        free(board->keys);
+        board->keys = keys;
+        board->keyCapacity = keyCapacity;
+        for (int i = 0; i < board->count; i++) {
+            uint64_t key = BoardKey(board->rows[i].name, board->rows[i].score);
+            board->keys[FindKeySlot(board, key)] = key;
+        }
+    }
+    return true;
+}
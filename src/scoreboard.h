@@ -0,0 +1,49 @@
+//================================================================================================
+//
+//   scoreboard.h - Large score board for Tailgunner
+//
+//   Holds a global board of up to LEADERBOARD_BOARD_MAX_ROWS entries as it is paged in
+//   from the leaderboard service: one compact array kept sorted best score first, and a
+//   hash set of the (name, score) pairs in it, so overlapping pages and locally merged
+//   scores are de-duplicated in constant time per entry. Like leaderboard_parse.c it
+//   needs neither raylib nor an HTTP client.
+//
+//================================================================================================
+
+#ifndef SCOREBOARD_H
+#define SCOREBOARD_H
+
+#include "config.h"
+#include "leaderboard_parse.h"
+#include <stdbool.h>
+#include <stdint.h>
+
+// Sorted rows and their hash set; zero-initialised is an empty board
+typedef struct ScoreBoard {
+    LeaderboardEntry *rows; // Best score first; equal scores keep the order they were added in
+    int count;              // Rows in use
+    int capacity;           // Allocated rows
+    uint64_t *keys;         // Open-addressing set of the rows' (name, score) keys, 0 for an empty slot
+    int keyCapacity;        // Slots in keys: a power of two, at least twice count
+} ScoreBoard;
+
+//----------------------------------------------------------------------------------
+// Score Board Functions
+//----------------------------------------------------------------------------------
+
+// Add a row in score order unless the board already has it
+//
+// Scores of 0 or less are not kept (they are never shown). Adding rows in descending score
+// order, as pages arrive, appends without moving any.
+//
+// @return true if the row was added; false for a duplicate, when the board holds
+//         LEADERBOARD_BOARD_MAX_ROWS rows, or when out of memory
+bool AddBoardScore(ScoreBoard *board, const char *name, int score);
+
+// Remove every row, keeping the memory for the next fill
+void ClearScoreBoard(ScoreBoard *board);
+
+// Free the board's memory; it is then empty and can be filled again
+void FreeScoreBoard(ScoreBoard *board);
+
+#endif // SCOREBOARD_H
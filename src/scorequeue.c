@@ -0,0 +1,195 @@
+//================================================================================================
+//
+//   scorequeue.c - Durable score submission queue implementation
+//
+//   See scorequeue.h for module interface documentation.
+//
+//   Implementation notes:
+//   - The journal is a storage item ("scores" for the real service): one line per record, "add <id> <name> <score>"
+//     when a score is queued and "done <id>" once the service has answered for it. Loading
+//     replays it and rewrites it with only the open records, and it is emptied whenever the
+//     queue drains, so it stays a few lines long
+//   - A cut-short last line (crash mid-append) is ignored. A crash between the service
+//     accepting a score and its "done" record resubmits the score on the next run; the
+//     parsers already skip exact duplicates
+//   - The service has no multi-score action, so a backlog is sent one request per score,
+//     back to back, without waiting in between
+//   - Transport failures (timeouts included) and "try again later" statuses (408, 429 and
+//     5xx) back off, waiting at least as long as a Retry-After header asks, up to the cap;
+//     any other status is an answer, and a rejected (other 4xx) score is dropped rather than
+//     retried forever. A score is never given up on otherwise: the backoff is capped, not
+//     the number of attempts
+//   - A submission that timed out may still have reached the service, so it can be counted
+//     twice; like the crash case above, the parsers skip the exact duplicate
+//
+//================================================================================================
+
+#include "scorequeue.h"
+#include "raylib.h" // For GetRandomValue
+#include "storage.h"
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// Append a record line to the journal
+static void AppendJournal(const ScoreQueue *queue, const char *record);
+
+// Rewrite the journal with an "add" record for each queued score
+static void CompactJournal(const ScoreQueue *queue);
+
+// Remove scores[0] and record that it is done
+static void CompleteFirstScore(ScoreQueue *queue);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see scorequeue.h for documentation)
+//----------------------------------------------------------------------------------
+
+void LoadScoreQueue(ScoreQueue *queue, const char *baseUrl, const char *journalName)
+{
+    memset(queue, 0, sizeof(*queue));
+    queue->nextId = 1;
+    queue->retryDelay = SCORE_RETRY_MIN_DELAY;
+    snprintf(queue->baseUrl, sizeof(queue->baseUrl), "%s", baseUrl);
+    snprintf(queue->journalName, sizeof(queue->journalName), "%s", journalName);
+
+    char *journal = LoadStorageItem(queue->journalName);
+    if (journal == NULL) return;
+
+    char *line = journal;
+    char *end;
+    while ((end = strchr(line, '\n')) != NULL) {
+        *end = '\0';
+        QueuedScore entry = {0};
+        char name[16];
+        if (sscanf(line, "add %u %15s %d", &entry.id, name, &entry.score) == 3) {
+            snprintf(entry.name, sizeof(entry.name), "%s", name);
+            if (queue->count < SCORE_QUEUE_CAPACITY) queue->scores[queue->count++] = entry;
+        }
+        else if (sscanf(line, "done %u", &entry.id) == 1) {
+            for (int i = 0; i < queue->count; i++) {
+                if (queue->scores[i].id != entry.id) continue;
+                memmove(&queue->scores[i], &queue->scores[i + 1], (queue->count - i - 1) * sizeof(QueuedScore));
+                queue->count--;
+                break;
+            }
+        }
+        if (entry.id >= queue->nextId) queue->nextId = entry.id + 1;
+        line = end + 1;
+    }
+    free(journal);
+
+    CompactJournal(queue);
+    if (queue->count > 0) printf("%d score(s) waiting to be submitted.\n", queue->count);
+}
+
+bool EnqueueScore(ScoreQueue *queue, const char *name, int score)
+{
+    if (queue->count == SCORE_QUEUE_CAPACITY) {
+        fprintf(stderr, "Score queue full, dropping score %d for %s\n", score, name);
+        return false;
+    }
+    QueuedScore *entry = &queue->scores[queue->count++];
+    entry->id = queue->nextId++;
+    snprintf(entry->name, sizeof(entry->name), "%s", name);
+    entry->score = score;
+
+    char record[64];
+    snprintf(record, sizeof(record), "add %u %s %d\n", entry->id, entry->name, entry->score);
+    AppendJournal(queue, record);
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// UpdateScoreQueue - Implementation Notes:
+// - Only one submission is in flight, so scores reach the service in the order played
+// - A success resets the backoff, so the rest of a backlog follows on the next calls
+//----------------------------------------------------------------------------------
+int UpdateScoreQueue(ScoreQueue *queue, double now)
+{
+    int accepted = 0;
+    if (PollHttpRequest(&queue->request)) {
+        const QueuedScore *entry = &queue->scores[0];
+        HttpRequest *req = &queue->request;
+        if (req->ok && req->status >= 200 && req->status <= 299) {
+            printf("Score submitted successfully.\n");
+            CompleteFirstScore(queue);
+            queue->retryDelay = SCORE_RETRY_MIN_DELAY;
+            accepted = 1;
+        }
+        else if (req->ok && !IsHttpStatusTransient(req->status)) {
+            fprintf(stderr, "Score %d for %s rejected (HTTP %ld), dropping it\n", entry->score, entry->name,
+                    req->status);
+            CompleteFirstScore(queue);
+        }
+        else {
+            double delay = queue->retryDelay * (0.5 + GetRandomValue(0, 1000) / 1000.0);
+            if (req->retryAfter > delay) delay = fmin(req->retryAfter, SCORE_RETRY_MAX_DELAY);
+            fprintf(stderr, "Score submission failed (HTTP %ld%s), retrying in %.0f s\n", req->status,
+                    req->timedOut ? ", timed out" : "", delay);
+            queue->retryTime = now + delay;
+            queue->retryDelay *= 2.0;
+            if (queue->retryDelay > SCORE_RETRY_MAX_DELAY) queue->retryDelay = SCORE_RETRY_MAX_DELAY;
+        }
+        ReleaseHttpRequest(req);
+    }
+
+    if (queue->count > 0 && !queue->request.inFlight && now >= queue->retryTime) {
+        char url[HTTP_URL_LENGTH];
+        snprintf(url, sizeof(url), "%s?action=newScore&gameID=%d&userName=%s&score=%d", queue->baseUrl,
+                 LEADERBOARD_GAME_ID, queue->scores[0].name, queue->scores[0].score);
+        if (!StartHttpPost(&queue->request, url)) queue->retryTime = now + queue->retryDelay;
+    }
+    return accepted;
+}
+
+void RetryScoreQueueNow(ScoreQueue *queue)
+{
+    queue->retryTime = 0.0;
+    queue->retryDelay = SCORE_RETRY_MIN_DELAY;
+}
+
+void UnloadScoreQueue(ScoreQueue *queue)
+{
+    CloseHttpRequest(&queue->request);
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static void AppendJournal(const ScoreQueue *queue, const char *record)
+{
+    if (!AppendStorageItem(queue->journalName, record)) {
+        fprintf(stderr, "Could not write score journal; queued scores may be lost on exit\n");
+    }
+}
+
+static void CompactJournal(const ScoreQueue *queue)
+{
+    char journal[SCORE_QUEUE_CAPACITY * 32 + 1] = "";
+    size_t length = 0;
+    for (int i = 0; i < queue->count; i++) {
+        const QueuedScore *entry = &queue->scores[i];
+        length += (size_t)snprintf(journal + length, sizeof(journal) - length, "add %u %s %d\n", entry->id,
+                                   entry->name, entry->score);
+    }
+    SaveStorageItemDurable(queue->journalName, journal);
+}
+
+static void CompleteFirstScore(ScoreQueue *queue)
+{
+    char record[32];
+    snprintf(record, sizeof(record), "done %u\n", queue->scores[0].id);
+    memmove(&queue->scores[0], &queue->scores[1], (queue->count - 1) * sizeof(QueuedScore));
+    queue->count--;
+
+    if (queue->count == 0)
+        CompactJournal(queue); // Nothing open: start the journal afresh
+    else
+        AppendJournal(queue, record);
+}
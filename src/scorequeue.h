@@ -0,0 +1,70 @@
+//================================================================================================
+//
+//   scorequeue.h - Durable score submission queue for Tailgunner
+//
+//   Scores to submit are written to a journal before anything is sent, so a score
+//   survives a failed request, a lost connection or the game being closed. The queue is
+//   flushed in the background, oldest first, retrying with jittered exponential backoff
+//   while the leaderboard service can't be reached or asks to be tried again later; a
+//   reconnect drains the whole backlog at once.
+//
+//================================================================================================
+
+#ifndef SCOREQUEUE_H
+#define SCOREQUEUE_H
+
+#include "config.h"
+#include "http.h"
+
+// Scores kept waiting at most; further scores are dropped while the queue is full
+#define SCORE_QUEUE_CAPACITY 32
+
+typedef struct QueuedScore {
+    unsigned int id; // Journal record ID
+    char name[LEADERBOARD_NAME_LENGTH + 1];
+    int score;
+} QueuedScore;
+
+typedef struct ScoreQueue {
+    QueuedScore scores[SCORE_QUEUE_CAPACITY]; // Oldest first; scores[0] is the one being sent
+    int count;
+    unsigned int nextId;
+    char baseUrl[HTTP_URL_LENGTH]; // Leaderboard service the scores go to
+    char journalName[32];          // Storage item of the journal
+    HttpRequest request; // Submission of scores[0] while in flight
+    double retryTime;    // No submission is started before this time (GetTime seconds)
+    double retryDelay;   // Wait after the next failure, in seconds
+} ScoreQueue;
+
+//----------------------------------------------------------------------------------
+// Score Queue Functions
+//----------------------------------------------------------------------------------
+
+// Load scores left unsent by earlier runs from the journal
+//
+// @param baseUrl Leaderboard service to submit to
+// @param journalName Storage item holding the journal; use one per service
+void LoadScoreQueue(ScoreQueue *queue, const char *baseUrl, const char *journalName);
+
+// Journal a score and queue it for submission
+//
+// @return false if the queue is full (the score is not kept)
+bool EnqueueScore(ScoreQueue *queue, const char *name, int score);
+
+// Collect a finished submission and start the next one when due
+//
+// @param now Current GetTime() value
+// @return Number of scores the service accepted in this call (0 or 1)
+int UpdateScoreQueue(ScoreQueue *queue, double now);
+
+// Drop any backoff wait so the next UpdateScoreQueue submits right away
+//
+// Call when the service has been seen to respond again.
+void RetryScoreQueueNow(ScoreQueue *queue);
+
+// Stop a submission in flight at shutdown
+//
+// Its score stays in the journal and is submitted again by the next run.
+void UnloadScoreQueue(ScoreQueue *queue);
+
+#endif // SCOREQUEUE_H
@@ -6,13 +6,16 @@
 //
 //   Implementation notes:
 //   - Uses instanced rendering to draw all stars efficiently
-//   - Star positions are updated on the CPU each frame
+//   - Star positions are updated on the CPU each frame by the SIMD kernel in starfield_kernel.c
+//   - Wrapped stars take x/y from random pools filled once at init, so the per-frame
+//     update costs a single GetRandomValue call for the pool offset
 //   - Custom shader handles per-instance transformation via matModel uniform
 //
 //================================================================================================
 
 #include "starfield.h"
 #include "gl_debug.h"
+#include "starfield_kernel.h"
 #include "raymath.h"
 #include "rlgl.h"
 #include <stdlib.h>
@@ -48,13 +51,24 @@ void InitStarfield(void)
         GetShaderLocation(starfield.material.shader, "colDiffuse");
 
     starfield.transforms = (Matrix *)RL_MALLOC(MAX_STARS * sizeof(Matrix));
-    starfield.positions = (Vector3 *)RL_MALLOC(MAX_STARS * sizeof(Vector3));
+    starfield.x = (float *)RL_MALLOC(MAX_STARS * sizeof(float));
+    starfield.y = (float *)RL_MALLOC(MAX_STARS * sizeof(float));
+    starfield.z = (float *)RL_MALLOC(MAX_STARS * sizeof(float));
+    starfield.poolX = (float *)RL_MALLOC((STAR_POOL_SIZE + STAR_POOL_PAD) * sizeof(float));
+    starfield.poolY = (float *)RL_MALLOC((STAR_POOL_SIZE + STAR_POOL_PAD) * sizeof(float));
+
+    for (int i = 0; i < STAR_POOL_SIZE; i++) {
+        starfield.poolX[i] = (float)GetRandomValue(-STAR_XY_RANGE, STAR_XY_RANGE);
+        starfield.poolY[i] = (float)GetRandomValue(-STAR_XY_RANGE, STAR_XY_RANGE);
+    }
+    FillStarPool(starfield.poolX);
+    FillStarPool(starfield.poolY);
 
     for (int i = 0; i < MAX_STARS; i++) {
-        starfield.positions[i] =
-            (Vector3){GetRandomValue(-100, 100), GetRandomValue(-100, 100), GetRandomValue(-200, 0)};
-        starfield.transforms[i] =
-            MatrixTranslate(starfield.positions[i].x, starfield.positions[i].y, starfield.positions[i].z);
+        starfield.x[i] = (float)GetRandomValue(-STAR_XY_RANGE, STAR_XY_RANGE);
+        starfield.y[i] = (float)GetRandomValue(-STAR_XY_RANGE, STAR_XY_RANGE);
+        starfield.z[i] = (float)GetRandomValue((int)STAR_Z_FAR, (int)STAR_Z_NEAR);
+        starfield.transforms[i] = MatrixTranslate(starfield.x[i], starfield.y[i], starfield.z[i]);
     }
 }
 
@@ -63,23 +77,26 @@ void UnloadStarfield(void)
     UnloadMesh(starfield.mesh);
     UnloadMaterial(starfield.material);
     RL_FREE(starfield.transforms);
-    RL_FREE(starfield.positions);
+    RL_FREE(starfield.x);
+    RL_FREE(starfield.y);
+    RL_FREE(starfield.z);
+    RL_FREE(starfield.poolX);
+    RL_FREE(starfield.poolY);
 }
 
-void UpdateStarfield(void)
+void UpdateStarfield(float dt)
 {
-    const float speed = 60.0f;
-    float dt = GetFrameTime();
+    float dz = STAR_SPEED * dt;
+    int poolOffset = GetRandomValue(0, STAR_POOL_SIZE - 1);
+
+    UpdateStarPositions(starfield.x, starfield.y, starfield.z, MAX_STARS, dz, STAR_Z_FAR, STAR_Z_NEAR, starfield.poolX,
+                        starfield.poolY, poolOffset);
 
+    // Only the translation column changes; rotation/scale stay identity from InitStarfield
     for (int i = 0; i < MAX_STARS; i++) {
-        starfield.positions[i].z -= speed * dt;
-        if (starfield.positions[i].z < -200.0f) {
-            starfield.positions[i].x = GetRandomValue(-100, 100);
-            starfield.positions[i].y = GetRandomValue(-100, 100);
-            starfield.positions[i].z = 0.0f;
-        }
-        starfield.transforms[i] =
-            MatrixTranslate(starfield.positions[i].x, starfield.positions[i].y, starfield.positions[i].z);
+        starfield.transforms[i].m12 = starfield.x[i];
+        starfield.transforms[i].m13 = starfield.y[i];
+        starfield.transforms[i].m14 = starfield.z[i];
     }
 }
 
@@ -17,7 +17,8 @@ typedef struct Starfield {
     Mesh mesh;
     Material material;
     Matrix *transforms;
-    Vector3 *positions;
+    float *x, *y, *z;     // Star positions as separate arrays (SoA) for the SIMD update kernel
+    float *poolX, *poolY; // Pre-generated random x/y values handed to wrapped stars
 } Starfield;
 
 extern Starfield starfield;
@@ -33,7 +34,9 @@ void InitStarfield(void);
 void UnloadStarfield(void);
 
 // Update star positions, moving them toward camera and wrapping
-void UpdateStarfield(void);
+//
+// @param dt Tick length in seconds
+void UpdateStarfield(float dt);
 
 // Render all stars in 3D space
 void DrawStarfield(void);
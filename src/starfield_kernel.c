@@ -0,0 +1,128 @@
+//================================================================================================
+//
+//   starfield_kernel.c - Vectorised star position update implementation
+//
+//   See starfield_kernel.h for module interface documentation.
+//
+//   Implementation notes:
+//   - Instruction set is picked at compile time (-mavx2, default SSE2 on x86-64, -msimd128 on web)
+//   - Wrap test is a compare mask; new x/y/z are merged with blend/select, never a branch
+//   - Stars that do not fit a full vector are finished by the scalar path
+//
+//================================================================================================
+
+#include "starfield_kernel.h"
+
+#if defined(__AVX2__)
+#include <immintrin.h>
+#define STAR_KERNEL_AVX2
+#define STAR_KERNEL_WIDTH 8
+#elif defined(__SSE2__) || defined(_M_X64)
+#include <emmintrin.h>
+#define STAR_KERNEL_SSE2
+#define STAR_KERNEL_WIDTH 4
+#elif defined(__wasm_simd128__)
+#include <wasm_simd128.h>
+#define STAR_KERNEL_WASM
+#define STAR_KERNEL_WIDTH 4
+#else
+#define STAR_KERNEL_WIDTH 1
+#endif
+
+#define STAR_POOL_MASK (STAR_POOL_SIZE - 1)
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see starfield_kernel.h for documentation)
+//----------------------------------------------------------------------------------
+
+void UpdateStarPositionsScalar(float *x, float *y, float *z, int count, float dz, float zFar, float zNear,
+                               const float *poolX, const float *poolY, int poolOffset)
+{
+    for (int i = 0; i < count; i++) {
+        int j = (poolOffset + i) & STAR_POOL_MASK;
+        float nz = z[i] - dz;
+        int wrap = nz < zFar;
+        // Written as selects so the compiler emits conditional moves rather than a branch
+        x[i] = wrap ? poolX[j] : x[i];
+        y[i] = wrap ? poolY[j] : y[i];
+        z[i] = wrap ? zNear : nz;
+    }
+}
+
+//----------------------------------------------------------------------------------
+// UpdateStarPositions - Implementation Notes:
+// - Processes STAR_KERNEL_WIDTH stars per iteration with unaligned loads/stores
+// - Pool index wraps per vector; STAR_POOL_PAD covers loads that run past the end
+//----------------------------------------------------------------------------------
+void UpdateStarPositions(float *x, float *y, float *z, int count, float dz, float zFar, float zNear,
+                         const float *poolX, const float *poolY, int poolOffset)
+{
+    int i = 0;
+
+#if defined(STAR_KERNEL_AVX2)
+    const __m256 vdz = _mm256_set1_ps(dz);
+    const __m256 vfar = _mm256_set1_ps(zFar);
+    const __m256 vnear = _mm256_set1_ps(zNear);
+    for (; i + STAR_KERNEL_WIDTH <= count; i += STAR_KERNEL_WIDTH) {
+        int j = (poolOffset + i) & STAR_POOL_MASK;
+        __m256 vz = _mm256_sub_ps(_mm256_loadu_ps(z + i), vdz);
+        __m256 wrap = _mm256_cmp_ps(vz, vfar, _CMP_LT_OQ);
+        _mm256_storeu_ps(x + i, _mm256_blendv_ps(_mm256_loadu_ps(x + i), _mm256_loadu_ps(poolX + j), wrap));
+        _mm256_storeu_ps(y + i, _mm256_blendv_ps(_mm256_loadu_ps(y + i), _mm256_loadu_ps(poolY + j), wrap));
+        _mm256_storeu_ps(z + i, _mm256_blendv_ps(vz, vnear, wrap));
+    }
+#elif defined(STAR_KERNEL_SSE2)
+    const __m128 vdz = _mm_set1_ps(dz);
+    const __m128 vfar = _mm_set1_ps(zFar);
+    const __m128 vnear = _mm_set1_ps(zNear);
+    for (; i + STAR_KERNEL_WIDTH <= count; i += STAR_KERNEL_WIDTH) {
+        int j = (poolOffset + i) & STAR_POOL_MASK;
+        __m128 vz = _mm_sub_ps(_mm_loadu_ps(z + i), vdz);
+        __m128 wrap = _mm_cmplt_ps(vz, vfar);
+        // SSE2 has no blendv: (wrap & new) | (~wrap & old)
+        __m128 vx = _mm_or_ps(_mm_and_ps(wrap, _mm_loadu_ps(poolX + j)), _mm_andnot_ps(wrap, _mm_loadu_ps(x + i)));
+        __m128 vy = _mm_or_ps(_mm_and_ps(wrap, _mm_loadu_ps(poolY + j)), _mm_andnot_ps(wrap, _mm_loadu_ps(y + i)));
+        _mm_storeu_ps(x + i, vx);
+        _mm_storeu_ps(y + i, vy);
+        _mm_storeu_ps(z + i, _mm_or_ps(_mm_and_ps(wrap, vnear), _mm_andnot_ps(wrap, vz)));
+    }
+#elif defined(STAR_KERNEL_WASM)
+    const v128_t vdz = wasm_f32x4_splat(dz);
+    const v128_t vfar = wasm_f32x4_splat(zFar);
+    const v128_t vnear = wasm_f32x4_splat(zNear);
+    for (; i + STAR_KERNEL_WIDTH <= count; i += STAR_KERNEL_WIDTH) {
+        int j = (poolOffset + i) & STAR_POOL_MASK;
+        v128_t vz = wasm_f32x4_sub(wasm_v128_load(z + i), vdz);
+        v128_t wrap = wasm_f32x4_lt(vz, vfar);
+        // bitselect(a, b, mask) takes a where mask bits are set
+        wasm_v128_store(x + i, wasm_v128_bitselect(wasm_v128_load(poolX + j), wasm_v128_load(x + i), wrap));
+        wasm_v128_store(y + i, wasm_v128_bitselect(wasm_v128_load(poolY + j), wasm_v128_load(y + i), wrap));
+        wasm_v128_store(z + i, wasm_v128_bitselect(vnear, vz, wrap));
+    }
+#endif
+
+    // Remaining stars (or all of them when no SIMD is available)
+    if (i < count) {
+        UpdateStarPositionsScalar(x + i, y + i, z + i, count - i, dz, zFar, zNear, poolX, poolY, poolOffset + i);
+    }
+}
+
+void FillStarPool(float *pool)
+{
+    for (int i = 0; i < STAR_POOL_PAD; i++) {
+        pool[STAR_POOL_SIZE + i] = pool[i];
+    }
+}
+
+const char *GetStarKernelName(void)
+{
+#if defined(STAR_KERNEL_AVX2)
+    return "avx2";
+#elif defined(STAR_KERNEL_SSE2)
+    return "sse2";
+#elif defined(STAR_KERNEL_WASM)
+    return "wasm-simd128";
+#else
+    return "scalar";
+#endif
+}
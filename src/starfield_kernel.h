@@ -0,0 +1,50 @@
+//================================================================================================
+//
+//   starfield_kernel.h - Vectorised star position update for Tailgunner
+//
+//   Branch-free update of star positions stored as separate x/y/z float arrays.
+//   Compiled for AVX2, SSE2 or wasm-simd128 depending on target flags, with a
+//   scalar fallback. Has no raylib dependency so it can be benchmarked standalone.
+//
+//================================================================================================
+
+#ifndef STARFIELD_KERNEL_H
+#define STARFIELD_KERNEL_H
+
+// Number of entries in each random pool (must be a power of two)
+#define STAR_POOL_SIZE 4096
+// Extra entries past STAR_POOL_SIZE that mirror the start of the pool, so a vector
+// load starting anywhere in the pool never needs to wrap
+#define STAR_POOL_PAD 8
+
+//----------------------------------------------------------------------------------
+// Starfield Kernel Functions
+//----------------------------------------------------------------------------------
+
+// Move stars along z by -dz and respawn any that pass zFar at zNear
+//
+// Respawned stars take new x/y from the random pools, starting at poolOffset.
+// Pools must hold STAR_POOL_SIZE + STAR_POOL_PAD floats (see FillStarPool).
+//
+// @param x,y,z Star position arrays, count entries each
+// @param dz Distance moved this frame (speed * dt)
+// @param zFar Stars with z below this value wrap
+// @param zNear Z value given to wrapped stars
+// @param poolX,poolY Pre-generated random x/y values
+// @param poolOffset Starting index into the pools for this frame
+void UpdateStarPositions(float *x, float *y, float *z, int count, float dz, float zFar, float zNear,
+                         const float *poolX, const float *poolY, int poolOffset);
+
+// Reference scalar version of UpdateStarPositions (same results, no SIMD)
+void UpdateStarPositionsScalar(float *x, float *y, float *z, int count, float dz, float zFar, float zNear,
+                               const float *poolX, const float *poolY, int poolOffset);
+
+// Copy the first STAR_POOL_PAD pool entries into the padding area past STAR_POOL_SIZE
+//
+// Call after writing the STAR_POOL_SIZE random values into a pool.
+void FillStarPool(float *pool);
+
+// Name of the instruction set the kernel was compiled for ("avx2", "sse2", "wasm-simd128" or "scalar")
+const char *GetStarKernelName(void);
+
+#endif // STARFIELD_KERNEL_H
@@ -0,0 +1,191 @@
+//================================================================================================
+//
+//   storage.c - Persistent text item implementation
+//
+//   See storage.h for module interface documentation.
+//
+//   Implementation notes:
+//   - Desktop replaces an item by writing "<path>.tmp" and renaming it over the old file.
+//     A durable save also syncs the temp file before the rename and the directory after it,
+//     so the rename survives a power loss and never exposes a file whose data blocks were
+//     not yet written. Plain saves skip both syncs: they run on the render thread for the
+//     leaderboard cache and the player name, which can be rebuilt or re-entered
+//   - Web localStorage writes are atomic per item, so replacing is a plain setItem and
+//     appending is a read-modify-write of the whole item
+//
+//================================================================================================
+
+#include "storage.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(PLATFORM_WEB)
+#include <emscripten/emscripten.h>
+#else
+#include <fcntl.h>  // For open
+#include <unistd.h> // For fsync
+#endif
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+#if !defined(PLATFORM_WEB)
+// GetStoragePath - Path of an item's file in the home directory (or the working directory without HOME)
+// @return pointer to static buffer containing path (do not free)
+static const char *GetStoragePath(const char *name);
+
+// Write text to "<path>.tmp" and rename it over the item, syncing both when durable
+static bool ReplaceStorageItem(const char *name, const char *text, bool durable);
+
+// Flush the directory holding the items, so renames in it are on disk
+//
+// @return false if it could not be opened or synced
+static bool SyncStorageDirectory(void);
+#endif
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see storage.h for documentation)
+//----------------------------------------------------------------------------------
+
+#if defined(PLATFORM_WEB)
+// clang-format off
+EM_JS(char*, emscripten_local_storage_get_item_js, (const char* key_ptr), {
+  var key = UTF8ToString(key_ptr);
+  var value = localStorage.getItem(key);
+  if (value === null) {
+    return 0; // Return null pointer if item not found
+  }
+  var length = lengthBytesUTF8(value) + 1;
+  var value_ptr = _malloc(length);
+  stringToUTF8(value, value_ptr, length);
+  return value_ptr;
+});
+
+EM_JS(int, emscripten_local_storage_set_item_js, (const char* key_ptr, const char* value_ptr), {
+  var key = UTF8ToString(key_ptr);
+  var value = UTF8ToString(value_ptr);
+  try {
+    localStorage.setItem(key, value);
+    return 0; // Success
+  } catch (e) {
+    return 1; // Failure
+  }
+});
+// clang-format on
+
+char *LoadStorageItem(const char *name)
+{
+    char key[64];
+    snprintf(key, sizeof(key), "tailgunner_%s", name);
+    return emscripten_local_storage_get_item_js(key);
+}
+
+bool SaveStorageItem(const char *name, const char *text)
+{
+    char key[64];
+    snprintf(key, sizeof(key), "tailgunner_%s", name);
+    return emscripten_local_storage_set_item_js(key, text) == 0;
+}
+
+bool SaveStorageItemDurable(const char *name, const char *text)
+{
+    return SaveStorageItem(name, text);
+}
+
+bool AppendStorageItem(const char *name, const char *text)
+{
+    char *old = LoadStorageItem(name);
+    size_t oldLength = (old != NULL) ? strlen(old) : 0;
+    char *joined = malloc(oldLength + strlen(text) + 1);
+    if (joined == NULL) {
+        free(old);
+        return false;
+    }
+    memcpy(joined, old != NULL ? old : "", oldLength);
+    strcpy(joined + oldLength, text);
+    bool saved = SaveStorageItem(name, joined);
+    free(joined);
+    free(old);
+    return saved;
+}
+#else
+char *LoadStorageItem(const char *name)
+{
+    FILE *f = fopen(GetStoragePath(name), "rb");
+    if (f == NULL) return NULL;
+
+    char *text = NULL;
+    long length = (fseek(f, 0, SEEK_END) == 0) ? ftell(f) : -1;
+    if (length >= 0 && fseek(f, 0, SEEK_SET) == 0 && (text = malloc((size_t)length + 1)) != NULL) {
+        text[fread(text, 1, (size_t)length, f)] = '\0';
+    }
+    fclose(f);
+    return text;
+}
+
+bool SaveStorageItem(const char *name, const char *text)
+{
+    return ReplaceStorageItem(name, text, false);
+}
+
+bool SaveStorageItemDurable(const char *name, const char *text)
+{
+    return ReplaceStorageItem(name, text, true);
+}
+
+bool AppendStorageItem(const char *name, const char *text)
+{
+    FILE *f = fopen(GetStoragePath(name), "ab");
+    if (f == NULL) return false;
+
+    size_t length = strlen(text);
+    bool written = fwrite(text, 1, length, f) == length && fflush(f) == 0 && fsync(fileno(f)) == 0;
+    if (fclose(f) != 0) written = false;
+    return written;
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static const char *GetStoragePath(const char *name)
+{
+    const char *homeDir = getenv("HOME");
+    static char path[256];
+    if (homeDir == NULL)
+        snprintf(path, sizeof(path), ".tailgunner.%s", name);
+    else
+        snprintf(path, sizeof(path), "%s/.tailgunner.%s", homeDir, name);
+    return path;
+}
+
+static bool ReplaceStorageItem(const char *name, const char *text, bool durable)
+{
+    char tempPath[272];
+    snprintf(tempPath, sizeof(tempPath), "%s.tmp", GetStoragePath(name));
+    FILE *f = fopen(tempPath, "wb");
+    if (f == NULL) return false;
+
+    size_t length = strlen(text);
+    bool written = fwrite(text, 1, length, f) == length;
+    if (written && durable) written = fflush(f) == 0 && fsync(fileno(f)) == 0;
+    if (fclose(f) != 0) written = false;
+    if (!written || rename(tempPath, GetStoragePath(name)) != 0) {
+        remove(tempPath);
+        return false;
+    }
+    return !durable || SyncStorageDirectory();
+}
+
+static bool SyncStorageDirectory(void)
+{
+    const char *homeDir = getenv("HOME");
+    int dir = open((homeDir != NULL) ? homeDir : ".", O_RDONLY);
+    if (dir < 0) return false;
+    bool synced = fsync(dir) == 0;
+    close(dir);
+    return synced;
+}
+#endif
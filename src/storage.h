@@ -0,0 +1,46 @@
+//================================================================================================
+//
+//   storage.h - Small persistent text items for Tailgunner
+//
+//   Named text items that survive restarts: a dot file in the home directory on desktop
+//   ("~/.tailgunner.<name>") and a localStorage entry on web ("tailgunner_<name>").
+//   Used for the player name, the cached leaderboard lists and the score journal.
+//
+//================================================================================================
+
+#ifndef STORAGE_H
+#define STORAGE_H
+
+#include <stdbool.h>
+
+//----------------------------------------------------------------------------------
+// Storage Functions
+//----------------------------------------------------------------------------------
+
+// Read a whole item
+//
+// @return NUL-terminated copy the caller frees, or NULL if the item does not exist
+char *LoadStorageItem(const char *name);
+
+// Replace an item
+//
+// A crash during the write leaves either the old or the new contents, never a mix. The
+// write is not synced, so after a power loss the item may come back with either (or, on
+// some filesystems, empty); use SaveStorageItemDurable for data that must survive one.
+bool SaveStorageItem(const char *name, const char *text);
+
+// Replace an item and wait until the new contents are on disk
+//
+// Like SaveStorageItem, but a power loss also leaves the old or the new contents. This
+// blocks on disk syncs, so keep it to small items that must not be lost (the score
+// journal). False after the rename (the directory could not be synced) means the new
+// contents are in place but may not survive a power loss. Same as SaveStorageItem on web.
+bool SaveStorageItemDurable(const char *name, const char *text);
+
+// Append text to an item, creating it if needed
+//
+// On desktop the data is flushed to disk before returning; a crash can at most leave the
+// last append cut short, so readers should ignore an unterminated final line.
+bool AppendStorageItem(const char *name, const char *text);
+
+#endif // STORAGE_H
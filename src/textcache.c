@@ -0,0 +1,208 @@
+//================================================================================================
+//
+//   textcache.c - Cached text layout implementation
+//
+//   See textcache.h for module interface documentation.
+//
+//   Implementation notes:
+//   - Runs are keyed by (text, fontSize) and stored relative to the draw position, so a
+//     string that moves (e.g. on window resize) is translated instead of laid out again
+//   - Layout follows raylib's DrawText -> DrawTextEx -> DrawTextCodepoint exactly
+//   - Replay submits all quads of a run in one rlBegin/rlEnd block
+//   - Strings with newlines or more than TEXT_CACHE_MAX_GLYPHS glyphs use DrawText directly
+//
+//================================================================================================
+
+#include "textcache.h"
+#include "rlgl.h"
+#include <stdio.h>
+#include <string.h>
+
+// Glyph quad in pixels relative to the run origin, with normalized texture coordinates
+typedef struct TextQuad {
+    float x0, y0, x1, y1;
+    float u0, v0, u1, v1;
+} TextQuad;
+
+// Laid-out run for one (text, fontSize) pair
+typedef struct TextRun {
+    bool used;
+    unsigned int hash;
+    int fontSize;
+    int width;            // MeasureText result for this run
+    int quadCount;        // Visible glyphs (spaces produce no quad)
+    unsigned int lastUse; // Use stamp for least-recently-used eviction
+    char text[TEXT_CACHE_MAX_GLYPHS + 1];
+    TextQuad quads[TEXT_CACHE_MAX_GLYPHS];
+} TextRun;
+
+//----------------------------------------------------------------------------------
+// Module Variables
+//----------------------------------------------------------------------------------
+static TextRun textRuns[TEXT_CACHE_ENTRIES];
+static unsigned int textUseCounter = 0;
+
+//----------------------------------------------------------------------------------
+// Internal Function Declarations
+//----------------------------------------------------------------------------------
+
+// FNV-1a hash of text and font size
+static unsigned int HashText(const char *text, int fontSize);
+
+// Find the cached run for (text, fontSize), laying it out into a free or evicted slot on miss
+//
+// @return Cached run, or NULL if the text cannot be cached (caller falls back to raylib)
+static TextRun *GetTextRun(const char *text, int fontSize);
+
+// Lay out text into run using the default font
+//
+// @return false if the text cannot be cached
+static bool LayoutTextRun(TextRun *run, const char *text, int fontSize);
+
+//----------------------------------------------------------------------------------
+// Public Function Implementations (see textcache.h for documentation)
+//----------------------------------------------------------------------------------
+
+void DrawTextCached(const char *text, int posX, int posY, int fontSize, Color color)
+{
+    const TextRun *run = GetTextRun(text, fontSize);
+    if (run == NULL) {
+        DrawText(text, posX, posY, fontSize, color);
+        return;
+    }
+    if (run->quadCount == 0) return;
+
+    float x = (float)posX;
+    float y = (float)posY;
+
+    rlCheckRenderBatchLimit(4 * run->quadCount);
+    rlSetTexture(GetFontDefault().texture.id);
+    rlBegin(RL_QUADS);
+    rlColor4ub(color.r, color.g, color.b, color.a);
+    rlNormal3f(0.0f, 0.0f, 1.0f);
+    for (int i = 0; i < run->quadCount; i++) {
+        const TextQuad *q = &run->quads[i];
+        // Same vertex order as DrawTexturePro: top-left, bottom-left, bottom-right, top-right
+        rlTexCoord2f(q->u0, q->v0);
+        rlVertex2f(x + q->x0, y + q->y0);
+        rlTexCoord2f(q->u0, q->v1);
+        rlVertex2f(x + q->x0, y + q->y1);
+        rlTexCoord2f(q->u1, q->v1);
+        rlVertex2f(x + q->x1, y + q->y1);
+        rlTexCoord2f(q->u1, q->v0);
+        rlVertex2f(x + q->x1, y + q->y0);
+    }
+    rlEnd();
+    rlSetTexture(0);
+}
+
+int MeasureTextCached(const char *text, int fontSize)
+{
+    const TextRun *run = GetTextRun(text, fontSize);
+    if (run == NULL) return MeasureText(text, fontSize);
+    return run->width;
+}
+
+const char *FormatCounter(TextCounter *counter, const char *fmt, int value)
+{
+    if (!counter->valid || counter->value != value) {
+        snprintf(counter->text, sizeof(counter->text), fmt, value);
+        counter->value = value;
+        counter->valid = true;
+    }
+    return counter->text;
+}
+
+//----------------------------------------------------------------------------------
+// Internal Function Implementations
+//----------------------------------------------------------------------------------
+
+static unsigned int HashText(const char *text, int fontSize)
+{
+    unsigned int hash = 2166136261u;
+    for (const unsigned char *p = (const unsigned char *)text; *p; p++) {
+        hash = (hash ^ *p) * 16777619u;
+    }
+    return (hash ^ (unsigned int)fontSize) * 16777619u;
+}
+
+static TextRun *GetTextRun(const char *text, int fontSize)
+{
+    unsigned int hash = HashText(text, fontSize);
+    TextRun *victim = &textRuns[0];
+
+    for (int i = 0; i < TEXT_CACHE_ENTRIES; i++) {
+        TextRun *run = &textRuns[i];
+        if (!run->used) {
+            if (victim->used) victim = run;
+            continue;
+        }
+        if (run->hash == hash && run->fontSize == fontSize && strcmp(run->text, text) == 0) {
+            run->lastUse = ++textUseCounter;
+            return run;
+        }
+        if (victim->used && run->lastUse < victim->lastUse) victim = run;
+    }
+
+    // Miss: lay out into an unused slot, or the least recently used one
+    if (!LayoutTextRun(victim, text, fontSize)) return NULL;
+    victim->used = true;
+    victim->hash = hash;
+    victim->lastUse = ++textUseCounter;
+    return victim;
+}
+
+//----------------------------------------------------------------------------------
+// LayoutTextRun - Implementation Notes:
+// - Mirrors DrawText: minimum size 10, spacing = fontSize / 10
+// - Glyph placement and padding mirror DrawTextCodepoint/DrawTexturePro
+//----------------------------------------------------------------------------------
+static bool LayoutTextRun(TextRun *run, const char *text, int fontSize)
+{
+    Font font = GetFontDefault();
+    if (font.texture.id == 0) return false;
+    if (strlen(text) > TEXT_CACHE_MAX_GLYPHS) return false;
+    if (strchr(text, '\n') != NULL) return false;
+
+    const int defaultFontSize = 10;
+    int size = (fontSize < defaultFontSize) ? defaultFontSize : fontSize;
+    float spacing = (float)(size / defaultFontSize);
+    float scale = (float)size / (float)font.baseSize;
+    float pad = (float)font.glyphPadding;
+    float texWidth = (float)font.texture.width;
+    float texHeight = (float)font.texture.height;
+
+    float offsetX = 0.0f;
+    int quadCount = 0;
+    for (int i = 0; text[i] != '\0';) {
+        int codepointSize = 0;
+        int codepoint = GetCodepointNext(&text[i], &codepointSize);
+        int index = GetGlyphIndex(font, codepoint);
+        Rectangle rec = font.recs[index];
+
+        if (codepoint != ' ' && codepoint != '\t') {
+            TextQuad *q = &run->quads[quadCount++];
+            q->x0 = offsetX + (float)font.glyphs[index].offsetX * scale - pad * scale;
+            q->y0 = (float)font.glyphs[index].offsetY * scale - pad * scale;
+            q->x1 = q->x0 + (rec.width + 2.0f * pad) * scale;
+            q->y1 = q->y0 + (rec.height + 2.0f * pad) * scale;
+            q->u0 = (rec.x - pad) / texWidth;
+            q->v0 = (rec.y - pad) / texHeight;
+            q->u1 = (rec.x + rec.width + pad) / texWidth;
+            q->v1 = (rec.y + rec.height + pad) / texHeight;
+        }
+
+        if (font.glyphs[index].advanceX == 0)
+            offsetX += rec.width * scale + spacing;
+        else
+            offsetX += (float)font.glyphs[index].advanceX * scale + spacing;
+
+        i += codepointSize;
+    }
+
+    strcpy(run->text, text);
+    run->fontSize = fontSize;
+    run->quadCount = quadCount;
+    run->width = MeasureText(text, fontSize);
+    return true;
+}
@@ -0,0 +1,44 @@
+//================================================================================================
+//
+//   textcache.h - Cached text layout for Tailgunner
+//
+//   Stores the laid-out glyph quads of recently drawn strings so menu and HUD text
+//   can be replayed each frame without re-walking glyph metrics. Draws with the
+//   raylib default font and matches DrawText/MeasureText output.
+//
+//================================================================================================
+
+#ifndef TEXTCACHE_H
+#define TEXTCACHE_H
+
+#include "raylib.h"
+
+// Longest string (in glyphs) that can be cached; longer strings fall back to DrawText
+#define TEXT_CACHE_MAX_GLYPHS 96
+// Number of distinct (string, size) runs kept before the least recently used is evicted
+#define TEXT_CACHE_ENTRIES 64
+
+// Formatted integer counter that is only re-formatted when its value changes
+typedef struct TextCounter {
+    int value;     // Value the text was last formatted for
+    bool valid;    // False until first formatted
+    char text[64]; // Formatted text
+} TextCounter;
+
+//----------------------------------------------------------------------------------
+// Text Cache Module Functions
+//----------------------------------------------------------------------------------
+
+// Draw text like DrawText, laying it out only the first time a (text, fontSize) pair is seen
+void DrawTextCached(const char *text, int posX, int posY, int fontSize, Color color);
+
+// Measure text like MeasureText, using the cached layout when available
+int MeasureTextCached(const char *text, int fontSize);
+
+// Return counter text for value, formatting it with fmt only when value changed
+//
+// @param fmt printf-style format taking a single int
+// @return Pointer to the counter's text (valid until the next call for this counter)
+const char *FormatCounter(TextCounter *counter, const char *fmt, int value);
+
+#endif // TEXTCACHE_H
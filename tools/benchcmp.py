@@ -0,0 +1,139 @@
+#!/usr/bin/env python3
+"""Compare two benchmark runs (bench_harness JSON) and fail on significant slowdowns.
+
+For every benchmark present in both files, the per-repetition times are compared with a
+two-sided Mann-Whitney U test. A benchmark counts as a regression when the difference is
+significant (p < --alpha) AND the median got slower by more than --threshold percent, so
+neither run-to-run noise nor tiny-but-consistent shifts fail the gate on their own.
+
+Only benchmarks in the gated groups (simulation, render submission, leaderboard parsing)
+affect the exit code; anything else is reported for information.
+
+Usage: tools/benchcmp.py baseline.json new.json [--alpha=0.01] [--threshold=5]
+Exit status: 0 no regression, 1 regression in a gated benchmark, 2 usage or input error.
+"""
+import argparse
+import json
+import math
+import sys
+
+# Benchmark name prefix -> group. Benchmarks matching none of these are not gated.
+GATED_GROUPS = [
+    ("bezier_", "simulation"),
+    ("update_enemies", "simulation"),
+    ("fire_lasers", "simulation"),
+    ("force_field", "simulation"),
+    ("update_starfield", "render"),  # builds the instance transforms handed to DrawMeshInstanced
+    ("parse_", "parsing"),
+]
+
+
+def group_of(name):
+    for prefix, group in GATED_GROUPS:
+        if name.startswith(prefix):
+            return group
+    return None
+
+
+def mann_whitney_p(a, b):
+    """Two-sided p-value of the Mann-Whitney U test (normal approximation, tie-corrected).
+
+    Good enough from about 8 samples per side; bench_harness takes 21 by default.
+    """
+    n1, n2 = len(a), len(b)
+    values = sorted([(v, 0) for v in a] + [(v, 1) for v in b])
+    n = n1 + n2
+
+    # Average ranks over ties, and collect tie sizes for the variance correction
+    rank_sum_a = 0.0
+    tie_term = 0.0
+    i = 0
+    while i < n:
+        j = i
+        while j + 1 < n and values[j + 1][0] == values[i][0]:
+            j += 1
+        rank = (i + j) / 2.0 + 1.0
+        rank_sum_a += rank * sum(1 for k in range(i, j + 1) if values[k][1] == 0)
+        t = j - i + 1
+        tie_term += t * t * t - t
+        i = j + 1
+
+    u = rank_sum_a - n1 * (n1 + 1) / 2.0
+    mean = n1 * n2 / 2.0
+    variance = n1 * n2 / 12.0 * ((n + 1) - tie_term / (n * (n - 1)))
+    if variance <= 0:
+        return 1.0
+    z = (abs(u - mean) - 0.5) / math.sqrt(variance)  # continuity correction
+    if z <= 0:
+        return 1.0
+    return math.erfc(z / math.sqrt(2.0))
+
+
+def median(values):
+    s = sorted(values)
+    mid = len(s) // 2
+    return s[mid] if len(s) % 2 else 0.5 * (s[mid - 1] + s[mid])
+
+
+def load(path):
+    try:
+        with open(path) as f:
+            data = json.load(f)
+        return data, {r["name"]: r for r in data["results"]}
+    except (OSError, ValueError, KeyError) as e:
+        print(f"benchcmp: cannot read {path}: {e}", file=sys.stderr)
+        sys.exit(2)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__.splitlines()[0])
+    parser.add_argument("baseline")
+    parser.add_argument("new")
+    parser.add_argument("--alpha", type=float, default=0.01, help="significance level (default 0.01)")
+    parser.add_argument("--threshold", type=float, default=5.0,
+                        help="minimum median slowdown in percent to count as a regression (default 5)")
+    args = parser.parse_args()
+
+    base_info, base = load(args.baseline)
+    new_info, new = load(args.new)
+    for key in ("suite", "compiler", "cpu_model"):
+        if base_info.get(key) != new_info.get(key):
+            print(f"warning: {key} differs: {base_info.get(key)!r} vs {new_info.get(key)!r}", file=sys.stderr)
+
+    print(f"{'benchmark':28} {'group':10} {'base ns/op':>12} {'new ns/op':>12} {'delta':>8} {'p':>8}  verdict")
+    regressions = []
+    for name, b in base.items():
+        if name not in new:
+            print(f"{name:28} {'':10} {'missing from new run':>42}")
+            continue
+        group = group_of(name)
+        old_samples, new_samples = b["samples_ns"], new[name]["samples_ns"]
+        old_median, new_median = median(old_samples), median(new_samples)
+        delta = 100.0 * (new_median - old_median) / old_median
+        p = mann_whitney_p(old_samples, new_samples)
+
+        if p >= args.alpha:
+            verdict = "same"
+        elif delta > args.threshold:
+            verdict = "SLOWER" if group else "slower (not gated)"
+        elif delta < -args.threshold:
+            verdict = "faster"
+        else:
+            verdict = "same (within threshold)"
+        if verdict == "SLOWER":
+            regressions.append(name)
+        print(f"{name:28} {group or '-':10} {old_median:12.2f} {new_median:12.2f} {delta:+7.1f}% {p:8.4f}  {verdict}")
+
+    for name in new:
+        if name not in base:
+            print(f"{name:28} {'':10} {'new benchmark, no baseline':>42}")
+
+    if regressions:
+        print(f"\n{len(regressions)} significant regression(s): {', '.join(regressions)}")
+        return 1
+    print("\nNo significant regressions")
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,30 @@
+#!/usr/bin/env bash
+# Measure click-to-present latency for every pacing mode, with and without VSync.
+#
+# Runs the native build's --latency-test mode on a virtual X server (xvfb-run), so it
+# works headless (CI, ssh). Xvfb has no display to sync to, so "+vsync" rows there only
+# show the cost of the swap path; run with HEADLESS=0 on a real display for VSync numbers.
+#
+# Usage: tools/latency_matrix.sh [shots]     (from the repo root, after `make`)
+set -euo pipefail
+
+SHOTS=${1:-300}
+BIN=${BIN:-./tailgunner}
+HEADLESS=${HEADLESS:-1}
+RESULTS=$(mktemp)
+trap 'rm -f "$RESULTS"' EXIT
+
+for mode in capped lowlatency uncapped; do
+    for vsync in "" "--vsync"; do
+        echo "=== --pacing=$mode $vsync"
+        if [ "$HEADLESS" = 1 ]; then
+            xvfb-run -a -s "-screen 0 1600x900x24" "$BIN" --pacing=$mode $vsync --latency-test=$SHOTS
+        else
+            "$BIN" --pacing=$mode $vsync --latency-test=$SHOTS
+        fi | grep -v '^INFO:' | tee -a "$RESULTS"
+    done
+done
+
+echo
+echo "Summary (ms):"
+grep '^LATENCY' "$RESULTS" | column -t
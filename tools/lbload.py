@@ -0,0 +1,179 @@
+#!/usr/bin/env python3
+"""Load driver for the leaderboard service: many simulated game clients at once.
+
+Each client is a thread that issues the game's requests back to back for --duration
+seconds, picking the action by the --mix weights: topScores and userScores GETs (with
+If-None-Match from its previous answer, as the game revalidates, unless --no-conditional)
+and newScore POSTs. Like the game, a client opens a new connection per request unless
+--keep-alive is given.
+
+Reports client-side latency percentiles per action and the achieved request rate. With
+several --clients values the stages run one after another, so the rate at which the
+server stops scaling shows up as the point where throughput flattens and latency climbs.
+
+Meant for tools/lbserver.py; do not point it at the real service.
+
+Usage: tools/lbload.py [--url=http://127.0.0.1:8765/] [--clients=1,10,50] [--duration=10]
+                       [--mix=top:6,user:3,new:1] [--keep-alive] [--no-conditional]
+Exit status: 0 on completion, 1 if every request failed, 2 usage error.
+"""
+import argparse
+import http.client
+import random
+import sys
+import threading
+import time
+from urllib.parse import urlsplit
+
+GAME_ID = 19
+NAME_LETTERS = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+ACTIONS = ("top", "user", "new")
+
+
+class Results:
+    """Latencies and outcomes of one stage, shared by its client threads."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.latencies = {action: [] for action in ACTIONS}
+        self.outcomes = {action: {} for action in ACTIONS}
+
+    def add(self, action, seconds, outcome):
+        with self.lock:
+            self.latencies[action].append(seconds)
+            outcomes = self.outcomes[action]
+            outcomes[outcome] = outcomes.get(outcome, 0) + 1
+
+
+def percentile(sorted_values, p):
+    if not sorted_values:
+        return float("nan")
+    index = min(len(sorted_values) - 1, int(round(p / 100.0 * (len(sorted_values) - 1))))
+    return sorted_values[index]
+
+
+def run_client(options, deadline, results, rng):
+    url = urlsplit(options.url)
+    path = url.path or "/"
+    name = "".join(rng.choice(NAME_LETTERS) for _ in range(3))
+    etags = {}  # action -> ETag of the last 200
+    weights = [options.mix[action] for action in ACTIONS]
+    connection = None
+
+    while time.monotonic() < deadline:
+        action = rng.choices(ACTIONS, weights)[0]
+        if action == "top":
+            target = "%s?action=topScores&gameID=%d" % (path, GAME_ID)
+        elif action == "user":
+            target = "%s?action=userScores&gameID=%d&userName=%s" % (path, GAME_ID, name)
+        else:
+            target = "%s?action=newScore&gameID=%d&userName=%s&score=%d" % (path, GAME_ID, name,
+                                                                           rng.randint(1, 500))
+        headers = {}
+        if options.conditional and action in etags:
+            headers["If-None-Match"] = etags[action]
+
+        start = time.perf_counter()
+        try:
+            if connection is None:
+                connection = http.client.HTTPConnection(url.hostname, url.port or 80, timeout=options.timeout)
+            connection.request("POST" if action == "new" else "GET", target, headers=headers)
+            response = connection.getresponse()
+            response.read()
+            outcome = str(response.status)
+            if response.status == 200 and response.getheader("ETag"):
+                etags[action] = response.getheader("ETag")
+            if not options.keep_alive or response.will_close:
+                connection.close()
+                connection = None
+        except (OSError, http.client.HTTPException) as error:
+            outcome = type(error).__name__
+            if connection is not None:
+                connection.close()
+                connection = None
+        results.add(action, time.perf_counter() - start, outcome)
+
+    if connection is not None:
+        connection.close()
+
+
+def run_stage(options, clients):
+    results = Results()
+    deadline = time.monotonic() + options.duration
+    threads = [
+        threading.Thread(target=run_client, args=(options, deadline, results, random.Random(options.seed + i)))
+        for i in range(clients)
+    ]
+    start = time.perf_counter()
+    for thread in threads:
+        thread.start()
+    for thread in threads:
+        thread.join()
+    elapsed = time.perf_counter() - start
+
+    total = sum(len(values) for values in results.latencies.values())
+    succeeded = 0
+    print("\n%d client(s), %.1f s: %d requests, %.1f req/s" % (clients, elapsed, total, total / elapsed))
+    print("%-6s %8s %9s %9s %9s %9s  %s" % ("action", "count", "p50 ms", "p90 ms", "p99 ms", "max ms", "outcomes"))
+    for action in ACTIONS:
+        values = sorted(results.latencies[action])
+        if not values:
+            continue
+        outcomes = results.outcomes[action]
+        succeeded += sum(count for outcome, count in outcomes.items() if outcome in ("200", "304"))
+        print("%-6s %8d %9.2f %9.2f %9.2f %9.2f  %s" % (
+            action, len(values), 1000 * percentile(values, 50), 1000 * percentile(values, 90),
+            1000 * percentile(values, 99), 1000 * values[-1],
+            ", ".join("%s %d" % item for item in sorted(outcomes.items()))))
+    return total, succeeded
+
+
+def parse_mix(text):
+    mix = {action: 0.0 for action in ACTIONS}
+    for part in text.split(","):
+        action, _, weight = part.partition(":")
+        if action not in mix:
+            raise argparse.ArgumentTypeError("unknown action %r (use %s)" % (action, ", ".join(ACTIONS)))
+        mix[action] = float(weight or 1)
+    if sum(mix.values()) <= 0:
+        raise argparse.ArgumentTypeError("all weights are zero")
+    return mix
+
+
+def parse_clients(text):
+    try:
+        counts = [int(part) for part in text.split(",")]
+    except ValueError:
+        raise argparse.ArgumentTypeError("expected comma-separated client counts")
+    if any(count < 1 for count in counts):
+        raise argparse.ArgumentTypeError("client counts must be positive")
+    return counts
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Leaderboard service load driver")
+    parser.add_argument("--url", default="http://127.0.0.1:8765/")
+    parser.add_argument("--clients", type=parse_clients, default=[1, 10, 50],
+                        help="concurrent clients per stage, e.g. 1,10,50,200")
+    parser.add_argument("--duration", type=float, default=10.0, help="seconds per stage")
+    parser.add_argument("--mix", type=parse_mix, default=parse_mix("top:6,user:3,new:1"),
+                        help="action weights, e.g. top:6,user:3,new:1")
+    parser.add_argument("--timeout", type=float, default=10.0, help="per-request timeout, s")
+    parser.add_argument("--keep-alive", action="store_true", help="reuse each client's connection")
+    parser.add_argument("--no-conditional", dest="conditional", action="store_false",
+                        help="don't send If-None-Match")
+    parser.add_argument("--seed", type=int, default=1)
+    options = parser.parse_args()
+    if urlsplit(options.url).scheme != "http":
+        parser.error("only http:// URLs are supported")
+
+    total = succeeded = 0
+    for clients in options.clients:
+        stage_total, stage_succeeded = run_stage(options, clients)
+        total += stage_total
+        succeeded += stage_succeeded
+    return 1 if total > 0 and succeeded == 0 else 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,227 @@
+#!/usr/bin/env python3
+"""Local stand-in for the leaderboard service, for testing the game and load tests offline.
+
+Implements the three actions the game uses, on the query string of any path:
+
+  ?action=topScores&gameID=G[&count=N][&offset=K] -> [{"userName", "score", "gameID", "date"}, ...]
+  ?action=userScores&gameID=G&userName=U[&count=N] -> [{"U": score}, ...]
+  ?action=newScore&gameID=G&userName=U&score=S     -> {"message": "score added"}  (GET or POST)
+
+offset skips the first K scores, for the game's paging through large boards (--scores=50000
+makes one); with --no-offset it is ignored, as by a service that can't page.
+
+Scores live in memory, kept sorted on insert, and are lost when the server stops. Responses
+carry an ETag and honour If-None-Match, so the game's conditional revalidation gets 304s.
+Every request can be delayed (--latency, --jitter), answered with a 503 (--fail-rate) or
+have its connection dropped without an answer (--drop-rate).
+
+Point the desktop game at it with TAILGUNNER_LEADERBOARD_URL=http://127.0.0.1:8765/ and
+drive it with tools/lbload.py.
+
+Usage: tools/lbserver.py [--port=8765] [--latency=MS] [--jitter=MS] [--fail-rate=F]
+                         [--drop-rate=F] [--scores=N] [--seed=N] [--no-offset]
+"""
+import argparse
+import bisect
+import datetime
+import hashlib
+import json
+import random
+import sys
+import threading
+import time
+from http.server import BaseHTTPRequestHandler, ThreadingHTTPServer
+from urllib.parse import parse_qs, urlsplit
+
+DEFAULT_COUNT = 10
+NAME_LETTERS = "ABCDEFGHIJKLMNOPQRSTUVWXYZ"
+
+
+class ScoreStore:
+    """Scores per game, sorted best first, with a per-player index."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.games = {}  # gameID -> sorted list of (-score, seq, name, date)
+        self.players = {}  # (gameID, name) -> sorted list of -score
+        self.seq = 0
+
+    def add(self, game, name, score, date=None):
+        date = date or datetime.date.today().isoformat()
+        with self.lock:
+            self.seq += 1
+            bisect.insort(self.games.setdefault(game, []), (-score, self.seq, name, date))
+            bisect.insort(self.players.setdefault((game, name), []), -score)
+
+    def top(self, game, count, offset=0):
+        with self.lock:
+            entries = self.games.get(game, [])[offset:offset + count]
+        return [{"userName": name, "score": -neg, "gameID": game, "date": date} for neg, _, name, date in entries]
+
+    def user(self, game, name, count):
+        with self.lock:
+            scores = self.players.get((game, name), [])[:count]
+        return [{name: -neg} for neg in scores]
+
+    def size(self):
+        with self.lock:
+            return sum(len(entries) for entries in self.games.values())
+
+
+class Stats:
+    """Request counts for the periodic throughput report."""
+
+    def __init__(self):
+        self.lock = threading.Lock()
+        self.counts = {}
+
+    def count(self, outcome):
+        with self.lock:
+            self.counts[outcome] = self.counts.get(outcome, 0) + 1
+
+    def take(self):
+        with self.lock:
+            counts, self.counts = self.counts, {}
+        return counts
+
+
+class Server(ThreadingHTTPServer):
+    daemon_threads = True
+    request_queue_size = 128  # The default listen backlog of 5 stalls bursts of new connections
+
+
+class Handler(BaseHTTPRequestHandler):
+    protocol_version = "HTTP/1.1"  # Keep-alive for clients that reuse connections
+    server_version = "lbserver"
+
+    def do_GET(self):
+        self.handle_action()
+
+    def do_POST(self):
+        length = int(self.headers.get("Content-Length") or 0)
+        if length:
+            self.rfile.read(length)  # Parameters are in the URL; discard any body
+        self.handle_action()
+
+    def handle_action(self):
+        options = self.server.options
+        delay = options.latency + random.uniform(-options.jitter, options.jitter)
+        if delay > 0:
+            time.sleep(delay / 1000.0)
+
+        roll = random.random()
+        if roll < options.drop_rate:
+            self.server.stats.count("dropped")
+            self.close_connection = True
+            return  # No response at all: the client sees a transport failure
+        if roll < options.drop_rate + options.fail_rate:
+            self.server.stats.count("503")
+            self.send_json(503, {"error": "injected failure"})
+            return
+
+        query = {key: values[0] for key, values in parse_qs(urlsplit(self.path).query).items()}
+        action = query.get("action", "")
+        try:
+            game = int(query.get("gameID", ""))
+            count = max(0, int(query.get("count", DEFAULT_COUNT)))
+            offset = 0 if options.no_offset else max(0, int(query.get("offset", 0)))
+            if action == "topScores":
+                body = self.server.store.top(game, count, offset)
+            elif action == "userScores":
+                body = self.server.store.user(game, query["userName"], count)
+            elif action == "newScore":
+                self.server.store.add(game, query["userName"], int(query["score"]))
+                body = {"message": "score added"}
+            else:
+                raise KeyError("action")
+        except (KeyError, ValueError) as error:
+            self.server.stats.count("400")
+            self.send_json(400, {"error": "bad or missing parameter: %s" % error})
+            return
+        self.server.stats.count(action)
+        self.send_json(200, body, cacheable=(action != "newScore"))
+
+    def send_json(self, status, body, cacheable=False):
+        data = json.dumps(body, separators=(",", ":")).encode()
+        etag = '"%s"' % hashlib.sha1(data).hexdigest()[:16]
+        if cacheable and self.headers.get("If-None-Match") == etag:
+            self.send_response(304)
+            self.send_header("ETag", etag)
+            self.send_header("Content-Length", "0")
+            self.end_headers()
+            return
+        self.send_response(status)
+        self.send_header("Content-Type", "application/json")
+        self.send_header("Content-Length", str(len(data)))
+        self.send_header("Access-Control-Allow-Origin", "*")
+        if cacheable:
+            self.send_header("ETag", etag)
+            self.send_header("Cache-Control", "no-cache")
+        self.end_headers()
+        self.wfile.write(data)
+
+    def log_message(self, format, *args):
+        if self.server.options.verbose:
+            super().log_message(format, *args)
+
+
+def report(stats, interval):
+    """Print the request rate every interval seconds."""
+    while True:
+        time.sleep(interval)
+        counts = stats.take()
+        total = sum(counts.values())
+        detail = ", ".join("%s %d" % item for item in sorted(counts.items()))
+        print("%7.1f req/s  (%s)" % (total / interval, detail or "idle"), flush=True)
+
+
+def fraction(text):
+    value = float(text)
+    if not 0.0 <= value <= 1.0:
+        raise argparse.ArgumentTypeError("must be between 0 and 1")
+    return value
+
+
+def main():
+    parser = argparse.ArgumentParser(description="Local stand-in leaderboard server")
+    parser.add_argument("--host", default="127.0.0.1")
+    parser.add_argument("--port", type=int, default=8765)
+    parser.add_argument("--latency", type=float, default=0.0, help="added delay per request, ms")
+    parser.add_argument("--jitter", type=float, default=0.0, help="uniform +/- variation of the delay, ms")
+    parser.add_argument("--fail-rate", type=fraction, default=0.0, help="fraction of requests answered 503")
+    parser.add_argument("--drop-rate", type=fraction, default=0.0, help="fraction of connections dropped unanswered")
+    parser.add_argument("--scores", type=int, default=0, help="random scores to start with (game 19 and 21)")
+    parser.add_argument("--seed", type=int, default=None, help="random seed for scores and injection")
+    parser.add_argument("--no-offset", action="store_true",
+                        help="ignore the topScores offset, like a service without paging")
+    parser.add_argument("--report", type=float, default=5.0, help="seconds between throughput reports, 0: none")
+    parser.add_argument("--verbose", action="store_true", help="log every request")
+    options = parser.parse_args()
+    if options.fail_rate + options.drop_rate > 1.0:
+        parser.error("--fail-rate plus --drop-rate is more than 1")
+
+    random.seed(options.seed)
+    store = ScoreStore()
+    for i in range(options.scores):
+        name = "".join(random.choice(NAME_LETTERS) for _ in range(3))
+        store.add(19 if i % 2 else 21, name, random.randint(1, 500))
+
+    server = Server((options.host, options.port), Handler)
+    server.options = options
+    server.store = store
+    server.stats = Stats()
+    if options.report > 0:
+        threading.Thread(target=report, args=(server.stats, options.report), daemon=True).start()
+
+    print("Leaderboard stand-in on http://%s:%d/ (%d scores)" % (options.host, options.port, store.size()))
+    print("  TAILGUNNER_LEADERBOARD_URL=http://%s:%d/" % (options.host, options.port), flush=True)
+    try:
+        server.serve_forever()
+    except KeyboardInterrupt:
+        pass
+    server.server_close()
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
@@ -0,0 +1,303 @@
+//================================================================================================
+//
+//   parsecheck.c - Equivalence check of the two leaderboard response parsers
+//
+//   Runs the streaming parser and the cJSON tree walk over the same bodies and fails if
+//   they disagree: on validity, entry count or any entry. The streaming parser is fed
+//   each body whole, one byte at a time and in random pieces. Bodies are hand-written
+//   edge cases (long names, out-of-range and fractional scores, escapes, repeated keys,
+//   invalid JSON), random well-formed responses, and random byte edits of those. Build
+//   and run with `make parse-check` before switching LEADERBOARD_STREAM_PARSER.
+//
+//   Usage: parsecheck [--cases=N] [--seed=S]
+//   Exit status: 0 if the parsers agree on every body, 1 on a mismatch, 2 usage error.
+//
+//   A mismatching body is printed; rerun with the same --seed to reproduce it.
+//
+//================================================================================================
+
+#include "config.h"
+#include "leaderboard_parse.h"
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define CHECK_DEFAULT_CASES 20000
+#define CHECK_MAX_BODY 4096    // Longest generated body
+#define CHECK_MAX_PAGE 64      // Page entries compared; generated pages stay below this
+#define CHECK_MAX_REPORTED 10  // Mismatches printed in full
+#define CHECK_EDITS_PER_BODY 4 // Randomly edited copies of each generated body
+
+// Entries of one page parse, in the order they were handed on
+typedef struct PageResult {
+    LeaderboardEntry entries[CHECK_MAX_PAGE];
+    int count;
+} PageResult;
+
+static uint64_t s_rng;
+static int s_checked;
+static int s_mismatches;
+
+// Hand-written bodies: each exercised as a topScores response, a userScores response and a page
+static const char *s_edgeCases[] = {
+    "[]",
+    "{}",
+    "",
+    "   ",
+    "[",
+    "[{\"userName\":\"ABC\",\"score\":5}]",
+    "[{\"userName\":\"ABCD\",\"score\":5},{\"userName\":\"ABCD\",\"score\":5}]",
+    "[{\"userName\":\"ABCD\",\"score\":5},{\"userName\":\"ABCE\",\"score\":5}]",
+    "[{\"userName\":\"AB\",\"score\":3e9},{\"userName\":\"AB\",\"score\":-3e9},{\"userName\":\"AB\",\"score\":1e400}]",
+    "[{\"userName\":\"AB\",\"score\":2147483647},{\"userName\":\"AB\",\"score\":2147483648}]",
+    "[{\"userName\":\"AB\",\"score\":12.7},{\"userName\":\"AB\",\"score\":-0.5},{\"userName\":\"AB\",\"score\":1E2}]",
+    "[{\"score\":5,\"userName\":\"X\"},{\"userName\":\"Y\"},{\"score\":6},{\"userName\":7,\"score\":8}]",
+    "[{\"userName\":\"A\",\"userName\":\"B\",\"score\":1,\"score\":2}]",
+    "[{\"userName\":\"\\u00e9\\u00e9\",\"score\":1},{\"userName\":\"\\ud83d\\ude00\",\"score\":2}]",
+    "[{\"userName\":\"a\\\"b\\\\c\",\"score\":1},{\"userName\":\"\\n\\t\",\"score\":2}]",
+    "[{\"userName\":\"AB\",\"score\":1,\"extra\":{\"userName\":\"ZZ\",\"score\":9}}]",
+    "[{\"userName\":\"AB\",\"score\":1}] trailing",
+    "[{\"userName\":\"AB\",\"score\":1},]",
+    "[{\"userName\":\"AB\",\"score\":01}]",
+    "[{\"userName\":\"AB\",\"score\":1}",
+    "[[{\"userName\":\"AB\",\"score\":1}],{\"userName\":\"CD\",\"score\":2}]",
+    "[1,\"x\",null,true,{\"AB\":3},{\"CD\":\"4\"},{\"EF\":null},{\"GHIJK\":5,\"x\":6}]",
+    "{\"a\":{\"userName\":\"AB\",\"score\":1},\"b\":{\"XY\":2}}",
+    "[{\"\":1},{\"userName\":\"\",\"score\":0}]",
+    "[{\"userName\":\"AB\",\"score\":1}]\x01",
+    "[{\"userName\":\"A\x01\",\"score\":1}]",
+    "[{\"userName\":\"AB\",\"score\":-}]",
+    "[{\"userName\":\"AB\",\"score\":tru}]",
+    "[{\"userName\":\"\\uD800\",\"score\":1}]",
+    "[{\"userName\":\"\\x\",\"score\":1}]",
+};
+
+//----------------------------------------------------------------------------------
+// Helpers
+//----------------------------------------------------------------------------------
+
+// xorshift64*: deterministic for a given --seed
+static uint64_t NextRandom(void)
+{
+    s_rng ^= s_rng >> 12;
+    s_rng ^= s_rng << 25;
+    s_rng ^= s_rng >> 27;
+    return s_rng * 0x2545f4914f6cdd1dull;
+}
+
+static int RandomBelow(int n)
+{
+    return (int)(NextRandom() % (uint64_t)n);
+}
+
+static void Append(char *body, size_t *length, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    int n = vsnprintf(body + *length, CHECK_MAX_BODY - *length, format, args);
+    va_end(args);
+    if (n > 0) *length += (size_t)n;
+    if (*length >= CHECK_MAX_BODY) *length = CHECK_MAX_BODY - 1;
+}
+
+static void CollectPageEntry(void *context, const char *name, int score)
+{
+    PageResult *page = (PageResult *)context;
+    if (page->count < CHECK_MAX_PAGE) {
+        snprintf(page->entries[page->count].name, sizeof(page->entries[0].name), "%s", name);
+        page->entries[page->count].score = score;
+    }
+    page->count++;
+}
+
+// Stream body through parser in pieces: whole (piece 0), of one byte, or random (piece -1)
+static int FeedInPieces(ScoresParser *parser, const char *body, size_t length, int piece)
+{
+    size_t offset = 0;
+    while (offset < length) {
+        size_t n = (piece == 0) ? length : (piece > 0) ? (size_t)piece : 1 + (size_t)RandomBelow(16);
+        if (n > length - offset) n = length - offset;
+        FeedScoresParser(parser, body + offset, n);
+        offset += n;
+    }
+    return FinishScoresParser(parser);
+}
+
+static void ReportMismatch(const char *what, const char *body, size_t length, int expected, int actual)
+{
+    s_mismatches++;
+    if (s_mismatches > CHECK_MAX_REPORTED) return;
+    printf("MISMATCH %s: tree %d, stream %d, body (%zu bytes): %.*s\n", what, expected, actual, length, (int)length,
+           body);
+}
+
+static bool SameEntries(const LeaderboardEntry *a, const LeaderboardEntry *b, int count)
+{
+    for (int i = 0; i < count; i++) {
+        if (a[i].score != b[i].score || strcmp(a[i].name, b[i].name) != 0) return false;
+    }
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// Checks
+//----------------------------------------------------------------------------------
+
+// Compare both parsers on one body, in every format and feed
+static void CheckBody(const char *source, size_t length)
+{
+    // An exact-size copy, so a read past the end shows up under a sanitizer
+    char *body = malloc(length > 0 ? length : 1);
+    memcpy(body, source, length);
+
+    for (int userScores = 0; userScores <= 1; userScores++) {
+        LeaderboardEntry expected[LEADERBOARD_MAX_SCORES];
+        int expectedCount = userScores ? ParseUserScoresTree(body, length, expected)
+                                       : ParseGlobalScoresTree(body, length, expected);
+        const int pieces[] = {0, 1, -1};
+        for (int p = 0; p < 3; p++) {
+            LeaderboardEntry actual[LEADERBOARD_MAX_SCORES];
+            ScoresParser parser;
+            InitScoresParser(&parser, userScores, actual);
+            int count = FeedInPieces(&parser, body, length, pieces[p]);
+            s_checked++;
+            if (count != expectedCount || (count > 0 && !SameEntries(expected, actual, count))) {
+                ReportMismatch(userScores ? "userScores" : "topScores", body, length, expectedCount, count);
+            }
+        }
+    }
+
+    // Pages: an invalid body may have handed on entries before the error, so only the
+    // verdict is compared then
+    PageResult expected = {0};
+    int expectedCount = ParseScoresPageTree(body, length, CollectPageEntry, &expected);
+    for (int piece = 0; piece <= 1; piece++) {
+        PageResult actual = {0};
+        ScoresParser parser;
+        InitScoresPageParser(&parser, CollectPageEntry, &actual);
+        int count = FeedInPieces(&parser, body, length, piece);
+        s_checked++;
+        bool same = count == expectedCount;
+        if (same && count >= 0) {
+            int compared = (count < CHECK_MAX_PAGE) ? count : CHECK_MAX_PAGE;
+            same = actual.count == expected.count && SameEntries(expected.entries, actual.entries, compared);
+        }
+        if (!same) ReportMismatch("page", body, length, expectedCount, count);
+    }
+    free(body);
+}
+
+// A random, mostly well-formed response of either format
+static size_t GenerateBody(char *body)
+{
+    static const char *names[] = {"A", "AB", "ABC", "ABCD", "ABCDE", "", "\\u00c4BC", "A\\\"B", "\\n", "ZZZ"};
+    static const char *scores[] = {"0",   "1",       "42",          "-7",          "12.5",    "-0.9", "1e3",
+                                   "3e9", "-3e9",   "2147483647",  "2147483648",  "1e400",   "0.0",  "999999"};
+    static const char *others[] = {"null", "true", "\"x\"", "[1,2]", "{\"score\":1}", "-1.5e-3"};
+
+    size_t length = 0;
+    bool userScores = RandomBelow(2);
+    int entries = RandomBelow(20);
+    Append(body, &length, RandomBelow(8) ? "[" : " [ ");
+    for (int i = 0; i < entries; i++) {
+        if (i > 0) Append(body, &length, RandomBelow(4) ? "," : " ,\n");
+        // Reuse a small pool so duplicates and names equal after truncation are common
+        const char *name = names[RandomBelow(10)];
+        const char *score = scores[RandomBelow(14)];
+        if (userScores) {
+            Append(body, &length, "{\"%s\":%s", name, RandomBelow(8) ? score : others[RandomBelow(6)]);
+        }
+        else {
+            Append(body, &length, "{");
+            bool nameFirst = RandomBelow(2);
+            if (RandomBelow(6) == 0) Append(body, &length, "\"gameID\":%s,", others[RandomBelow(6)]);
+            if (nameFirst && RandomBelow(10)) Append(body, &length, "\"userName\":\"%s\",", name);
+            Append(body, &length, "\"score\":%s", RandomBelow(10) ? score : others[RandomBelow(6)]);
+            if (!nameFirst && RandomBelow(10)) Append(body, &length, ",\"userName\":\"%s\"", name);
+            if (RandomBelow(6) == 0) Append(body, &length, ",\"score\":%s", score);
+        }
+        if (RandomBelow(5) == 0) Append(body, &length, ",\"date\":\"2025-01-01\"");
+        Append(body, &length, "}");
+    }
+    Append(body, &length, "]");
+    if (RandomBelow(10) == 0) Append(body, &length, RandomBelow(2) ? "  \n" : "x");
+    return length;
+}
+
+// Overwrite, insert or delete one random byte
+static size_t EditBody(char *body, size_t length)
+{
+    static const char alphabet[] = "[]{}:,\"\\-+.eE0123456789untrlfasx \x01\x80";
+    char c = alphabet[RandomBelow((int)sizeof(alphabet) - 1)];
+    size_t at = (length > 0) ? (size_t)RandomBelow((int)length) : 0;
+    switch (RandomBelow(3)) {
+    case 0:
+        if (length > 0) body[at] = c;
+        break;
+    case 1:
+        if (length + 1 < CHECK_MAX_BODY) {
+            memmove(body + at + 1, body + at, length - at);
+            body[at] = c;
+            length++;
+        }
+        break;
+    default:
+        if (length > 0) {
+            memmove(body + at, body + at + 1, length - at - 1);
+            length--;
+        }
+        break;
+    }
+    return length;
+}
+
+int main(int argc, char **argv)
+{
+    int cases = CHECK_DEFAULT_CASES;
+    unsigned long long seed = 1;
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--cases=", 8) == 0)
+            cases = atoi(argv[i] + 8);
+        else if (strncmp(argv[i], "--seed=", 7) == 0)
+            seed = strtoull(argv[i] + 7, NULL, 10);
+        else {
+            fprintf(stderr, "Usage: %s [--cases=N] [--seed=S]\n", argv[0]);
+            return 2;
+        }
+    }
+    s_rng = seed ? seed : 1;
+
+    // The parsers log every invalid body, and most edited bodies are invalid
+    if (freopen("/dev/null", "w", stderr) == NULL) fprintf(stdout, "Could not silence parser logging\n");
+
+    for (int arena = 0; arena <= 1; arena++) {
+        SetParseArenaEnabled(arena);
+        for (size_t i = 0; i < sizeof(s_edgeCases) / sizeof(s_edgeCases[0]); i++) {
+            CheckBody(s_edgeCases[i], strlen(s_edgeCases[i]));
+        }
+    }
+
+    char body[CHECK_MAX_BODY];
+    char edited[CHECK_MAX_BODY];
+    for (int i = 0; i < cases; i++) {
+        SetParseArenaEnabled(i % 2);
+        size_t length = GenerateBody(body);
+        CheckBody(body, length);
+        for (int e = 0; e < CHECK_EDITS_PER_BODY; e++) {
+            memcpy(edited, body, length);
+            size_t editedLength = length;
+            for (int n = 1 + RandomBelow(3); n > 0; n--) editedLength = EditBody(edited, editedLength);
+            CheckBody(edited, editedLength);
+        }
+    }
+    SetParseArenaEnabled(false);
+    ReleaseParseArena();
+
+    printf("parsecheck: %d parses compared, seed %llu: %s\n", s_checked, seed,
+           s_mismatches ? "MISMATCHES" : "parsers agree");
+    if (s_mismatches > CHECK_MAX_REPORTED) {
+        printf("(%d mismatches, first %d shown)\n", s_mismatches, CHECK_MAX_REPORTED);
+    }
+    return s_mismatches ? 1 : 0;
+}
@@ -0,0 +1,369 @@
+//================================================================================================
+//
+//   soak.c - Headless soak/fuzz runner for the gameplay simulation
+//
+//   Plays many seeded games with randomised input on all cores, without a window, and
+//   checks gameplay invariants after every tick. Reports throughput, memory use and any
+//   seed that broke an invariant. Build and run with `make soak`.
+//
+//   Usage: soak [--seeds=N] [--first-seed=S] [--threads=N] [--max-ticks=N]
+//
+//   A failing seed reruns on its own with --first-seed=S --seeds=1. Input is derived from
+//   the seed, so the rerun fails at the same tick.
+//
+//================================================================================================
+
+#include "config.h"
+#include "game.h"
+#include "raymath.h"
+#include "rng.h"
+#include "savestate.h"
+#include <math.h>
+#include <pthread.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define SOAK_DEFAULT_SEEDS 20000
+#define SOAK_DEFAULT_MAX_TICKS 200000     // Ticks before a game that never ends is cut off
+#define SOAK_MAX_THREADS 256
+#define SOAK_MAX_REPORTED 20              // Violations printed in full
+#define SOAK_RSS_SLACK_KB 1024            // Allowed resident set growth after the first second
+#define SOAK_INPUT_SALT 0x9e3779b97f4a7c15ull // Keeps input randomness apart from the game's own RNG
+#define SOAK_AIM_SPEED 60.0f              // Pixels per tick an aiming player moves the crosshair
+#define SOAK_AIM_FIRE_RADIUS 12.0f        // Aiming players fire when this close to the target
+
+// Shared progress and results, guarded by lock
+typedef struct SoakRun {
+    pthread_mutex_t lock;
+    uint64_t firstSeed;
+    int seeds;
+    int maxTicks;
+    int nextSeed;     // Index of the next seed to hand out
+    long long ticks;  // Ticks simulated by finished games
+    int games;        // Games finished
+    int cutOff;       // Games stopped at maxTicks
+    int maxWave;
+    int maxScore;
+    uint64_t digest;  // XOR of final state hashes; independent of thread scheduling
+    int violations;
+} SoakRun;
+
+// Scalar state from the previous tick, for checks that compare ticks
+typedef struct SoakPrevious {
+    int tick;
+    double simTime;
+    int score;
+    int wave;
+    bool emptyWave; // No enemy was active after the previous tick
+} SoakPrevious;
+
+static double NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+// Resident set size in KB (0 where /proc is unavailable)
+static long ResidentKb(void)
+{
+    long pages = 0, resident = 0;
+    FILE *f = fopen("/proc/self/statm", "r");
+    if (f == NULL) return 0;
+    if (fscanf(f, "%ld %ld", &pages, &resident) != 2) resident = 0;
+    fclose(f);
+    return resident * (sysconf(_SC_PAGESIZE) / 1024);
+}
+
+// Format a violation into message; returns false so checks can `return Fail(...)`
+static bool Fail(char *message, size_t size, const char *format, ...)
+{
+    va_list args;
+    va_start(args, format);
+    vsnprintf(message, size, format, args);
+    va_end(args);
+    return false;
+}
+
+static bool IsFiniteVector3(Vector3 v)
+{
+    return isfinite(v.x) && isfinite(v.y) && isfinite(v.z);
+}
+
+// Enemies the current wave spawns (see SpawnWave)
+static int GetWaveSize(const EnemyManager *mgr, int wave)
+{
+    if (wave <= mgr->nerf2Levels) return WAVE_SIZE - 2;
+    if (wave <= mgr->nerf1Levels) return WAVE_SIZE - 1;
+    return WAVE_SIZE;
+}
+
+//----------------------------------------------------------------------------------
+// RandomInput - Implementation Notes:
+// - Mostly steady 60 FPS ticks, with hitches past GAME_MAX_DT and very short ticks mixed in
+// - Aiming players steer toward the nearest enemy and fire when on it, which reaches
+//   late waves; the others wander and fire at random
+// - Occasional window resizes move the screen edges under the crosshair
+//----------------------------------------------------------------------------------
+static void RandomInput(Rng *rng, bool aiming, const GameSession *session, int *width, int *height,
+                        GameInput *input)
+{
+    int roll = GetRngValue(rng, 0, 999);
+    float frameTime = 1.0f / 60.0f + (float)GetRngValue(rng, -500, 500) * 1e-6f;
+    if (roll < 10)
+        frameTime = (float)GetRngValue(rng, 100, 500) / 1000.0f;
+    else if (roll < 20)
+        frameTime = (float)GetRngValue(rng, 1, 4000) * 1e-6f;
+
+    if (GetRngValue(rng, 0, 9999) == 0) {
+        *width = GetRngValue(rng, 320, 3840);
+        *height = GetRngValue(rng, 240, 2160);
+    }
+
+    Vector2 delta = {(float)GetRngValue(rng, -40, 40), (float)GetRngValue(rng, -40, 40)};
+    if (GetRngValue(rng, 0, 499) == 0) delta = (Vector2){(float)GetRngValue(rng, -4000, 4000), 0.0f};
+    bool fire = GetRngValue(rng, 0, 9) == 0;
+
+    if (aiming) {
+        float bestDistance = 1e30f;
+        for (int i = 0; i < WAVE_SIZE; i++) {
+            const Enemy *e = &session->enemies.enemies[i];
+            if (!e->active || e->position.z > -1.0f) continue;
+            Vector2 screen = GetWorldToScreenEx(e->position, session->camera, *width, *height);
+            Vector2 offset = Vector2Subtract(screen, session->virtualMouse);
+            float distance = Vector2Length(offset);
+            if (distance < bestDistance) {
+                bestDistance = distance;
+                delta = (distance > SOAK_AIM_SPEED) ? Vector2Scale(offset, SOAK_AIM_SPEED / distance) : offset;
+            }
+        }
+        fire = bestDistance < SOAK_AIM_FIRE_RADIUS;
+    }
+
+    double fireAge = (double)GetRngValue(rng, 0, 150) / 1000.0;
+    bool forceField = GetRngValue(rng, 0, 199) == 0;
+    BuildGameInput(input, frameTime, delta, fire, fireAge, forceField, *width, *height);
+}
+
+//----------------------------------------------------------------------------------
+// CheckInvariants - Implementation Notes:
+// - Writes a description of the first broken invariant to message and returns false
+// - A cleared wave is replaced on the next tick, so one tick with no active enemy is
+//   allowed but two in a row are not
+//----------------------------------------------------------------------------------
+static bool CheckInvariants(const GameSession *s, const SoakPrevious *prev, const GameInput *input, int events,
+                            char *message, size_t size)
+{
+    bool gameOver = (events & GAME_EVENT_GAME_OVER) != 0;
+
+    if (s->tick != prev->tick + 1) return Fail(message, size, "tick %d after %d", s->tick, prev->tick);
+    if (fabs(s->simTime - prev->simTime - GetGameInputDt(input)) > 1e-9)
+        return Fail(message, size, "simTime %.9f does not follow %.9f", s->simTime, prev->simTime);
+    if (!gameOver && s->lives <= 0) return Fail(message, size, "lives %d without game over", s->lives);
+    // Game over is decided before the extra life check, so both can happen on the same tick
+    if (gameOver && s->lives > 0 && !(events & GAME_EVENT_EXTRA_LIFE))
+        return Fail(message, size, "game over with %d lives", s->lives);
+    if (s->score < prev->score || s->score > prev->score + 1)
+        return Fail(message, size, "score went from %d to %d in one tick", prev->score, s->score);
+    if (s->wave < prev->wave || s->wave > prev->wave + 1)
+        return Fail(message, size, "wave went from %d to %d in one tick", prev->wave, s->wave);
+    if (s->scoreAtLastLife > s->score || s->scoreAtLastLife % s->pointsForExtraLife != 0 ||
+        s->score - s->scoreAtLastLife >= s->pointsForExtraLife)
+        return Fail(message, size, "extra life bookkeeping: score %d, last life at %d", s->score,
+                        s->scoreAtLastLife);
+
+    Vector2 m = s->virtualMouse;
+    if (!isfinite(m.x) || !isfinite(m.y) || m.x < 0 || m.y < 0 || m.x > input->screenWidth ||
+        m.y > input->screenHeight)
+        return Fail(message, size, "crosshair (%g, %g) outside %dx%d", m.x, m.y, input->screenWidth,
+                        input->screenHeight);
+
+    int active = 0;
+    for (int i = 0; i < WAVE_SIZE; i++) {
+        const Enemy *e = &s->enemies.enemies[i];
+        const EnemyHistory *h = &e->history;
+        if (!e->active) {
+            if (h->count != 0) return Fail(message, size, "inactive enemy %d keeps history", i);
+            continue;
+        }
+        active++;
+        if (!IsFiniteVector3(e->position) || !IsFiniteVector3(e->p0) || !IsFiniteVector3(e->p3) ||
+            !isfinite(e->rotationAngle))
+            return Fail(message, size, "enemy %d has a non-finite position or angle", i);
+        if (e->state != ENEMY_STATE_NORMAL && e->state != ENEMY_STATE_REPELLED)
+            return Fail(message, size, "enemy %d in unknown state %d", i, (int)e->state);
+        bool repelled = e->state == ENEMY_STATE_REPELLED;
+        if (e->t < 0.0f || e->t >= 1.0f || (repelled && (e->repel_t < 0.0f || e->repel_t >= 1.0f)))
+            return Fail(message, size, "enemy %d progress t=%g repel_t=%g", i, e->t, e->repel_t);
+
+        Vector3 forward = GetEnemyForward(e);
+        if (!IsFiniteVector3(forward) || fabsf(Vector3Length(forward) - 1.0f) > 1e-3f)
+            return Fail(message, size, "enemy %d forward (%g, %g, %g) is not a unit vector", i, forward.x,
+                            forward.y, forward.z);
+        if (h->count < 1 || h->count > ENEMY_HISTORY_SIZE || h->head < 0 || h->head >= ENEMY_HISTORY_SIZE ||
+            h->time[h->head] != s->simTime)
+            return Fail(message, size, "enemy %d history count %d head %d", i, h->count, h->head);
+    }
+    int waveSize = GetWaveSize(&s->enemies, s->wave);
+    if (active > waveSize) return Fail(message, size, "%d enemies active in wave %d of %d", active, s->wave, waveSize);
+    if (active == 0 && prev->emptyWave && !gameOver)
+        return Fail(message, size, "no enemies for two ticks in wave %d", s->wave);
+
+    for (int i = 0; i < MAX_LASERS; i++) {
+        const Laser *l = &s->lasers.lasers[i];
+        if (!l->active) continue;
+        if (!(l->lifeTime > 0.0f && l->lifeTime <= LASER_LIFETIME) || !IsFiniteVector3(l->start) ||
+            !IsFiniteVector3(l->end))
+            return Fail(message, size, "laser %d lifeTime %g or end points invalid", i, l->lifeTime);
+    }
+
+    const ForceFieldManager *ff = &s->forceField;
+    if (ff->state < FF_STATE_READY || ff->state > FF_STATE_COOLDOWN || !(ff->charge >= 0.0f && ff->charge <= 1.0f))
+        return Fail(message, size, "force field state %d charge %g", (int)ff->state, ff->charge);
+
+    return true;
+}
+
+//----------------------------------------------------------------------------------
+// SoakWorker - Implementation Notes:
+// - Takes seeds one at a time from the shared counter, so threads stay busy however long
+//   each game lasts
+// - Every odd seed gets an aiming player
+//----------------------------------------------------------------------------------
+static void *SoakWorker(void *arg)
+{
+    SoakRun *run = (SoakRun *)arg;
+    Camera camera = {0};
+    camera.target = (Vector3){0.0f, 0.0f, -1.0f};
+    camera.up = (Vector3){0.0f, 1.0f, 0.0f};
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+
+    for (;;) {
+        pthread_mutex_lock(&run->lock);
+        int index = run->nextSeed < run->seeds ? run->nextSeed++ : -1;
+        pthread_mutex_unlock(&run->lock);
+        if (index < 0) break;
+
+        uint64_t seed = run->firstSeed + (uint64_t)index;
+        Rng inputRng;
+        SeedRng(&inputRng, seed ^ SOAK_INPUT_SALT);
+        int width = 1600, height = 900;
+
+        GameSession session;
+        InitGameSession(&session, camera, seed, width, height);
+        SoakPrevious prev = {0};
+        char message[160] = "";
+        bool ok = true;
+        int events = 0;
+
+        while (!(events & GAME_EVENT_GAME_OVER) && session.tick < run->maxTicks) {
+            prev = (SoakPrevious){session.tick, session.simTime, session.score, session.wave, prev.emptyWave};
+            GameInput input;
+            RandomInput(&inputRng, (seed & 1) != 0, &session, &width, &height, &input);
+            events = StepGame(&session, &input);
+            if (!CheckInvariants(&session, &prev, &input, events, message, sizeof(message))) {
+                ok = false;
+                break;
+            }
+            prev.emptyWave = true;
+            for (int i = 0; i < WAVE_SIZE; i++) {
+                if (session.enemies.enemies[i].active) prev.emptyWave = false;
+            }
+        }
+
+        pthread_mutex_lock(&run->lock);
+        run->ticks += session.tick;
+        run->games++;
+        if (!(events & GAME_EVENT_GAME_OVER) && ok) run->cutOff++;
+        if (session.wave > run->maxWave) run->maxWave = session.wave;
+        if (session.score > run->maxScore) run->maxScore = session.score;
+        run->digest ^= HashGameSession(&session);
+        if (!ok && run->violations++ < SOAK_MAX_REPORTED) {
+            printf("VIOLATION seed=%llu tick=%d: %s (rerun with --first-seed=%llu --seeds=1)\n",
+                   (unsigned long long)seed, session.tick, message, (unsigned long long)seed);
+        }
+        pthread_mutex_unlock(&run->lock);
+    }
+    return NULL;
+}
+
+int main(int argc, char **argv)
+{
+    SoakRun run = {0};
+    run.seeds = SOAK_DEFAULT_SEEDS;
+    run.firstSeed = 1;
+    run.maxTicks = SOAK_DEFAULT_MAX_TICKS;
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+
+    for (int i = 1; i < argc; i++) {
+        if (strncmp(argv[i], "--seeds=", 8) == 0)
+            run.seeds = atoi(argv[i] + 8);
+        else if (strncmp(argv[i], "--first-seed=", 13) == 0)
+            run.firstSeed = strtoull(argv[i] + 13, NULL, 10);
+        else if (strncmp(argv[i], "--threads=", 10) == 0)
+            threads = atoi(argv[i] + 10);
+        else if (strncmp(argv[i], "--max-ticks=", 12) == 0)
+            run.maxTicks = atoi(argv[i] + 12);
+        else {
+            fprintf(stderr, "Usage: %s [--seeds=N] [--first-seed=S] [--threads=N] [--max-ticks=N]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (threads > SOAK_MAX_THREADS) threads = SOAK_MAX_THREADS;
+    pthread_mutex_init(&run.lock, NULL);
+
+    printf("soak: %d seeds from %llu on %d threads, up to %d ticks per game\n", run.seeds,
+           (unsigned long long)run.firstSeed, threads, run.maxTicks);
+
+    pthread_t workers[SOAK_MAX_THREADS];
+    double start = NowSeconds();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&workers[i], NULL, SoakWorker, &run);
+    }
+
+    // Sample memory once a second while the workers run; the baseline is taken after the first
+    // second so thread stacks and first-touch pages are already counted
+    long baselineKb = 0, peakKb = 0;
+    double nextReport = start + 1.0;
+    for (;;) {
+        struct timespec poll = {0, 50 * 1000 * 1000};
+        nanosleep(&poll, NULL);
+        pthread_mutex_lock(&run.lock);
+        int games = run.games;
+        long long ticks = run.ticks;
+        pthread_mutex_unlock(&run.lock);
+        if (games >= run.seeds) break;
+        if (NowSeconds() < nextReport) continue;
+        nextReport += 1.0;
+
+        long rss = ResidentKb();
+        if (baselineKb == 0) baselineKb = rss;
+        if (rss > peakKb) peakKb = rss;
+        printf("  %d/%d games, %lld ticks, %.0f ticks/s, rss %ld KB\n", games, run.seeds, ticks,
+               ticks / (NowSeconds() - start), rss);
+        fflush(stdout);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    double elapsed = NowSeconds() - start;
+    long endKb = ResidentKb();
+    if (baselineKb == 0) baselineKb = endKb; // Finished within the first second
+    if (endKb > peakKb) peakKb = endKb;
+    bool memoryFlat = endKb - baselineKb <= SOAK_RSS_SLACK_KB;
+
+    printf("SOAK games=%d ticks=%lld cut_off=%d max_wave=%d max_score=%d seconds=%.2f ticks_per_s=%.0f "
+           "rss_kb=%ld..%ld peak_kb=%ld violations=%d digest=%016llx\n",
+           run.games, run.ticks, run.cutOff, run.maxWave, run.maxScore, elapsed, run.ticks / elapsed, baselineKb,
+           endKb, peakKb, run.violations, (unsigned long long)run.digest);
+    if (!memoryFlat) printf("FAIL: resident memory grew by %ld KB\n", endKb - baselineKb);
+
+    pthread_mutex_destroy(&run.lock);
+    return (run.violations == 0 && memoryFlat) ? 0 : 1;
+}
@@ -0,0 +1,453 @@
+//================================================================================================
+//
+//   tune.c - Offline Monte Carlo difficulty tuner
+//
+//   Plays thousands of autopilot games for every point of a grid of balancing parameters
+//   (see GameTuning) on all cores, without a window, and reports how long games last:
+//   survival by wave, wave and score distributions. Build and run with `make tune`.
+//
+//   Usage: tune [--grid=param=v1,v2,...]... [--games=N] [--first-seed=S] [--threads=N]
+//               [--skill=reaction_ms[,aim_error_px]] [--max-ticks=N] [--csv=prefix]
+//
+//   Parameters: path_speed, wave_speedup, nerf2, nerf1, extra_life, ff_timeout. A grid
+//   value list is comma-separated, or a range first:last:step. Parameters without a grid
+//   keep their config.h value. Every grid point plays the same seeds (game i uses seed
+//   first-seed + i), so differences between points come from the parameters, not luck.
+//
+//   With --csv=prefix, writes prefix_summary.csv (one row per point), prefix_survival.csv
+//   (fraction of games reaching each wave) and prefix_scores.csv (score histogram).
+//
+//================================================================================================
+
+#include "autopilot.h"
+#include "config.h"
+#include "game.h"
+#include <float.h>
+#include <limits.h>
+#include <math.h>
+#include <pthread.h>
+#include <stdatomic.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+
+#define TUNE_DEFAULT_GAMES 2000         // Games per grid point
+#define TUNE_DEFAULT_MAX_TICKS 200000   // Ticks before a game that never ends is cut off
+#define TUNE_MAX_THREADS 256
+#define TUNE_MAX_POINTS 4096
+#define TUNE_MAX_VALUES 64              // Values per parameter
+#define TUNE_MAX_WAVE 255               // Games ending later are counted at this wave
+#define TUNE_SCORE_BIN 5                // Score histogram bin width
+#define TUNE_SCORE_BINS 512             // Last bin collects higher scores
+
+// A GameTuning field the grid can vary
+typedef struct TuneParameter {
+    const char *name;
+    size_t offset;     // Of the field in GameTuning
+    bool isFloat;      // float field, otherwise int
+    double min;        // Smallest usable value
+    bool minExclusive; // min itself is not usable (a speed or divisor of 0)
+} TuneParameter;
+
+// A path speed or force field timeout of 0, or an extra life every 0 points, makes games
+// that never end (or divides by zero), so the grid rejects them
+static const TuneParameter parameters[] = {
+    {"path_speed", offsetof(GameTuning, enemyPathSpeed), true, 0.0, true},
+    {"wave_speedup", offsetof(GameTuning, enemyWaveSpeedup), true, 0.0, false},
+    {"nerf2", offsetof(GameTuning, waveNerf2Levels), false, 0.0, false},
+    {"nerf1", offsetof(GameTuning, waveNerf1Levels), false, 0.0, false},
+    {"extra_life", offsetof(GameTuning, pointsForExtraLife), false, 1.0, false},
+    {"ff_timeout", offsetof(GameTuning, forceFieldTimeout), true, 0.0, true},
+};
+#define TUNE_PARAMETER_COUNT ((int)(sizeof(parameters) / sizeof(parameters[0])))
+
+// Results of one grid point; workers add to them without locks
+typedef struct TunePoint {
+    GameTuning tuning;
+    atomic_llong endWave[TUNE_MAX_WAVE + 1]; // Games that ended on each wave
+    atomic_llong scores[TUNE_SCORE_BINS];    // Games by final score
+    atomic_llong ticks;                      // Ticks played by all games
+    atomic_llong scoreSum;
+    atomic_llong cutOff;                     // Games stopped at maxTicks
+} TunePoint;
+
+// The whole sweep; read-only while workers run except for the atomics
+typedef struct TuneRun {
+    TunePoint *points;
+    int pointCount;
+    int games; // Per point
+    uint64_t firstSeed;
+    int maxTicks;
+    AutopilotSkill skill;
+    atomic_llong nextJob;   // Next (point, game) pair to play, as point * games + game
+    atomic_llong jobsDone;
+    atomic_llong ticksDone; // For the progress report
+} TuneRun;
+
+// Grid values given for each parameter
+typedef struct TuneGrid {
+    double values[TUNE_PARAMETER_COUNT][TUNE_MAX_VALUES];
+    int count[TUNE_PARAMETER_COUNT]; // 0: parameter keeps its default
+} TuneGrid;
+
+static double NowSeconds(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (double)ts.tv_sec + (double)ts.tv_nsec * 1e-9;
+}
+
+static double GetParameter(const GameTuning *tuning, const TuneParameter *p)
+{
+    const char *field = (const char *)tuning + p->offset;
+    return p->isFloat ? *(const float *)field : *(const int *)field;
+}
+
+static void SetParameter(GameTuning *tuning, const TuneParameter *p, double value)
+{
+    char *field = (char *)tuning + p->offset;
+    if (p->isFloat)
+        *(float *)field = (float)value;
+    else
+        *(int *)field = (int)(value < 0 ? value - 0.5 : value + 0.5);
+}
+
+//----------------------------------------------------------------------------------
+// ParseGrid - Implementation Notes:
+// - "name=a,b,c" or "name=first:last:step"; a range includes last when the steps reach it
+//   (with a little slack for float rounding)
+// - Every value is checked against the parameter's minimum and the field's type range
+//----------------------------------------------------------------------------------
+static bool ParseGrid(const char *text, TuneGrid *grid)
+{
+    const char *equals = strchr(text, '=');
+    if (equals == NULL) return false;
+    int index = -1;
+    for (int i = 0; i < TUNE_PARAMETER_COUNT; i++) {
+        if (strlen(parameters[i].name) == (size_t)(equals - text) &&
+            strncmp(parameters[i].name, text, equals - text) == 0)
+            index = i;
+    }
+    if (index < 0) return false;
+
+    const char *values = equals + 1;
+    double first, last, step;
+    int count = 0;
+    if (sscanf(values, "%lf:%lf:%lf", &first, &last, &step) == 3) {
+        if (step <= 0 || last < first) return false;
+        for (double v = first; v <= last + step * 1e-6 && count < TUNE_MAX_VALUES; v += step) {
+            grid->values[index][count++] = v;
+        }
+    }
+    else {
+        const char *p = values;
+        while (*p != '\0' && count < TUNE_MAX_VALUES) {
+            char *end;
+            grid->values[index][count++] = strtod(p, &end);
+            if (end == p || (*end != ',' && *end != '\0')) return false;
+            p = (*end == ',') ? end + 1 : end;
+        }
+    }
+    for (int i = 0; i < count; i++) {
+        const TuneParameter *p = &parameters[index];
+        double v = grid->values[index][i];
+        bool low = p->minExclusive ? v <= p->min : v < p->min;
+        if (!isfinite(v) || low) {
+            fprintf(stderr, "--grid: %s must be %s %g, got %g\n", p->name, p->minExclusive ? ">" : ">=", p->min, v);
+            return false;
+        }
+        if (v > (p->isFloat ? FLT_MAX : INT_MAX)) {
+            fprintf(stderr, "--grid: %s value %g does not fit its field\n", p->name, v);
+            return false;
+        }
+    }
+    grid->count[index] = count;
+    return count > 0;
+}
+
+//----------------------------------------------------------------------------------
+// TuneWorker - Implementation Notes:
+// - Takes one game at a time from the shared job counter (an atomic add, no lock), so
+//   threads stay busy however long each game lasts
+// - Results go straight into the point's counters with relaxed atomic adds: one per
+//   counter per game, which is noise next to the thousands of ticks a game takes, so
+//   throughput is limited by the cores rather than by contention
+// - Each game is deterministic in its seed and tuning, and counts add up the same in
+//   any order, so the output does not depend on the thread count
+//----------------------------------------------------------------------------------
+static void *TuneWorker(void *arg)
+{
+    TuneRun *run = (TuneRun *)arg;
+    Camera camera = {0};
+    camera.target = (Vector3){0.0f, 0.0f, -1.0f};
+    camera.up = (Vector3){0.0f, 1.0f, 0.0f};
+    camera.fovy = 45.0f;
+    camera.projection = CAMERA_PERSPECTIVE;
+    const int width = 1600, height = 900;
+    long long jobs = (long long)run->pointCount * run->games;
+
+    for (;;) {
+        long long job = atomic_fetch_add_explicit(&run->nextJob, 1, memory_order_relaxed);
+        if (job >= jobs) break;
+        TunePoint *point = &run->points[job / run->games];
+        uint64_t seed = run->firstSeed + (uint64_t)(job % run->games);
+
+        GameSession session;
+        InitTunedGameSession(&session, camera, seed, width, height, &point->tuning);
+        Autopilot bot;
+        InitAutopilot(&bot, run->skill, seed);
+        int events = 0;
+        while (!(events & GAME_EVENT_GAME_OVER) && session.tick < run->maxTicks) {
+            GameInput input;
+            UpdateAutopilot(&bot, &session, AUTOPILOT_HEADLESS_DT, width, height, &input);
+            events = StepGame(&session, &input);
+        }
+
+        int wave = session.wave < TUNE_MAX_WAVE ? session.wave : TUNE_MAX_WAVE;
+        int bin = session.score / TUNE_SCORE_BIN;
+        if (bin >= TUNE_SCORE_BINS) bin = TUNE_SCORE_BINS - 1;
+        atomic_fetch_add_explicit(&point->endWave[wave], 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&point->scores[bin], 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&point->ticks, session.tick, memory_order_relaxed);
+        atomic_fetch_add_explicit(&point->scoreSum, session.score, memory_order_relaxed);
+        if (!(events & GAME_EVENT_GAME_OVER)) atomic_fetch_add_explicit(&point->cutOff, 1, memory_order_relaxed);
+        atomic_fetch_add_explicit(&run->ticksDone, session.tick, memory_order_relaxed);
+        atomic_fetch_add_explicit(&run->jobsDone, 1, memory_order_relaxed);
+    }
+    return NULL;
+}
+
+// Smallest index whose cumulative count reaches fraction q of total
+static int Quantile(const atomic_llong *counts, int bins, long long total, double q)
+{
+    long long need = (long long)(q * total + 0.5), seen = 0;
+    if (need < 1) need = 1;
+    for (int i = 0; i < bins; i++) {
+        seen += atomic_load(&counts[i]);
+        if (seen >= need) return i;
+    }
+    return bins - 1;
+}
+
+// Fraction of a point's games that reached wave (ended on it or later)
+static double Survival(const TunePoint *point, int wave, long long games)
+{
+    long long ended = 0;
+    for (int w = 0; w < wave && w <= TUNE_MAX_WAVE; w++) {
+        ended += atomic_load(&point->endWave[w]);
+    }
+    return (double)(games - ended) / games;
+}
+
+static void WriteParameterHeader(FILE *f)
+{
+    fprintf(f, "point");
+    for (int i = 0; i < TUNE_PARAMETER_COUNT; i++) {
+        fprintf(f, ",%s", parameters[i].name);
+    }
+}
+
+static void WriteParameterValues(FILE *f, const TunePoint *point, int index)
+{
+    fprintf(f, "%d", index);
+    for (int i = 0; i < TUNE_PARAMETER_COUNT; i++) {
+        fprintf(f, ",%g", GetParameter(&point->tuning, &parameters[i]));
+    }
+}
+
+//----------------------------------------------------------------------------------
+// WriteCsv - Implementation Notes:
+// - Long format (one row per point and wave / score bin) so the files load straight into
+//   a spreadsheet pivot or a plotting library
+//----------------------------------------------------------------------------------
+static bool WriteCsv(const TuneRun *run, const char *prefix)
+{
+    char path[512];
+    const char *suffixes[] = {"summary", "survival", "scores"};
+    for (int file = 0; file < 3; file++) {
+        snprintf(path, sizeof(path), "%s_%s.csv", prefix, suffixes[file]);
+        FILE *f = fopen(path, "w");
+        if (f == NULL) {
+            fprintf(stderr, "Cannot write %s\n", path);
+            return false;
+        }
+        WriteParameterHeader(f);
+        if (file == 0) fprintf(f, ",games,cut_off,mean_wave,p10_wave,median_wave,p90_wave,mean_score,"
+                                  "median_score,mean_seconds\n");
+        if (file == 1) fprintf(f, ",wave,survival\n");
+        if (file == 2) fprintf(f, ",score_from,games\n");
+
+        for (int p = 0; p < run->pointCount; p++) {
+            const TunePoint *point = &run->points[p];
+            long long games = run->games;
+            if (file == 0) {
+                double waveSum = 0;
+                for (int w = 0; w <= TUNE_MAX_WAVE; w++) {
+                    waveSum += (double)w * atomic_load(&point->endWave[w]);
+                }
+                WriteParameterValues(f, point, p);
+                fprintf(f, ",%lld,%lld,%.3f,%d,%d,%d,%.3f,%d,%.2f\n", games, (long long)atomic_load(&point->cutOff),
+                        waveSum / games, Quantile(point->endWave, TUNE_MAX_WAVE + 1, games, 0.1),
+                        Quantile(point->endWave, TUNE_MAX_WAVE + 1, games, 0.5),
+                        Quantile(point->endWave, TUNE_MAX_WAVE + 1, games, 0.9),
+                        (double)atomic_load(&point->scoreSum) / games,
+                        Quantile(point->scores, TUNE_SCORE_BINS, games, 0.5) * TUNE_SCORE_BIN,
+                        atomic_load(&point->ticks) * AUTOPILOT_HEADLESS_DT / games);
+            }
+            else if (file == 1) {
+                int lastWave = Quantile(point->endWave, TUNE_MAX_WAVE + 1, games, 1.0);
+                for (int w = 1; w <= lastWave; w++) {
+                    WriteParameterValues(f, point, p);
+                    fprintf(f, ",%d,%.5f\n", w, Survival(point, w, games));
+                }
+            }
+            else {
+                for (int b = 0; b < TUNE_SCORE_BINS; b++) {
+                    long long count = atomic_load(&point->scores[b]);
+                    if (count == 0) continue;
+                    WriteParameterValues(f, point, p);
+                    fprintf(f, ",%d,%lld\n", b * TUNE_SCORE_BIN, count);
+                }
+            }
+        }
+        fclose(f);
+        printf("Wrote %s\n", path);
+    }
+    return true;
+}
+
+int main(int argc, char **argv)
+{
+    TuneRun run = {0};
+    run.games = TUNE_DEFAULT_GAMES;
+    run.firstSeed = 1;
+    run.maxTicks = TUNE_DEFAULT_MAX_TICKS;
+    run.skill = GetDefaultAutopilotSkill();
+    int threads = (int)sysconf(_SC_NPROCESSORS_ONLN);
+    const char *csvPrefix = NULL;
+    static TuneGrid grid;
+
+    for (int i = 1; i < argc; i++) {
+        bool ok = true;
+        if (strncmp(argv[i], "--grid=", 7) == 0)
+            ok = ParseGrid(argv[i] + 7, &grid);
+        else if (strncmp(argv[i], "--games=", 8) == 0)
+            ok = (run.games = atoi(argv[i] + 8)) > 0;
+        else if (strncmp(argv[i], "--first-seed=", 13) == 0)
+            run.firstSeed = strtoull(argv[i] + 13, NULL, 10);
+        else if (strncmp(argv[i], "--threads=", 10) == 0)
+            threads = atoi(argv[i] + 10);
+        else if (strncmp(argv[i], "--skill=", 8) == 0)
+            ok = ParseAutopilotSkill(argv[i] + 8, &run.skill);
+        else if (strncmp(argv[i], "--max-ticks=", 12) == 0)
+            run.maxTicks = atoi(argv[i] + 12);
+        else if (strncmp(argv[i], "--csv=", 6) == 0)
+            csvPrefix = argv[i] + 6;
+        else
+            ok = false;
+        if (!ok) {
+            fprintf(stderr,
+                    "Usage: %s [--grid=param=v1,v2,...|first:last:step]... [--games=N] [--first-seed=S] "
+                    "[--threads=N] [--skill=reaction_ms[,aim_error_px]] [--max-ticks=N] [--csv=prefix]\n"
+                    "Parameters:",
+                    argv[0]);
+            for (int p = 0; p < TUNE_PARAMETER_COUNT; p++) {
+                fprintf(stderr, " %s", parameters[p].name);
+            }
+            fprintf(stderr, "\n");
+            return 2;
+        }
+    }
+    if (threads < 1) threads = 1;
+    if (threads > TUNE_MAX_THREADS) threads = TUNE_MAX_THREADS;
+
+    // Expand the grid: every combination of the given values, other parameters at their defaults
+    run.pointCount = 1;
+    for (int p = 0; p < TUNE_PARAMETER_COUNT; p++) {
+        if (grid.count[p] > 0) run.pointCount *= grid.count[p];
+        if (run.pointCount > TUNE_MAX_POINTS) {
+            fprintf(stderr, "Grid has more than %d points\n", TUNE_MAX_POINTS);
+            return 2;
+        }
+    }
+    // calloc'd zeroes are valid initial values for the lock-free atomic counters
+    run.points = calloc(run.pointCount, sizeof(TunePoint));
+    for (int i = 0; i < run.pointCount; i++) {
+        run.points[i].tuning = GetDefaultGameTuning();
+        int rest = i;
+        for (int p = TUNE_PARAMETER_COUNT - 1; p >= 0; p--) {
+            if (grid.count[p] == 0) continue;
+            SetParameter(&run.points[i].tuning, &parameters[p], grid.values[p][rest % grid.count[p]]);
+            rest /= grid.count[p];
+        }
+    }
+
+    printf("tune: %d grid points x %d games (seeds %llu..%llu) on %d threads, skill %.0f ms / %.1f px\n",
+           run.pointCount, run.games, (unsigned long long)run.firstSeed,
+           (unsigned long long)(run.firstSeed + run.games - 1), threads, run.skill.reactionTime * 1000.0f,
+           run.skill.aimError);
+
+    pthread_t workers[TUNE_MAX_THREADS];
+    double start = NowSeconds();
+    for (int i = 0; i < threads; i++) {
+        pthread_create(&workers[i], NULL, TuneWorker, &run);
+    }
+    long long jobs = (long long)run.pointCount * run.games;
+    double nextReport = start + 1.0;
+    while (atomic_load(&run.jobsDone) < jobs) {
+        struct timespec poll = {0, 50 * 1000 * 1000};
+        nanosleep(&poll, NULL);
+        if (NowSeconds() < nextReport) continue;
+        nextReport += 1.0;
+        printf("  %lld/%lld games, %.0f games/s\n", (long long)atomic_load(&run.jobsDone), jobs,
+               atomic_load(&run.jobsDone) / (NowSeconds() - start));
+        fflush(stdout);
+    }
+    for (int i = 0; i < threads; i++) {
+        pthread_join(workers[i], NULL);
+    }
+    double elapsed = NowSeconds() - start;
+
+    // One line per point: the varied parameters, then the distribution of outcomes
+    printf("\n%5s", "point");
+    for (int p = 0; p < TUNE_PARAMETER_COUNT; p++) {
+        if (grid.count[p] > 0) printf(" %12s", parameters[p].name);
+    }
+    printf(" %7s %5s %5s %5s %7s %7s %6s %6s %6s %6s\n", "wave", "p10", "p50", "p90", "score", "p50", "to10",
+           "to20", "to30", "to50");
+    for (int i = 0; i < run.pointCount; i++) {
+        const TunePoint *point = &run.points[i];
+        long long games = run.games;
+        double waveSum = 0;
+        for (int w = 0; w <= TUNE_MAX_WAVE; w++) {
+            waveSum += (double)w * atomic_load(&point->endWave[w]);
+        }
+        printf("%5d", i);
+        for (int p = 0; p < TUNE_PARAMETER_COUNT; p++) {
+            if (grid.count[p] > 0) printf(" %12g", GetParameter(&point->tuning, &parameters[p]));
+        }
+        printf(" %7.2f %5d %5d %5d %7.1f %7d %5.1f%% %5.1f%% %5.1f%% %5.1f%%\n", waveSum / games,
+               Quantile(point->endWave, TUNE_MAX_WAVE + 1, games, 0.1),
+               Quantile(point->endWave, TUNE_MAX_WAVE + 1, games, 0.5),
+               Quantile(point->endWave, TUNE_MAX_WAVE + 1, games, 0.9), (double)atomic_load(&point->scoreSum) / games,
+               Quantile(point->scores, TUNE_SCORE_BINS, games, 0.5) * TUNE_SCORE_BIN,
+               100.0 * Survival(point, 10, games), 100.0 * Survival(point, 20, games),
+               100.0 * Survival(point, 30, games), 100.0 * Survival(point, 50, games));
+    }
+
+    long long cutOff = 0;
+    for (int i = 0; i < run.pointCount; i++) {
+        cutOff += atomic_load(&run.points[i].cutOff);
+    }
+    printf("\nTUNE points=%d games=%lld ticks=%lld cut_off=%lld threads=%d seconds=%.2f games_per_s=%.0f "
+           "ticks_per_s=%.0f\n",
+           run.pointCount, jobs, (long long)atomic_load(&run.ticksDone), cutOff, threads, elapsed, jobs / elapsed,
+           atomic_load(&run.ticksDone) / elapsed);
+
+    bool ok = csvPrefix == NULL || WriteCsv(&run, csvPrefix);
+    free(run.points);
+    return ok ? 0 : 1;
+}